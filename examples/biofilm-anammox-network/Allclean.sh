@@ -0,0 +1,4 @@
+rm -rf vtk
+rm -rf hdf5
+rm -rf png
+rm log.lammps
@@ -31,6 +31,7 @@ do
     elif [ $var == "--enable-misc" ]; then continue
     elif [ $var == "--enable-plasmid" ]; then continue
     elif [ $var == "--enable-mutation" ]; then continue
+    elif [ $var == "--enable-openmp" ]; then continue
     elif [ $var == "--gpu" ]; then continue
     elif [ $var == "--static" ]; then continue
     elif [ $var == "--shared" ]; then continue
@@ -64,6 +65,8 @@ do
     make yes-plasmid
   elif [ $var == "--enable-mutation" ]; then
     make yes-mutation
+  elif [ $var == "--enable-openmp" ]; then
+    make yes-openmp
   elif [ $var == "--gpu" ]; then
     make yes-kokkos
   fi
@@ -101,6 +104,15 @@ do
    fi
 done
 
+for var in "$@"
+do
+    if [ $var == "--enable-openmp" ]; then
+        make -j4 mpi_omp
+        mv lmp_mpi_omp $root_dir/nufeb_mpi
+        exit 1
+    fi
+done
+
 make -j4 mpi
 mv lmp_mpi $root_dir/nufeb_mpi
 exit 1
@@ -38,8 +38,8 @@ DumpHDF5::~DumpHDF5() {}
 void DumpHDF5::setup()
 {
   for (int i = 0; i < 3; i++) {
-    subdims[i] = grid->subbox[i] - 2;
-    substart[i] = grid->sublo[i] + 1;
+    subdims[i] = grid->subbox[i] - 2 * grid->nghost;
+    substart[i] = grid->sublo[i] + grid->nghost;
     dims[i] = grid->box[i];
   }
   ncells = subdims[0] * subdims[1] * subdims[2];
@@ -269,7 +269,7 @@ void DumpHDF5::write() {
 	std::ostringstream oss;
 	oss << "growth/" << grid->sub_names[i];
 	double *grow = new double[ncells];
-	trim_grids(grid->growth[i][0], grow);
+	trim_grids(grid->growth[i], grow);
 	if (multifile) {
 	  write_grid(file, oss.str().c_str(), H5T_NATIVE_DOUBLE, grow, oneperproc);
 	} else {
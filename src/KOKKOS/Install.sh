@@ -55,10 +55,13 @@ action angle_harmonic_kokkos.cpp angle_harmonic.cpp
 action angle_harmonic_kokkos.h angle_harmonic.h
 action atom_kokkos.cpp
 action atom_kokkos.h
+action atom_map_kokkos.cpp
 action atom_vec_angle_kokkos.cpp atom_vec_angle.cpp
 action atom_vec_angle_kokkos.h atom_vec_angle.h
 action atom_vec_atomic_kokkos.cpp
 action atom_vec_atomic_kokkos.h
+action atom_vec_bacillus_kokkos.cpp atom_vec_bacillus.cpp
+action atom_vec_bacillus_kokkos.h atom_vec_bacillus.h
 action atom_vec_bond_kokkos.cpp atom_vec_bond.cpp
 action atom_vec_bond_kokkos.h atom_vec_bond.h
 action atom_vec_charge_kokkos.cpp
@@ -124,10 +127,12 @@ action fix_diffusion_coeff_kokkos.cpp
 action fix_diffusion_coeff_kokkos.h
 action fix_diffusion_reaction_kokkos.cpp
 action fix_diffusion_reaction_kokkos.h
+action fix_divide_bacillus_kokkos.cpp fix_divide_bacillus.cpp
+action fix_divide_bacillus_kokkos.h fix_divide_bacillus.h
 action fix_divide_coccus_kokkos.cpp
 action fix_divide_coccus_kokkos.h
-action fix_eps_extract_kokkos.cpp
-action fix_eps_extract_kokkos.h
+action fix_eps_extract_kokkos.cpp fix_eps_extract.cpp
+action fix_eps_extract_kokkos.h fix_eps_extract.h
 action fix_enforce2d_kokkos.cpp
 action fix_enforce2d_kokkos.h
 action fix_eos_table_rx_kokkos.cpp fix_eos_table_rx.cpp
@@ -164,6 +169,10 @@ action fix_nph_kokkos.cpp
 action fix_nph_kokkos.h
 action fix_npt_kokkos.cpp
 action fix_npt_kokkos.h
+action fix_nve_bacillus_kokkos.cpp fix_nve_bacillus.cpp
+action fix_nve_bacillus_kokkos.h fix_nve_bacillus.h
+action fix_nve_bacillus_limit_kokkos.cpp fix_nve_bacillus_limit.cpp
+action fix_nve_bacillus_limit_kokkos.h fix_nve_bacillus_limit.h
 action fix_nve_kokkos.cpp
 action fix_nve_kokkos.h
 action fix_nve_limit_kokkos.cpp
@@ -244,6 +253,7 @@ action nbin_ssa_kokkos.cpp nbin_ssa.cpp
 action nbin_ssa_kokkos.h nbin_ssa.h
 action nufeb_run_kokkos.cpp nufeb_run.cpp
 action nufeb_run_kokkos.h nufeb_run.h
+action math_extra_kokkos.h
 action math_special_kokkos.cpp
 action math_special_kokkos.h
 action min_cg_kokkos.cpp
@@ -253,6 +263,8 @@ action min_kokkos.h
 action min_linesearch_kokkos.cpp
 action min_linesearch_kokkos.h
 action pack_kokkos.h pack.h
+action pair_bacillus_kokkos.cpp pair_bacillus.cpp
+action pair_bacillus_kokkos.h pair_bacillus.h
 action pair_buck_coul_cut_kokkos.cpp
 action pair_buck_coul_cut_kokkos.h
 action pair_buck_coul_long_kokkos.cpp pair_buck_coul_long.cpp
@@ -300,20 +312,20 @@ action pair_lj_class2_kokkos.cpp pair_lj_class2.cpp
 action pair_lj_class2_kokkos.h pair_lj_class2.h
 action pair_lj_cut_coul_cut_kokkos.cpp
 action pair_lj_cut_coul_cut_kokkos.h
-action pair_lj_cut_coul_debye_kokkos.cpp
-action pair_lj_cut_coul_debye_kokkos.h
-action pair_lj_cut_coul_dsf_kokkos.cpp
-action pair_lj_cut_coul_dsf_kokkos.h
+action pair_lj_cut_coul_debye_kokkos.cpp pair_lj_cut_coul_debye.cpp
+action pair_lj_cut_coul_debye_kokkos.h pair_lj_cut_coul_debye.h
+action pair_lj_cut_coul_dsf_kokkos.cpp pair_lj_cut_coul_dsf.cpp
+action pair_lj_cut_coul_dsf_kokkos.h pair_lj_cut_coul_dsf.h
 action pair_lj_cut_coul_long_kokkos.cpp pair_lj_cut_coul_long.cpp
 action pair_lj_cut_coul_long_kokkos.h pair_lj_cut_coul_long.h
 action pair_lj_cut_kokkos.cpp
 action pair_lj_cut_kokkos.h
 action pair_lj_expand_kokkos.cpp
 action pair_lj_expand_kokkos.h
-action pair_lj_gromacs_coul_gromacs_kokkos.cpp
-action pair_lj_gromacs_coul_gromacs_kokkos.h
-action pair_lj_gromacs_kokkos.cpp
-action pair_lj_gromacs_kokkos.h
+action pair_lj_gromacs_coul_gromacs_kokkos.cpp pair_lj_gromacs_coul_gromacs.cpp
+action pair_lj_gromacs_coul_gromacs_kokkos.h pair_lj_gromacs_coul_gromacs.h
+action pair_lj_gromacs_kokkos.cpp pair_lj_gromacs.cpp
+action pair_lj_gromacs_kokkos.h pair_lj_gromacs.h
 action pair_lj_sdk_kokkos.cpp pair_lj_sdk.cpp
 action pair_lj_sdk_kokkos.h pair_lj_sdk.h
 action pair_morse_kokkos.cpp
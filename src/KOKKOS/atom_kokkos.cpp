@@ -28,7 +28,10 @@ using namespace LAMMPS_NS;
 
 /* ---------------------------------------------------------------------- */
 
-AtomKokkos::AtomKokkos(LAMMPS *lmp) : Atom(lmp) {}
+AtomKokkos::AtomKokkos(LAMMPS *lmp) : Atom(lmp)
+{
+  k_error_flag = DAT::tdual_int_scalar("atom:error_flag");
+}
 
 /* ---------------------------------------------------------------------- */
 
@@ -76,6 +79,8 @@ AtomKokkos::~AtomKokkos()
   memoryKK->destroy_kokkos(k_improper_atom3, improper_atom3);
   memoryKK->destroy_kokkos(k_improper_atom4, improper_atom4);
 
+  AtomKokkos::map_delete();
+
   // USER-DPD package
 
   memoryKK->destroy_kokkos(k_uCond,uCond);
@@ -92,6 +97,7 @@ AtomKokkos::~AtomKokkos()
   memoryKK->destroy_kokkos(k_outer_radius, outer_radius);
   memoryKK->destroy_kokkos(k_outer_mass, outer_mass);
   memoryKK->destroy_kokkos(k_biomass, biomass);
+  memoryKK->destroy_kokkos(k_bacillus, bacillus);
   memoryKK->destroy_kokkos(k_dvector,dvector);
   dvector = nullptr;
 }
@@ -250,38 +256,25 @@ void AtomKokkos::grow(unsigned int mask){
 
 /* ----------------------------------------------------------------------
    add a custom variable with name of type flag = 0/1 for int/double
+   and cols = 0 for a vector, > 0 for an array
    assumes name does not already exist
-   return index in ivector or dvector of its location
+   only per-atom double vectors are kept in a DualView
+   return index in the matching list of its location
 ------------------------------------------------------------------------- */
 
-int AtomKokkos::add_custom(const char *name, int flag)
+int AtomKokkos::add_custom(const char *name, int flag, int cols)
 {
-  int index;
-
-  if (flag == 0) {
-    index = nivector;
-    nivector++;
-    iname = (char **) memory->srealloc(iname,nivector*sizeof(char *),
-                                       "atom:iname");
-    int n = strlen(name) + 1;
-    iname[index] = new char[n];
-    strcpy(iname[index],name);
-    ivector = (int **) memory->srealloc(ivector,nivector*sizeof(int *),
-                                        "atom:ivector");
-    memory->create(ivector[index],nmax,"atom:ivector");
-  } else {
-    index = ndvector;
-    ndvector++;
-    dname = (char **) memory->srealloc(dname,ndvector*sizeof(char *),
-                                       "atom:dname");
-    int n = strlen(name) + 1;
-    dname[index] = new char[n];
-    strcpy(dname[index],name);
-    this->sync(Device,DVECTOR_MASK);
-    memoryKK->grow_kokkos(k_dvector,dvector,ndvector,nmax,
+  if (flag == 0 || cols) return Atom::add_custom(name,flag,cols);
+
+  int index = ndvector;
+  ndvector++;
+  dvname = (char **) memory->srealloc(dvname,ndvector*sizeof(char *),
+                                      "atom:dvname");
+  dvname[index] = utils::strdup(name);
+  this->sync(Device,DVECTOR_MASK);
+  memoryKK->grow_kokkos(k_dvector,dvector,ndvector,nmax,
                         "atom:dvector");
-    this->modified(Device,DVECTOR_MASK);
-  }
+  this->modified(Device,DVECTOR_MASK);
 
   return index;
 }
@@ -289,22 +282,20 @@ int AtomKokkos::add_custom(const char *name, int flag)
 /* ----------------------------------------------------------------------
    remove a custom variable of type flag = 0/1 for int/double at index
    free memory for vector and name and set ptrs to a null pointer
-   ivector/dvector and iname/dname lists never shrink
+   the dvector memory stays in k_dvector
+   these lists never shrink
 ------------------------------------------------------------------------- */
 
-void AtomKokkos::remove_custom(int flag, int index)
+void AtomKokkos::remove_custom(int index, int flag, int cols)
 {
-  if (flag == 0) {
-    memory->destroy(ivector[index]);
-    ivector[index] = nullptr;
-    delete [] iname[index];
-    iname[index] = nullptr;
-  } else {
-    //memoryKK->destroy_kokkos(dvector);
-    dvector[index] = nullptr;
-    delete [] dname[index];
-    dname[index] = nullptr;
+  if (flag == 0 || cols) {
+    Atom::remove_custom(index,flag,cols);
+    return;
   }
+
+  dvector[index] = nullptr;
+  delete [] dvname[index];
+  dvname[index] = nullptr;
 }
 
 /* ---------------------------------------------------------------------- */
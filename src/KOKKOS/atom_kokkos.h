@@ -66,18 +66,55 @@ class AtomKokkos : public Atom {
   DAT::tdual_float_1d k_outer_radius;
   DAT::tdual_float_1d k_outer_mass;
   DAT::tdual_float_1d k_biomass;
+  DAT::tdual_int_1d k_bacillus;
   
   AtomKokkos(class LAMMPS *);
   ~AtomKokkos();
 
+  virtual void map_init(int check = 1);
+  virtual void map_set();
+  virtual void map_delete();
+
+  DAT::tdual_int_1d k_sametag;
+  DAT::tdual_int_1d k_map_array;
+  DAT::tdual_int_scalar k_error_flag;
+  dual_hash_type k_map_hash;
+
+  // map lookup function inlined for efficiency
+  // return -1 if no map defined
+
+  template<class DeviceType>
+  KOKKOS_INLINE_FUNCTION
+  static int map_kokkos(tagint global, int map_style, DAT::tdual_int_1d k_map_array, dual_hash_type k_map_hash)
+  {
+    if (map_style == 1)
+      return k_map_array.view<DeviceType>()(global);
+    else if (map_style == 2)
+      return AtomKokkos::map_find_hash_kokkos<DeviceType>(global,k_map_hash);
+    else
+      return -1;
+  }
+
+  template<class DeviceType>
+  KOKKOS_INLINE_FUNCTION
+  static int map_find_hash_kokkos(tagint global, dual_hash_type &k_map_hash)
+  {
+    int local = -1;
+    auto d_map_hash = k_map_hash.view<DeviceType>();
+    auto index = d_map_hash.find(global);
+    if (d_map_hash.valid_at(index))
+      local = d_map_hash.value_at(index);
+    return local;
+  }
+
   virtual void allocate_type_arrays();
   void sync(const ExecutionSpace space, unsigned int mask);
   void modified(const ExecutionSpace space, unsigned int mask);
   void sync_overlapping_device(const ExecutionSpace space, unsigned int mask);
   virtual void sort();
   virtual void grow(unsigned int mask);
-  int add_custom(const char *, int);
-  void remove_custom(int, int);
+  int add_custom(const char *, int, int);
+  void remove_custom(int, int, int);
   virtual void deallocate_topology();
   void sync_modify(ExecutionSpace, unsigned int, unsigned int);
  private:
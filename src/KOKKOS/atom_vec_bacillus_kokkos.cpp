@@ -0,0 +1,2065 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "atom_vec_bacillus_kokkos.h"
+
+#include "atom_kokkos.h"
+#include "atom_masks.h"
+#include "atom_vec_bacillus.h"
+#include "comm_kokkos.h"
+#include "domain.h"
+#include "error.h"
+#include "fix.h"
+#include "fix_adapt.h"
+#include "math_const.h"
+#include "memory.h"
+#include "memory_kokkos.h"
+#include "modify.h"
+
+#include <cstring>
+
+using namespace LAMMPS_NS;
+using namespace MathConst;
+
+#define DELTA 10000
+
+namespace LAMMPS_NS {
+
+/* ----------------------------------------------------------------------
+   host AtomVecBacillus that keeps the bonus data of the Kokkos style
+   per-atom arrays are owned by AtomVecBacillusKokkos, so growing,
+   copying and creating atoms is forwarded to it
+------------------------------------------------------------------------- */
+
+class AtomVecBacillusHost : public AtomVecBacillus {
+ public:
+  AtomVecBacillusHost(LAMMPS *lmp, AtomVecBacillusKokkos *kk) :
+    AtomVecBacillus(lmp), avecKK(kk) {}
+
+  void grow(int n) { avecKK->grow(n); }
+  void copy(int i, int j, int delflag) { avecKK->copy(i,j,delflag); }
+  void create_atom(int itype, double *coord) { avecKK->create_atom(itype,coord); }
+
+ private:
+  AtomVecBacillusKokkos *avecKK;
+};
+
+}
+
+/* ---------------------------------------------------------------------- */
+
+AtomVecBacillusKokkos::AtomVecBacillusKokkos(LAMMPS *lmp) : AtomVecKokkos(lmp)
+{
+  molecular = 0;
+  bonus_flag = 1;
+  radvary = 0;
+
+  comm_x_only = 0;
+  comm_f_only = 0;
+  size_forward = 8;
+  size_reverse = 6;
+  size_border = 25;
+  size_velocity = 6;
+  size_data_atom = 7;
+  size_data_vel = 7;
+  xcol_data = 5;
+
+  size_forward_bonus = 4;
+  size_border_bonus = 16;
+  size_restart_bonus_one = 16;
+  size_data_bonus = 11;
+
+  atomKK = (AtomKokkos *) atom;
+  commKK = (CommKokkos *) comm;
+
+  // the host style sets the atom flags of atom_style bacillus
+
+  avec_bacillus = new AtomVecBacillusHost(lmp,this);
+  atom->avec_host = avec_bacillus;
+  bonus_modified = views_modified = 0;
+
+  memoryKK->create_kokkos(k_quat,0,4,"atom:quat");
+  memoryKK->create_kokkos(k_inertia,0,3,"atom:inertia");
+  memoryKK->create_kokkos(k_pole1,0,3,"atom:pole1");
+  memoryKK->create_kokkos(k_pole2,0,3,"atom:pole2");
+  memoryKK->create_kokkos(k_length,0,"atom:length");
+  memoryKK->create_kokkos(k_diameter,0,"atom:diameter");
+
+  no_comm_vel_flag = 0;
+  no_border_vel_flag = 1;
+  unpack_exchange_indices_flag = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+AtomVecBacillusKokkos::~AtomVecBacillusKokkos()
+{
+  delete avec_bacillus;
+  atom->avec_host = nullptr;
+}
+
+/* ----------------------------------------------------------------------
+   process sub-style args
+   optional arg = 0/1 for static/dynamic particle radii
+------------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::process_args(int narg, char **arg)
+{
+  if (narg != 0 && narg != 1)
+    error->all(FLERR,"Illegal atom_style bacillus command");
+
+  radvary = 0;
+  if (narg == 1) {
+    radvary = utils::numeric(FLERR,arg[0],true,lmp);
+    if (radvary < 0 || radvary > 1)
+      error->all(FLERR,"Illegal atom_style bacillus command");
+  }
+
+  // dynamic particle radii must be communicated every step
+
+  if (radvary) size_forward = 9;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::init()
+{
+  AtomVec::init();
+
+  // check if optional radvary setting should have been set to 1
+
+  for (int i = 0; i < modify->nfix; i++)
+    if (strcmp(modify->fix[i]->style,"adapt") == 0) {
+      FixAdapt *fix = (FixAdapt *) modify->fix[i];
+      if (fix->diamflag && radvary == 0)
+        error->all(FLERR,"Fix adapt changes particle radii "
+                   "but atom_style bacillus is not dynamic");
+    }
+}
+
+/* ----------------------------------------------------------------------
+   grow atom arrays
+   n = 0 grows arrays by a chunk
+   n > 0 allocates arrays to size n
+------------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::grow(int n)
+{
+  if (n == 0) nmax += DELTA;
+  else nmax = n;
+  atom->nmax = nmax;
+  if (nmax < 0 || nmax > MAXSMALLINT)
+    error->one(FLERR,"Per-processor system is too big");
+
+  atomKK->sync(Device,ALL_MASK);
+  atomKK->modified(Device,ALL_MASK);
+
+  memoryKK->grow_kokkos(atomKK->k_tag,atomKK->tag,nmax,"atom:tag");
+  memoryKK->grow_kokkos(atomKK->k_type,atomKK->type,nmax,"atom:type");
+  memoryKK->grow_kokkos(atomKK->k_mask,atomKK->mask,nmax,"atom:mask");
+  memoryKK->grow_kokkos(atomKK->k_image,atomKK->image,nmax,"atom:image");
+
+  memoryKK->grow_kokkos(atomKK->k_x,atomKK->x,nmax,"atom:x");
+  memoryKK->grow_kokkos(atomKK->k_v,atomKK->v,nmax,"atom:v");
+  memoryKK->grow_kokkos(atomKK->k_f,atomKK->f,nmax,"atom:f");
+  memoryKK->grow_kokkos(atomKK->k_radius,atomKK->radius,nmax,"atom:radius");
+  memoryKK->grow_kokkos(atomKK->k_rmass,atomKK->rmass,nmax,"atom:rmass");
+  memoryKK->grow_kokkos(atomKK->k_biomass,atomKK->biomass,nmax,"atom:biomass");
+  memoryKK->grow_kokkos(atomKK->k_angmom,atomKK->angmom,nmax,"atom:angmom");
+  memoryKK->grow_kokkos(atomKK->k_torque,atomKK->torque,nmax,"atom:torque");
+  memoryKK->grow_kokkos(atomKK->k_bacillus,atomKK->bacillus,nmax,"atom:bacillus");
+
+  k_quat.resize(nmax,4);
+  k_inertia.resize(nmax,3);
+  k_pole1.resize(nmax,3);
+  k_pole2.resize(nmax,3);
+  k_length.resize(nmax);
+  k_diameter.resize(nmax);
+
+  if (atom->nextra_grow)
+    for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
+      modify->fix[atom->extra_grow[iextra]]->grow_arrays(nmax);
+
+  grow_pointers();
+  atomKK->sync(Host,ALL_MASK);
+}
+
+/* ----------------------------------------------------------------------
+   reset local array ptrs
+------------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::grow_pointers()
+{
+  tag = atomKK->tag;
+  d_tag = atomKK->k_tag.d_view;
+  h_tag = atomKK->k_tag.h_view;
+
+  type = atomKK->type;
+  d_type = atomKK->k_type.d_view;
+  h_type = atomKK->k_type.h_view;
+  mask = atomKK->mask;
+  d_mask = atomKK->k_mask.d_view;
+  h_mask = atomKK->k_mask.h_view;
+  image = atomKK->image;
+  d_image = atomKK->k_image.d_view;
+  h_image = atomKK->k_image.h_view;
+
+  x = atomKK->x;
+  d_x = atomKK->k_x.d_view;
+  h_x = atomKK->k_x.h_view;
+  v = atomKK->v;
+  d_v = atomKK->k_v.d_view;
+  h_v = atomKK->k_v.h_view;
+  f = atomKK->f;
+  d_f = atomKK->k_f.d_view;
+  h_f = atomKK->k_f.h_view;
+  radius = atomKK->radius;
+  d_radius = atomKK->k_radius.d_view;
+  h_radius = atomKK->k_radius.h_view;
+  rmass = atomKK->rmass;
+  d_rmass = atomKK->k_rmass.d_view;
+  h_rmass = atomKK->k_rmass.h_view;
+  biomass = atomKK->biomass;
+  d_biomass = atomKK->k_biomass.d_view;
+  h_biomass = atomKK->k_biomass.h_view;
+  angmom = atomKK->angmom;
+  d_angmom = atomKK->k_angmom.d_view;
+  h_angmom = atomKK->k_angmom.h_view;
+  torque = atomKK->torque;
+  d_torque = atomKK->k_torque.d_view;
+  h_torque = atomKK->k_torque.h_view;
+  bacillus = atomKK->bacillus;
+  d_bacillus = atomKK->k_bacillus.d_view;
+  h_bacillus = atomKK->k_bacillus.h_view;
+
+  avec_bacillus->grow_pointers();
+}
+
+/* ----------------------------------------------------------------------
+   copy atom I info to atom J
+------------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::copy(int i, int j, int delflag)
+{
+  atomKK->sync(Host,X_MASK|V_MASK|TAG_MASK|TYPE_MASK|MASK_MASK|IMAGE_MASK|
+               RADIUS_MASK|RMASS_MASK|BIOMASS_MASK|ANGMOM_MASK|BACILLUS_MASK);
+
+  h_tag[j] = h_tag[i];
+  h_type[j] = h_type[i];
+  h_mask[j] = h_mask[i];
+  h_image[j] = h_image[i];
+  h_x(j,0) = h_x(i,0);
+  h_x(j,1) = h_x(i,1);
+  h_x(j,2) = h_x(i,2);
+  h_v(j,0) = h_v(i,0);
+  h_v(j,1) = h_v(i,1);
+  h_v(j,2) = h_v(i,2);
+
+  h_radius[j] = h_radius[i];
+  h_rmass[j] = h_rmass[i];
+  h_biomass[j] = h_biomass[i];
+  h_angmom(j,0) = h_angmom(i,0);
+  h_angmom(j,1) = h_angmom(i,1);
+  h_angmom(j,2) = h_angmom(i,2);
+
+  avec_bacillus->copy_bonus(i,j,delflag);
+
+  if (atom->nextra_grow)
+    for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
+      modify->fix[atom->extra_grow[iextra]]->copy_arrays(i,j,delflag);
+
+  atomKK->modified(Host,X_MASK|V_MASK|TAG_MASK|TYPE_MASK|MASK_MASK|IMAGE_MASK|
+                   RADIUS_MASK|RMASS_MASK|BIOMASS_MASK|ANGMOM_MASK|BACILLUS_MASK);
+}
+
+/* ----------------------------------------------------------------------
+   forward communication on the device
+   per-atom buffer: x, rmass, quat, radius if radvary
+   the quat of non-bacillus atoms is sent too but never used
+------------------------------------------------------------------------- */
+
+template<class DeviceType,int PBC_FLAG,int TRICLINIC>
+struct AtomVecBacillusKokkos_PackComm {
+  typedef DeviceType device_type;
+
+  typename ArrayTypes<DeviceType>::t_x_array_randomread _x;
+  typename ArrayTypes<DeviceType>::t_float_1d _radius,_rmass;
+  typename ArrayTypes<DeviceType>::t_float_2d _quat;
+  typename ArrayTypes<DeviceType>::t_xfloat_2d_um _buf;
+  typename ArrayTypes<DeviceType>::t_int_2d_const _list;
+  const int _iswap,_radvary;
+  X_FLOAT _xprd,_yprd,_zprd,_xy,_xz,_yz;
+  X_FLOAT _pbc[6];
+
+  AtomVecBacillusKokkos_PackComm(
+    AtomKokkos *atomKK, AtomVecBacillusKokkos *avec, Domain *domain,
+    const DAT::tdual_xfloat_2d &buf, const DAT::tdual_int_2d &list,
+    const int &iswap, const int* const pbc, const int &radvary):
+    _x(atomKK->k_x.view<DeviceType>()),
+    _radius(atomKK->k_radius.view<DeviceType>()),
+    _rmass(atomKK->k_rmass.view<DeviceType>()),
+    _quat(avec->k_quat.view<DeviceType>()),
+    _list(list.view<DeviceType>()),_iswap(iswap),_radvary(radvary),
+    _xprd(domain->xprd),_yprd(domain->yprd),_zprd(domain->zprd),
+    _xy(domain->xy),_xz(domain->xz),_yz(domain->yz) {
+    const size_t elements = 8 + radvary;
+    const size_t maxsend = (buf.view<DeviceType>().extent(0)*buf.view<DeviceType>().extent(1))/elements;
+    _buf = typename ArrayTypes<DeviceType>::t_xfloat_2d_um(buf.view<DeviceType>().data(),maxsend,elements);
+    _pbc[0] = pbc[0]; _pbc[1] = pbc[1]; _pbc[2] = pbc[2];
+    _pbc[3] = pbc[3]; _pbc[4] = pbc[4]; _pbc[5] = pbc[5];
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const int& i) const {
+    const int j = _list(_iswap,i);
+    if (PBC_FLAG == 0) {
+      _buf(i,0) = _x(j,0);
+      _buf(i,1) = _x(j,1);
+      _buf(i,2) = _x(j,2);
+    } else {
+      if (TRICLINIC == 0) {
+        _buf(i,0) = _x(j,0) + _pbc[0]*_xprd;
+        _buf(i,1) = _x(j,1) + _pbc[1]*_yprd;
+        _buf(i,2) = _x(j,2) + _pbc[2]*_zprd;
+      } else {
+        _buf(i,0) = _x(j,0) + _pbc[0]*_xprd + _pbc[5]*_xy + _pbc[4]*_xz;
+        _buf(i,1) = _x(j,1) + _pbc[1]*_yprd + _pbc[3]*_yz;
+        _buf(i,2) = _x(j,2) + _pbc[2]*_zprd;
+      }
+    }
+    _buf(i,3) = _rmass(j);
+    _buf(i,4) = _quat(j,0);
+    _buf(i,5) = _quat(j,1);
+    _buf(i,6) = _quat(j,2);
+    _buf(i,7) = _quat(j,3);
+    if (_radvary) _buf(i,8) = _radius(j);
+  }
+};
+
+/* ---------------------------------------------------------------------- */
+
+template<class DeviceType>
+static void bacillus_pack_comm(
+  AtomKokkos *atomKK, AtomVecBacillusKokkos *avec, Domain *domain,
+  const int &n, const DAT::tdual_int_2d &list, const int &iswap,
+  const DAT::tdual_xfloat_2d &buf, const int &pbc_flag, const int* const pbc,
+  const int &radvary)
+{
+  if (pbc_flag) {
+    if (domain->triclinic) {
+      struct AtomVecBacillusKokkos_PackComm<DeviceType,1,1> f(
+        atomKK,avec,domain,buf,list,iswap,pbc,radvary);
+      Kokkos::parallel_for(n,f);
+    } else {
+      struct AtomVecBacillusKokkos_PackComm<DeviceType,1,0> f(
+        atomKK,avec,domain,buf,list,iswap,pbc,radvary);
+      Kokkos::parallel_for(n,f);
+    }
+  } else {
+    if (domain->triclinic) {
+      struct AtomVecBacillusKokkos_PackComm<DeviceType,0,1> f(
+        atomKK,avec,domain,buf,list,iswap,pbc,radvary);
+      Kokkos::parallel_for(n,f);
+    } else {
+      struct AtomVecBacillusKokkos_PackComm<DeviceType,0,0> f(
+        atomKK,avec,domain,buf,list,iswap,pbc,radvary);
+      Kokkos::parallel_for(n,f);
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+int AtomVecBacillusKokkos::pack_comm_kokkos(
+  const int &n,
+  const DAT::tdual_int_2d &list,
+  const int & iswap,
+  const DAT::tdual_xfloat_2d &buf,
+  const int &pbc_flag,
+  const int* const pbc)
+{
+  if (commKK->forward_comm_on_host) {
+    atomKK->sync(Host,X_MASK|RADIUS_MASK|RMASS_MASK|BACILLUS_MASK);
+    sync_bonus(Host);
+    bacillus_pack_comm<LMPHostType>(atomKK,this,domain,n,list,iswap,buf,
+                                    pbc_flag,pbc,radvary);
+  } else {
+    atomKK->sync(Device,X_MASK|RADIUS_MASK|RMASS_MASK|BACILLUS_MASK);
+    sync_bonus(Device);
+    bacillus_pack_comm<LMPDeviceType>(atomKK,this,domain,n,list,iswap,buf,
+                                      pbc_flag,pbc,radvary);
+  }
+  return n*size_forward;
+}
+
+/* ----------------------------------------------------------------------
+   per-atom buffer: x, v, angmom, rmass, quat, radius if radvary
+------------------------------------------------------------------------- */
+
+template<class DeviceType,int PBC_FLAG,int TRICLINIC,int DEFORM_VREMAP>
+struct AtomVecBacillusKokkos_PackCommVel {
+  typedef DeviceType device_type;
+
+  typename ArrayTypes<DeviceType>::t_x_array_randomread _x;
+  typename ArrayTypes<DeviceType>::t_int_1d _mask;
+  typename ArrayTypes<DeviceType>::t_float_1d _radius,_rmass;
+  typename ArrayTypes<DeviceType>::t_v_array _v,_angmom;
+  typename ArrayTypes<DeviceType>::t_float_2d _quat;
+  typename ArrayTypes<DeviceType>::t_xfloat_2d_um _buf;
+  typename ArrayTypes<DeviceType>::t_int_2d_const _list;
+  const int _iswap,_radvary;
+  X_FLOAT _xprd,_yprd,_zprd,_xy,_xz,_yz;
+  X_FLOAT _pbc[6];
+  X_FLOAT _h_rate[6];
+  const int _deform_groupbit;
+
+  AtomVecBacillusKokkos_PackCommVel(
+    AtomKokkos *atomKK, AtomVecBacillusKokkos *avec, Domain *domain,
+    const DAT::tdual_xfloat_2d &buf, const DAT::tdual_int_2d &list,
+    const int &iswap, const int* const pbc, const int &radvary,
+    const double * const h_rate, const int &deform_groupbit):
+    _x(atomKK->k_x.view<DeviceType>()),
+    _mask(atomKK->k_mask.view<DeviceType>()),
+    _radius(atomKK->k_radius.view<DeviceType>()),
+    _rmass(atomKK->k_rmass.view<DeviceType>()),
+    _v(atomKK->k_v.view<DeviceType>()),
+    _angmom(atomKK->k_angmom.view<DeviceType>()),
+    _quat(avec->k_quat.view<DeviceType>()),
+    _list(list.view<DeviceType>()),_iswap(iswap),_radvary(radvary),
+    _xprd(domain->xprd),_yprd(domain->yprd),_zprd(domain->zprd),
+    _xy(domain->xy),_xz(domain->xz),_yz(domain->yz),
+    _deform_groupbit(deform_groupbit)
+  {
+    const size_t elements = 14 + radvary;
+    const size_t maxsend = (buf.view<DeviceType>().extent(0)*buf.view<DeviceType>().extent(1))/elements;
+    _buf = typename ArrayTypes<DeviceType>::t_xfloat_2d_um(buf.view<DeviceType>().data(),maxsend,elements);
+    _pbc[0] = pbc[0]; _pbc[1] = pbc[1]; _pbc[2] = pbc[2];
+    _pbc[3] = pbc[3]; _pbc[4] = pbc[4]; _pbc[5] = pbc[5];
+    _h_rate[0] = h_rate[0]; _h_rate[1] = h_rate[1]; _h_rate[2] = h_rate[2];
+    _h_rate[3] = h_rate[3]; _h_rate[4] = h_rate[4]; _h_rate[5] = h_rate[5];
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const int& i) const {
+    const int j = _list(_iswap,i);
+    if (PBC_FLAG == 0) {
+      _buf(i,0) = _x(j,0);
+      _buf(i,1) = _x(j,1);
+      _buf(i,2) = _x(j,2);
+    } else {
+      if (TRICLINIC == 0) {
+        _buf(i,0) = _x(j,0) + _pbc[0]*_xprd;
+        _buf(i,1) = _x(j,1) + _pbc[1]*_yprd;
+        _buf(i,2) = _x(j,2) + _pbc[2]*_zprd;
+      } else {
+        _buf(i,0) = _x(j,0) + _pbc[0]*_xprd + _pbc[5]*_xy + _pbc[4]*_xz;
+        _buf(i,1) = _x(j,1) + _pbc[1]*_yprd + _pbc[3]*_yz;
+        _buf(i,2) = _x(j,2) + _pbc[2]*_zprd;
+      }
+    }
+    if (DEFORM_VREMAP && (_mask(j) & _deform_groupbit)) {
+      _buf(i,3) = _v(j,0) + _pbc[0]*_h_rate[0] + _pbc[5]*_h_rate[5] + _pbc[4]*_h_rate[4];
+      _buf(i,4) = _v(j,1) + _pbc[1]*_h_rate[1] + _pbc[3]*_h_rate[3];
+      _buf(i,5) = _v(j,2) + _pbc[2]*_h_rate[2];
+    } else {
+      _buf(i,3) = _v(j,0);
+      _buf(i,4) = _v(j,1);
+      _buf(i,5) = _v(j,2);
+    }
+    _buf(i,6) = _angmom(j,0);
+    _buf(i,7) = _angmom(j,1);
+    _buf(i,8) = _angmom(j,2);
+    _buf(i,9) = _rmass(j);
+    _buf(i,10) = _quat(j,0);
+    _buf(i,11) = _quat(j,1);
+    _buf(i,12) = _quat(j,2);
+    _buf(i,13) = _quat(j,3);
+    if (_radvary) _buf(i,14) = _radius(j);
+  }
+};
+
+/* ---------------------------------------------------------------------- */
+
+template<class DeviceType>
+static void bacillus_pack_comm_vel(
+  AtomKokkos *atomKK, AtomVecBacillusKokkos *avec, Domain *domain,
+  const int &n, const DAT::tdual_int_2d &list, const int &iswap,
+  const DAT::tdual_xfloat_2d &buf, const int &pbc_flag, const int* const pbc,
+  const int &radvary, const double * const h_rate, const int &deform_vremap,
+  const int &deform_groupbit)
+{
+  if (pbc_flag) {
+    if (deform_vremap) {
+      if (domain->triclinic) {
+        struct AtomVecBacillusKokkos_PackCommVel<DeviceType,1,1,1> f(
+          atomKK,avec,domain,buf,list,iswap,pbc,radvary,h_rate,deform_groupbit);
+        Kokkos::parallel_for(n,f);
+      } else {
+        struct AtomVecBacillusKokkos_PackCommVel<DeviceType,1,0,1> f(
+          atomKK,avec,domain,buf,list,iswap,pbc,radvary,h_rate,deform_groupbit);
+        Kokkos::parallel_for(n,f);
+      }
+    } else {
+      if (domain->triclinic) {
+        struct AtomVecBacillusKokkos_PackCommVel<DeviceType,1,1,0> f(
+          atomKK,avec,domain,buf,list,iswap,pbc,radvary,h_rate,deform_groupbit);
+        Kokkos::parallel_for(n,f);
+      } else {
+        struct AtomVecBacillusKokkos_PackCommVel<DeviceType,1,0,0> f(
+          atomKK,avec,domain,buf,list,iswap,pbc,radvary,h_rate,deform_groupbit);
+        Kokkos::parallel_for(n,f);
+      }
+    }
+  } else {
+    struct AtomVecBacillusKokkos_PackCommVel<DeviceType,0,0,0> f(
+      atomKK,avec,domain,buf,list,iswap,pbc,radvary,h_rate,deform_groupbit);
+    Kokkos::parallel_for(n,f);
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+int AtomVecBacillusKokkos::pack_comm_vel_kokkos(
+  const int &n,
+  const DAT::tdual_int_2d &list,
+  const int & iswap,
+  const DAT::tdual_xfloat_2d &buf,
+  const int &pbc_flag,
+  const int* const pbc)
+{
+  if (commKK->forward_comm_on_host) {
+    atomKK->sync(Host,X_MASK|V_MASK|MASK_MASK|RADIUS_MASK|RMASS_MASK|
+                 ANGMOM_MASK|BACILLUS_MASK);
+    sync_bonus(Host);
+    bacillus_pack_comm_vel<LMPHostType>(atomKK,this,domain,n,list,iswap,buf,
+                                        pbc_flag,pbc,radvary,h_rate,
+                                        deform_vremap,deform_groupbit);
+  } else {
+    atomKK->sync(Device,X_MASK|V_MASK|MASK_MASK|RADIUS_MASK|RMASS_MASK|
+                 ANGMOM_MASK|BACILLUS_MASK);
+    sync_bonus(Device);
+    bacillus_pack_comm_vel<LMPDeviceType>(atomKK,this,domain,n,list,iswap,buf,
+                                          pbc_flag,pbc,radvary,h_rate,
+                                          deform_vremap,deform_groupbit);
+  }
+  return n*(size_forward+size_velocity);
+}
+
+/* ---------------------------------------------------------------------- */
+
+template<class DeviceType,int PBC_FLAG,int TRICLINIC>
+struct AtomVecBacillusKokkos_PackCommSelf {
+  typedef DeviceType device_type;
+
+  typename ArrayTypes<DeviceType>::t_x_array_randomread _x;
+  typename ArrayTypes<DeviceType>::t_x_array _xw;
+  typename ArrayTypes<DeviceType>::t_float_1d _radius,_rmass;
+  typename ArrayTypes<DeviceType>::t_float_2d _quat;
+  int _nfirst;
+  typename ArrayTypes<DeviceType>::t_int_2d_const _list;
+  const int _iswap,_radvary;
+  X_FLOAT _xprd,_yprd,_zprd,_xy,_xz,_yz;
+  X_FLOAT _pbc[6];
+
+  AtomVecBacillusKokkos_PackCommSelf(
+    AtomKokkos *atomKK, AtomVecBacillusKokkos *avec, Domain *domain,
+    const int &nfirst, const DAT::tdual_int_2d &list, const int &iswap,
+    const int* const pbc, const int &radvary):
+    _x(atomKK->k_x.view<DeviceType>()),_xw(atomKK->k_x.view<DeviceType>()),
+    _radius(atomKK->k_radius.view<DeviceType>()),
+    _rmass(atomKK->k_rmass.view<DeviceType>()),
+    _quat(avec->k_quat.view<DeviceType>()),
+    _nfirst(nfirst),_list(list.view<DeviceType>()),_iswap(iswap),
+    _radvary(radvary),
+    _xprd(domain->xprd),_yprd(domain->yprd),_zprd(domain->zprd),
+    _xy(domain->xy),_xz(domain->xz),_yz(domain->yz) {
+    _pbc[0] = pbc[0]; _pbc[1] = pbc[1]; _pbc[2] = pbc[2];
+    _pbc[3] = pbc[3]; _pbc[4] = pbc[4]; _pbc[5] = pbc[5];
+  };
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const int& i) const {
+    const int j = _list(_iswap,i);
+    const int k = i + _nfirst;
+    if (PBC_FLAG == 0) {
+      _xw(k,0) = _x(j,0);
+      _xw(k,1) = _x(j,1);
+      _xw(k,2) = _x(j,2);
+    } else {
+      if (TRICLINIC == 0) {
+        _xw(k,0) = _x(j,0) + _pbc[0]*_xprd;
+        _xw(k,1) = _x(j,1) + _pbc[1]*_yprd;
+        _xw(k,2) = _x(j,2) + _pbc[2]*_zprd;
+      } else {
+        _xw(k,0) = _x(j,0) + _pbc[0]*_xprd + _pbc[5]*_xy + _pbc[4]*_xz;
+        _xw(k,1) = _x(j,1) + _pbc[1]*_yprd + _pbc[3]*_yz;
+        _xw(k,2) = _x(j,2) + _pbc[2]*_zprd;
+      }
+    }
+    _rmass(k) = _rmass(j);
+    _quat(k,0) = _quat(j,0);
+    _quat(k,1) = _quat(j,1);
+    _quat(k,2) = _quat(j,2);
+    _quat(k,3) = _quat(j,3);
+    if (_radvary) _radius(k) = _radius(j);
+  }
+};
+
+/* ---------------------------------------------------------------------- */
+
+template<class DeviceType>
+static void bacillus_pack_comm_self(
+  AtomKokkos *atomKK, AtomVecBacillusKokkos *avec, Domain *domain,
+  const int &n, const DAT::tdual_int_2d &list, const int &iswap,
+  const int nfirst, const int &pbc_flag, const int* const pbc,
+  const int &radvary)
+{
+  if (pbc_flag) {
+    if (domain->triclinic) {
+      struct AtomVecBacillusKokkos_PackCommSelf<DeviceType,1,1> f(
+        atomKK,avec,domain,nfirst,list,iswap,pbc,radvary);
+      Kokkos::parallel_for(n,f);
+    } else {
+      struct AtomVecBacillusKokkos_PackCommSelf<DeviceType,1,0> f(
+        atomKK,avec,domain,nfirst,list,iswap,pbc,radvary);
+      Kokkos::parallel_for(n,f);
+    }
+  } else {
+    if (domain->triclinic) {
+      struct AtomVecBacillusKokkos_PackCommSelf<DeviceType,0,1> f(
+        atomKK,avec,domain,nfirst,list,iswap,pbc,radvary);
+      Kokkos::parallel_for(n,f);
+    } else {
+      struct AtomVecBacillusKokkos_PackCommSelf<DeviceType,0,0> f(
+        atomKK,avec,domain,nfirst,list,iswap,pbc,radvary);
+      Kokkos::parallel_for(n,f);
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+int AtomVecBacillusKokkos::pack_comm_self(
+  const int &n, const DAT::tdual_int_2d &list, const int &iswap,
+  const int nfirst, const int &pbc_flag, const int* const pbc)
+{
+  if (commKK->forward_comm_on_host) {
+    atomKK->sync(Host,X_MASK|RADIUS_MASK|RMASS_MASK|BACILLUS_MASK);
+    sync_bonus(Host);
+    atomKK->modified(Host,X_MASK|RADIUS_MASK|RMASS_MASK);
+    modified_bonus(Host);
+    bacillus_pack_comm_self<LMPHostType>(atomKK,this,domain,n,list,iswap,
+                                         nfirst,pbc_flag,pbc,radvary);
+  } else {
+    atomKK->sync(Device,X_MASK|RADIUS_MASK|RMASS_MASK|BACILLUS_MASK);
+    sync_bonus(Device);
+    atomKK->modified(Device,X_MASK|RADIUS_MASK|RMASS_MASK);
+    modified_bonus(Device);
+    bacillus_pack_comm_self<LMPDeviceType>(atomKK,this,domain,n,list,iswap,
+                                           nfirst,pbc_flag,pbc,radvary);
+  }
+  return n*size_forward;
+}
+
+/* ----------------------------------------------------------------------
+   all self swaps of a single proc in one kernel
+------------------------------------------------------------------------- */
+
+template<class DeviceType,int TRICLINIC>
+struct AtomVecBacillusKokkos_PackCommSelfFused {
+  typedef DeviceType device_type;
+
+  typename ArrayTypes<DeviceType>::t_x_array_randomread _x;
+  typename ArrayTypes<DeviceType>::t_x_array _xw;
+  typename ArrayTypes<DeviceType>::t_float_1d _radius,_rmass;
+  typename ArrayTypes<DeviceType>::t_float_2d _quat;
+  typename ArrayTypes<DeviceType>::t_int_2d_const _list;
+  typename ArrayTypes<DeviceType>::t_int_2d_const _pbc;
+  typename ArrayTypes<DeviceType>::t_int_1d_const _pbc_flag;
+  typename ArrayTypes<DeviceType>::t_int_1d_const _firstrecv;
+  typename ArrayTypes<DeviceType>::t_int_1d_const _sendnum_scan;
+  typename ArrayTypes<DeviceType>::t_int_1d_const _g2l;
+  const int _radvary;
+  X_FLOAT _xprd,_yprd,_zprd,_xy,_xz,_yz;
+
+  AtomVecBacillusKokkos_PackCommSelfFused(
+    AtomKokkos *atomKK, AtomVecBacillusKokkos *avec, Domain *domain,
+    const DAT::tdual_int_2d &list,
+    const DAT::tdual_int_2d &pbc,
+    const DAT::tdual_int_1d &pbc_flag,
+    const DAT::tdual_int_1d &firstrecv,
+    const DAT::tdual_int_1d &sendnum_scan,
+    const DAT::tdual_int_1d &g2l,
+    const int &radvary):
+    _x(atomKK->k_x.view<DeviceType>()),_xw(atomKK->k_x.view<DeviceType>()),
+    _radius(atomKK->k_radius.view<DeviceType>()),
+    _rmass(atomKK->k_rmass.view<DeviceType>()),
+    _quat(avec->k_quat.view<DeviceType>()),
+    _list(list.view<DeviceType>()),
+    _pbc(pbc.view<DeviceType>()),
+    _pbc_flag(pbc_flag.view<DeviceType>()),
+    _firstrecv(firstrecv.view<DeviceType>()),
+    _sendnum_scan(sendnum_scan.view<DeviceType>()),
+    _g2l(g2l.view<DeviceType>()),
+    _radvary(radvary),
+    _xprd(domain->xprd),_yprd(domain->yprd),_zprd(domain->zprd),
+    _xy(domain->xy),_xz(domain->xz),_yz(domain->yz) {};
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const int& ii) const {
+
+    int iswap = 0;
+    while (ii >= _sendnum_scan[iswap]) iswap++;
+    int i = ii;
+    if (iswap > 0)
+      i = ii - _sendnum_scan[iswap-1];
+
+    const int k = i + _firstrecv[iswap];
+    const int nlocal = _firstrecv[0];
+
+    int j = _list(iswap,i);
+    if (j >= nlocal)
+      j = _g2l(j-nlocal);
+
+    if (_pbc_flag(ii) == 0) {
+      _xw(k,0) = _x(j,0);
+      _xw(k,1) = _x(j,1);
+      _xw(k,2) = _x(j,2);
+    } else {
+      if (TRICLINIC == 0) {
+        _xw(k,0) = _x(j,0) + _pbc(ii,0)*_xprd;
+        _xw(k,1) = _x(j,1) + _pbc(ii,1)*_yprd;
+        _xw(k,2) = _x(j,2) + _pbc(ii,2)*_zprd;
+      } else {
+        _xw(k,0) = _x(j,0) + _pbc(ii,0)*_xprd + _pbc(ii,5)*_xy + _pbc(ii,4)*_xz;
+        _xw(k,1) = _x(j,1) + _pbc(ii,1)*_yprd + _pbc(ii,3)*_yz;
+        _xw(k,2) = _x(j,2) + _pbc(ii,2)*_zprd;
+      }
+    }
+    _rmass(k) = _rmass(j);
+    _quat(k,0) = _quat(j,0);
+    _quat(k,1) = _quat(j,1);
+    _quat(k,2) = _quat(j,2);
+    _quat(k,3) = _quat(j,3);
+    if (_radvary) _radius(k) = _radius(j);
+  }
+};
+
+/* ---------------------------------------------------------------------- */
+
+int AtomVecBacillusKokkos::pack_comm_self_fused(
+  const int &n, const DAT::tdual_int_2d &list,
+  const DAT::tdual_int_1d &sendnum_scan, const DAT::tdual_int_1d &firstrecv,
+  const DAT::tdual_int_1d &pbc_flag, const DAT::tdual_int_2d &pbc,
+  const DAT::tdual_int_1d &g2l)
+{
+  if (commKK->forward_comm_on_host) {
+    atomKK->sync(Host,X_MASK|RADIUS_MASK|RMASS_MASK|BACILLUS_MASK);
+    sync_bonus(Host);
+    atomKK->modified(Host,X_MASK|RADIUS_MASK|RMASS_MASK);
+    modified_bonus(Host);
+    if (domain->triclinic) {
+      struct AtomVecBacillusKokkos_PackCommSelfFused<LMPHostType,1> f(
+        atomKK,this,domain,list,pbc,pbc_flag,firstrecv,sendnum_scan,g2l,radvary);
+      Kokkos::parallel_for(n,f);
+    } else {
+      struct AtomVecBacillusKokkos_PackCommSelfFused<LMPHostType,0> f(
+        atomKK,this,domain,list,pbc,pbc_flag,firstrecv,sendnum_scan,g2l,radvary);
+      Kokkos::parallel_for(n,f);
+    }
+  } else {
+    atomKK->sync(Device,X_MASK|RADIUS_MASK|RMASS_MASK|BACILLUS_MASK);
+    sync_bonus(Device);
+    atomKK->modified(Device,X_MASK|RADIUS_MASK|RMASS_MASK);
+    modified_bonus(Device);
+    if (domain->triclinic) {
+      struct AtomVecBacillusKokkos_PackCommSelfFused<LMPDeviceType,1> f(
+        atomKK,this,domain,list,pbc,pbc_flag,firstrecv,sendnum_scan,g2l,radvary);
+      Kokkos::parallel_for(n,f);
+    } else {
+      struct AtomVecBacillusKokkos_PackCommSelfFused<LMPDeviceType,0> f(
+        atomKK,this,domain,list,pbc,pbc_flag,firstrecv,sendnum_scan,g2l,radvary);
+      Kokkos::parallel_for(n,f);
+    }
+  }
+  return n*size_forward;
+}
+
+/* ---------------------------------------------------------------------- */
+
+template<class DeviceType>
+struct AtomVecBacillusKokkos_UnpackComm {
+  typedef DeviceType device_type;
+
+  typename ArrayTypes<DeviceType>::t_x_array _x;
+  typename ArrayTypes<DeviceType>::t_float_1d _radius,_rmass;
+  typename ArrayTypes<DeviceType>::t_float_2d _quat;
+  typename ArrayTypes<DeviceType>::t_xfloat_2d_const_um _buf;
+  int _first;
+  const int _radvary;
+
+  AtomVecBacillusKokkos_UnpackComm(
+    AtomKokkos *atomKK, AtomVecBacillusKokkos *avec,
+    const DAT::tdual_xfloat_2d &buf, const int &first, const int &radvary):
+    _x(atomKK->k_x.view<DeviceType>()),
+    _radius(atomKK->k_radius.view<DeviceType>()),
+    _rmass(atomKK->k_rmass.view<DeviceType>()),
+    _quat(avec->k_quat.view<DeviceType>()),
+    _first(first),_radvary(radvary)
+  {
+    const size_t elements = 8 + radvary;
+    const size_t maxsend = (buf.view<DeviceType>().extent(0)*buf.view<DeviceType>().extent(1))/elements;
+    _buf = typename ArrayTypes<DeviceType>::t_xfloat_2d_const_um(buf.view<DeviceType>().data(),maxsend,elements);
+  };
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const int& i) const {
+    const int k = i + _first;
+    _x(k,0) = _buf(i,0);
+    _x(k,1) = _buf(i,1);
+    _x(k,2) = _buf(i,2);
+    _rmass(k) = _buf(i,3);
+    _quat(k,0) = _buf(i,4);
+    _quat(k,1) = _buf(i,5);
+    _quat(k,2) = _buf(i,6);
+    _quat(k,3) = _buf(i,7);
+    if (_radvary) _radius(k) = _buf(i,8);
+  }
+};
+
+/* ---------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::unpack_comm_kokkos(
+  const int &n, const int &first,
+  const DAT::tdual_xfloat_2d &buf)
+{
+  if (commKK->forward_comm_on_host) {
+    atomKK->sync(Host,BACILLUS_MASK);
+    sync_bonus(Host);
+    atomKK->modified(Host,X_MASK|RADIUS_MASK|RMASS_MASK);
+    modified_bonus(Host);
+    struct AtomVecBacillusKokkos_UnpackComm<LMPHostType> f(
+      atomKK,this,buf,first,radvary);
+    Kokkos::parallel_for(n,f);
+  } else {
+    atomKK->sync(Device,BACILLUS_MASK);
+    sync_bonus(Device);
+    atomKK->modified(Device,X_MASK|RADIUS_MASK|RMASS_MASK);
+    modified_bonus(Device);
+    struct AtomVecBacillusKokkos_UnpackComm<LMPDeviceType> f(
+      atomKK,this,buf,first,radvary);
+    Kokkos::parallel_for(n,f);
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+template<class DeviceType>
+struct AtomVecBacillusKokkos_UnpackCommVel {
+  typedef DeviceType device_type;
+
+  typename ArrayTypes<DeviceType>::t_x_array _x;
+  typename ArrayTypes<DeviceType>::t_float_1d _radius,_rmass;
+  typename ArrayTypes<DeviceType>::t_v_array _v,_angmom;
+  typename ArrayTypes<DeviceType>::t_float_2d _quat;
+  typename ArrayTypes<DeviceType>::t_xfloat_2d_const_um _buf;
+  int _first;
+  const int _radvary;
+
+  AtomVecBacillusKokkos_UnpackCommVel(
+    AtomKokkos *atomKK, AtomVecBacillusKokkos *avec,
+    const DAT::tdual_xfloat_2d &buf, const int &first, const int &radvary):
+    _x(atomKK->k_x.view<DeviceType>()),
+    _radius(atomKK->k_radius.view<DeviceType>()),
+    _rmass(atomKK->k_rmass.view<DeviceType>()),
+    _v(atomKK->k_v.view<DeviceType>()),
+    _angmom(atomKK->k_angmom.view<DeviceType>()),
+    _quat(avec->k_quat.view<DeviceType>()),
+    _first(first),_radvary(radvary)
+  {
+    const size_t elements = 14 + radvary;
+    const size_t maxsend = (buf.view<DeviceType>().extent(0)*buf.view<DeviceType>().extent(1))/elements;
+    _buf = typename ArrayTypes<DeviceType>::t_xfloat_2d_const_um(buf.view<DeviceType>().data(),maxsend,elements);
+  };
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const int& i) const {
+    const int k = i + _first;
+    _x(k,0) = _buf(i,0);
+    _x(k,1) = _buf(i,1);
+    _x(k,2) = _buf(i,2);
+    _v(k,0) = _buf(i,3);
+    _v(k,1) = _buf(i,4);
+    _v(k,2) = _buf(i,5);
+    _angmom(k,0) = _buf(i,6);
+    _angmom(k,1) = _buf(i,7);
+    _angmom(k,2) = _buf(i,8);
+    _rmass(k) = _buf(i,9);
+    _quat(k,0) = _buf(i,10);
+    _quat(k,1) = _buf(i,11);
+    _quat(k,2) = _buf(i,12);
+    _quat(k,3) = _buf(i,13);
+    if (_radvary) _radius(k) = _buf(i,14);
+  }
+};
+
+/* ---------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::unpack_comm_vel_kokkos(
+  const int &n, const int &first,
+  const DAT::tdual_xfloat_2d &buf)
+{
+  if (commKK->forward_comm_on_host) {
+    atomKK->sync(Host,BACILLUS_MASK);
+    sync_bonus(Host);
+    atomKK->modified(Host,X_MASK|V_MASK|RADIUS_MASK|RMASS_MASK|
+                     ANGMOM_MASK);
+    modified_bonus(Host);
+    struct AtomVecBacillusKokkos_UnpackCommVel<LMPHostType> f(
+      atomKK,this,buf,first,radvary);
+    Kokkos::parallel_for(n,f);
+  } else {
+    atomKK->sync(Device,BACILLUS_MASK);
+    sync_bonus(Device);
+    atomKK->modified(Device,X_MASK|V_MASK|RADIUS_MASK|RMASS_MASK|
+                     ANGMOM_MASK);
+    modified_bonus(Device);
+    struct AtomVecBacillusKokkos_UnpackCommVel<LMPDeviceType> f(
+      atomKK,this,buf,first,radvary);
+    Kokkos::parallel_for(n,f);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   host communication, the bonus data follow the per-atom values
+------------------------------------------------------------------------- */
+
+int AtomVecBacillusKokkos::pack_comm(int n, int *list, double *buf,
+                                     int pbc_flag, int *pbc)
+{
+  int i,j,m;
+  double dx,dy,dz;
+
+  atomKK->sync(Host,X_MASK|RADIUS_MASK|RMASS_MASK|BACILLUS_MASK);
+
+  if (pbc_flag == 0) {
+    dx = dy = dz = 0.0;
+  } else if (domain->triclinic == 0) {
+    dx = pbc[0]*domain->xprd;
+    dy = pbc[1]*domain->yprd;
+    dz = pbc[2]*domain->zprd;
+  } else {
+    dx = pbc[0]*domain->xprd + pbc[5]*domain->xy + pbc[4]*domain->xz;
+    dy = pbc[1]*domain->yprd + pbc[3]*domain->yz;
+    dz = pbc[2]*domain->zprd;
+  }
+
+  m = 0;
+  for (i = 0; i < n; i++) {
+    j = list[i];
+    buf[m++] = h_x(j,0) + dx;
+    buf[m++] = h_x(j,1) + dy;
+    buf[m++] = h_x(j,2) + dz;
+    buf[m++] = h_rmass[j];
+    if (radvary) buf[m++] = h_radius[j];
+  }
+
+  m += avec_bacillus->pack_comm_bonus(n,list,&buf[m]);
+
+  return m;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int AtomVecBacillusKokkos::pack_comm_vel(int n, int *list, double *buf,
+                                         int pbc_flag, int *pbc)
+{
+  int i,j,m;
+  double dx,dy,dz,dvx,dvy,dvz;
+
+  atomKK->sync(Host,X_MASK|V_MASK|MASK_MASK|RADIUS_MASK|RMASS_MASK|
+               ANGMOM_MASK|BACILLUS_MASK);
+
+  dx = dy = dz = 0.0;
+  dvx = dvy = dvz = 0.0;
+  if (pbc_flag) {
+    if (domain->triclinic == 0) {
+      dx = pbc[0]*domain->xprd;
+      dy = pbc[1]*domain->yprd;
+      dz = pbc[2]*domain->zprd;
+    } else {
+      dx = pbc[0]*domain->xprd + pbc[5]*domain->xy + pbc[4]*domain->xz;
+      dy = pbc[1]*domain->yprd + pbc[3]*domain->yz;
+      dz = pbc[2]*domain->zprd;
+    }
+    if (deform_vremap) {
+      dvx = pbc[0]*h_rate[0] + pbc[5]*h_rate[5] + pbc[4]*h_rate[4];
+      dvy = pbc[1]*h_rate[1] + pbc[3]*h_rate[3];
+      dvz = pbc[2]*h_rate[2];
+    }
+  }
+
+  m = 0;
+  for (i = 0; i < n; i++) {
+    j = list[i];
+    buf[m++] = h_x(j,0) + dx;
+    buf[m++] = h_x(j,1) + dy;
+    buf[m++] = h_x(j,2) + dz;
+    if (h_mask[j] & deform_groupbit) {
+      buf[m++] = h_v(j,0) + dvx;
+      buf[m++] = h_v(j,1) + dvy;
+      buf[m++] = h_v(j,2) + dvz;
+    } else {
+      buf[m++] = h_v(j,0);
+      buf[m++] = h_v(j,1);
+      buf[m++] = h_v(j,2);
+    }
+    buf[m++] = h_angmom(j,0);
+    buf[m++] = h_angmom(j,1);
+    buf[m++] = h_angmom(j,2);
+    buf[m++] = h_rmass[j];
+    if (radvary) buf[m++] = h_radius[j];
+  }
+
+  m += avec_bacillus->pack_comm_bonus(n,list,&buf[m]);
+
+  return m;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::unpack_comm(int n, int first, double *buf)
+{
+  atomKK->sync(Host,BACILLUS_MASK);
+
+  int m = 0;
+  const int last = first + n;
+  for (int i = first; i < last; i++) {
+    h_x(i,0) = buf[m++];
+    h_x(i,1) = buf[m++];
+    h_x(i,2) = buf[m++];
+    h_rmass[i] = buf[m++];
+    if (radvary) h_radius[i] = buf[m++];
+  }
+
+  avec_bacillus->unpack_comm_bonus(n,first,&buf[m]);
+
+  atomKK->modified(Host,X_MASK|RADIUS_MASK|RMASS_MASK|BACILLUS_MASK);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::unpack_comm_vel(int n, int first, double *buf)
+{
+  atomKK->sync(Host,BACILLUS_MASK);
+
+  int m = 0;
+  const int last = first + n;
+  for (int i = first; i < last; i++) {
+    h_x(i,0) = buf[m++];
+    h_x(i,1) = buf[m++];
+    h_x(i,2) = buf[m++];
+    h_v(i,0) = buf[m++];
+    h_v(i,1) = buf[m++];
+    h_v(i,2) = buf[m++];
+    h_angmom(i,0) = buf[m++];
+    h_angmom(i,1) = buf[m++];
+    h_angmom(i,2) = buf[m++];
+    h_rmass[i] = buf[m++];
+    if (radvary) h_radius[i] = buf[m++];
+  }
+
+  avec_bacillus->unpack_comm_bonus(n,first,&buf[m]);
+
+  atomKK->modified(Host,X_MASK|V_MASK|RADIUS_MASK|RMASS_MASK|
+                   ANGMOM_MASK|BACILLUS_MASK);
+}
+
+/* ---------------------------------------------------------------------- */
+
+int AtomVecBacillusKokkos::pack_reverse(int n, int first, double *buf)
+{
+  if (n > 0)
+    atomKK->sync(Host,F_MASK|TORQUE_MASK);
+
+  int m = 0;
+  const int last = first + n;
+  for (int i = first; i < last; i++) {
+    buf[m++] = h_f(i,0);
+    buf[m++] = h_f(i,1);
+    buf[m++] = h_f(i,2);
+    buf[m++] = h_torque(i,0);
+    buf[m++] = h_torque(i,1);
+    buf[m++] = h_torque(i,2);
+  }
+  return m;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::unpack_reverse(int n, int *list, double *buf)
+{
+  if (n > 0) {
+    atomKK->sync(Host,F_MASK|TORQUE_MASK);
+    atomKK->modified(Host,F_MASK|TORQUE_MASK);
+  }
+
+  int m = 0;
+  for (int i = 0; i < n; i++) {
+    const int j = list[i];
+    h_f(j,0) += buf[m++];
+    h_f(j,1) += buf[m++];
+    h_f(j,2) += buf[m++];
+    h_torque(j,0) += buf[m++];
+    h_torque(j,1) += buf[m++];
+    h_torque(j,2) += buf[m++];
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+int AtomVecBacillusKokkos::pack_border(int n, int *list, double *buf,
+                                       int pbc_flag, int *pbc)
+{
+  int i,j,m;
+  double dx,dy,dz;
+
+  atomKK->sync(Host,ALL_MASK);
+
+  if (pbc_flag == 0) {
+    dx = dy = dz = 0.0;
+  } else if (domain->triclinic == 0) {
+    dx = pbc[0]*domain->xprd;
+    dy = pbc[1]*domain->yprd;
+    dz = pbc[2]*domain->zprd;
+  } else {
+    dx = pbc[0];
+    dy = pbc[1];
+    dz = pbc[2];
+  }
+
+  m = 0;
+  for (i = 0; i < n; i++) {
+    j = list[i];
+    buf[m++] = h_x(j,0) + dx;
+    buf[m++] = h_x(j,1) + dy;
+    buf[m++] = h_x(j,2) + dz;
+    buf[m++] = ubuf(h_tag[j]).d;
+    buf[m++] = ubuf(h_type[j]).d;
+    buf[m++] = ubuf(h_mask[j]).d;
+    buf[m++] = h_radius[j];
+    buf[m++] = h_rmass[j];
+    buf[m++] = h_biomass[j];
+  }
+
+  m += avec_bacillus->pack_border_bonus(n,list,&buf[m]);
+
+  if (atom->nextra_border)
+    for (int iextra = 0; iextra < atom->nextra_border; iextra++)
+      m += modify->fix[atom->extra_border[iextra]]->pack_border(n,list,&buf[m]);
+
+  return m;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int AtomVecBacillusKokkos::pack_border_vel(int n, int *list, double *buf,
+                                           int pbc_flag, int *pbc)
+{
+  int i,j,m;
+  double dx,dy,dz,dvx,dvy,dvz;
+
+  atomKK->sync(Host,ALL_MASK);
+
+  dx = dy = dz = 0.0;
+  dvx = dvy = dvz = 0.0;
+  if (pbc_flag) {
+    if (domain->triclinic == 0) {
+      dx = pbc[0]*domain->xprd;
+      dy = pbc[1]*domain->yprd;
+      dz = pbc[2]*domain->zprd;
+    } else {
+      dx = pbc[0];
+      dy = pbc[1];
+      dz = pbc[2];
+    }
+    if (deform_vremap) {
+      dvx = pbc[0]*h_rate[0] + pbc[5]*h_rate[5] + pbc[4]*h_rate[4];
+      dvy = pbc[1]*h_rate[1] + pbc[3]*h_rate[3];
+      dvz = pbc[2]*h_rate[2];
+    }
+  }
+
+  m = 0;
+  for (i = 0; i < n; i++) {
+    j = list[i];
+    buf[m++] = h_x(j,0) + dx;
+    buf[m++] = h_x(j,1) + dy;
+    buf[m++] = h_x(j,2) + dz;
+    buf[m++] = ubuf(h_tag[j]).d;
+    buf[m++] = ubuf(h_type[j]).d;
+    buf[m++] = ubuf(h_mask[j]).d;
+    if (h_mask[j] & deform_groupbit) {
+      buf[m++] = h_v(j,0) + dvx;
+      buf[m++] = h_v(j,1) + dvy;
+      buf[m++] = h_v(j,2) + dvz;
+    } else {
+      buf[m++] = h_v(j,0);
+      buf[m++] = h_v(j,1);
+      buf[m++] = h_v(j,2);
+    }
+    buf[m++] = h_radius[j];
+    buf[m++] = h_rmass[j];
+    buf[m++] = h_biomass[j];
+    buf[m++] = h_angmom(j,0);
+    buf[m++] = h_angmom(j,1);
+    buf[m++] = h_angmom(j,2);
+  }
+
+  m += avec_bacillus->pack_border_bonus(n,list,&buf[m]);
+
+  if (atom->nextra_border)
+    for (int iextra = 0; iextra < atom->nextra_border; iextra++)
+      m += modify->fix[atom->extra_border[iextra]]->pack_border(n,list,&buf[m]);
+
+  return m;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::unpack_border(int n, int first, double *buf)
+{
+  int m = 0;
+  const int last = first + n;
+  for (int i = first; i < last; i++) {
+    if (i == nmax) grow(0);
+    h_x(i,0) = buf[m++];
+    h_x(i,1) = buf[m++];
+    h_x(i,2) = buf[m++];
+    h_tag[i] = (tagint) ubuf(buf[m++]).i;
+    h_type[i] = (int) ubuf(buf[m++]).i;
+    h_mask[i] = (int) ubuf(buf[m++]).i;
+    h_radius[i] = buf[m++];
+    h_rmass[i] = buf[m++];
+    h_biomass[i] = buf[m++];
+  }
+
+  m += avec_bacillus->unpack_border_bonus(n,first,&buf[m]);
+
+  if (atom->nextra_border)
+    for (int iextra = 0; iextra < atom->nextra_border; iextra++)
+      m += modify->fix[atom->extra_border[iextra]]->
+        unpack_border(n,first,&buf[m]);
+
+  atomKK->modified(Host,X_MASK|TAG_MASK|TYPE_MASK|MASK_MASK|RADIUS_MASK|
+                   RMASS_MASK|BIOMASS_MASK|BACILLUS_MASK);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::unpack_border_vel(int n, int first, double *buf)
+{
+  int m = 0;
+  const int last = first + n;
+  for (int i = first; i < last; i++) {
+    if (i == nmax) grow(0);
+    h_x(i,0) = buf[m++];
+    h_x(i,1) = buf[m++];
+    h_x(i,2) = buf[m++];
+    h_tag[i] = (tagint) ubuf(buf[m++]).i;
+    h_type[i] = (int) ubuf(buf[m++]).i;
+    h_mask[i] = (int) ubuf(buf[m++]).i;
+    h_v(i,0) = buf[m++];
+    h_v(i,1) = buf[m++];
+    h_v(i,2) = buf[m++];
+    h_radius[i] = buf[m++];
+    h_rmass[i] = buf[m++];
+    h_biomass[i] = buf[m++];
+    h_angmom(i,0) = buf[m++];
+    h_angmom(i,1) = buf[m++];
+    h_angmom(i,2) = buf[m++];
+  }
+
+  m += avec_bacillus->unpack_border_bonus(n,first,&buf[m]);
+
+  if (atom->nextra_border)
+    for (int iextra = 0; iextra < atom->nextra_border; iextra++)
+      m += modify->fix[atom->extra_border[iextra]]->
+        unpack_border(n,first,&buf[m]);
+
+  atomKK->modified(Host,X_MASK|V_MASK|TAG_MASK|TYPE_MASK|MASK_MASK|
+                   RADIUS_MASK|RMASS_MASK|BIOMASS_MASK|ANGMOM_MASK|
+                   BACILLUS_MASK);
+}
+
+/* ----------------------------------------------------------------------
+   Kokkos border and exchange communication is never used by this style
+   CommKokkos switches to the classic routines for styles with bonus data
+------------------------------------------------------------------------- */
+
+int AtomVecBacillusKokkos::pack_border_kokkos(
+  int /*n*/, DAT::tdual_int_2d /*k_sendlist*/, DAT::tdual_xfloat_2d /*buf*/,
+  int /*iswap*/, int /*pbc_flag*/, int * /*pbc*/, ExecutionSpace /*space*/)
+{
+  error->all(FLERR,"Atom style bacillus/kk does not support Kokkos border "
+             "or exchange communication");
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::unpack_border_kokkos(
+  const int &/*n*/, const int &/*nfirst*/, const DAT::tdual_xfloat_2d &/*buf*/,
+  ExecutionSpace /*space*/)
+{
+  error->all(FLERR,"Atom style bacillus/kk does not support Kokkos border "
+             "or exchange communication");
+}
+
+/* ---------------------------------------------------------------------- */
+
+int AtomVecBacillusKokkos::pack_exchange_kokkos(
+  const int &/*nsend*/, DAT::tdual_xfloat_2d &/*buf*/,
+  DAT::tdual_int_1d /*k_sendlist*/, DAT::tdual_int_1d /*k_copylist*/,
+  ExecutionSpace /*space*/, int /*dim*/, X_FLOAT /*lo*/, X_FLOAT /*hi*/)
+{
+  error->all(FLERR,"Atom style bacillus/kk does not support Kokkos border "
+             "or exchange communication");
+  return 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int AtomVecBacillusKokkos::unpack_exchange_kokkos(
+  DAT::tdual_xfloat_2d &/*k_buf*/, int /*nrecv*/, int /*nlocal*/,
+  int /*dim*/, X_FLOAT /*lo*/, X_FLOAT /*hi*/, ExecutionSpace /*space*/)
+{
+  error->all(FLERR,"Atom style bacillus/kk does not support Kokkos border "
+             "or exchange communication");
+  return 0;
+}
+
+/* ----------------------------------------------------------------------
+   pack data for atom I for sending to another proc
+   xyz must be 1st 3 values, so comm::exchange() can test on them
+------------------------------------------------------------------------- */
+
+int AtomVecBacillusKokkos::pack_exchange(int i, double *buf)
+{
+  atomKK->sync(Host,X_MASK|V_MASK|TAG_MASK|TYPE_MASK|MASK_MASK|IMAGE_MASK|
+               RADIUS_MASK|RMASS_MASK|BIOMASS_MASK|ANGMOM_MASK|BACILLUS_MASK);
+
+  int m = 1;
+  buf[m++] = h_x(i,0);
+  buf[m++] = h_x(i,1);
+  buf[m++] = h_x(i,2);
+  buf[m++] = h_v(i,0);
+  buf[m++] = h_v(i,1);
+  buf[m++] = h_v(i,2);
+  buf[m++] = ubuf(h_tag[i]).d;
+  buf[m++] = ubuf(h_type[i]).d;
+  buf[m++] = ubuf(h_mask[i]).d;
+  buf[m++] = ubuf(h_image[i]).d;
+
+  buf[m++] = h_radius[i];
+  buf[m++] = h_rmass[i];
+  buf[m++] = h_biomass[i];
+  buf[m++] = h_angmom(i,0);
+  buf[m++] = h_angmom(i,1);
+  buf[m++] = h_angmom(i,2);
+
+  m += avec_bacillus->pack_exchange_bonus(i,&buf[m]);
+
+  if (atom->nextra_grow)
+    for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
+      m += modify->fix[atom->extra_grow[iextra]]->pack_exchange(i,&buf[m]);
+
+  buf[0] = m;
+  return m;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int AtomVecBacillusKokkos::unpack_exchange(double *buf)
+{
+  int nlocal = atom->nlocal;
+  if (nlocal == nmax) grow(0);
+
+  int m = 1;
+  h_x(nlocal,0) = buf[m++];
+  h_x(nlocal,1) = buf[m++];
+  h_x(nlocal,2) = buf[m++];
+  h_v(nlocal,0) = buf[m++];
+  h_v(nlocal,1) = buf[m++];
+  h_v(nlocal,2) = buf[m++];
+  h_tag[nlocal] = (tagint) ubuf(buf[m++]).i;
+  h_type[nlocal] = (int) ubuf(buf[m++]).i;
+  h_mask[nlocal] = (int) ubuf(buf[m++]).i;
+  h_image[nlocal] = (imageint) ubuf(buf[m++]).i;
+  h_radius[nlocal] = buf[m++];
+  h_rmass[nlocal] = buf[m++];
+  h_biomass[nlocal] = buf[m++];
+  h_angmom(nlocal,0) = buf[m++];
+  h_angmom(nlocal,1) = buf[m++];
+  h_angmom(nlocal,2) = buf[m++];
+
+  m += avec_bacillus->unpack_exchange_bonus(nlocal,&buf[m]);
+
+  if (atom->nextra_grow)
+    for (int iextra = 0; iextra < atom->nextra_grow; iextra++)
+      m += modify->fix[atom->extra_grow[iextra]]->
+        unpack_exchange(nlocal,&buf[m]);
+
+  atomKK->modified(Host,X_MASK|V_MASK|TAG_MASK|TYPE_MASK|MASK_MASK|IMAGE_MASK|
+                   RADIUS_MASK|RMASS_MASK|BIOMASS_MASK|ANGMOM_MASK|BACILLUS_MASK);
+
+  atom->nlocal++;
+  return m;
+}
+
+/* ----------------------------------------------------------------------
+   size of restart data for all atoms owned by this proc
+   include extra data stored by fixes
+------------------------------------------------------------------------- */
+
+int AtomVecBacillusKokkos::size_restart()
+{
+  int i;
+
+  atomKK->sync(Host,BACILLUS_MASK);
+
+  int nlocal = atom->nlocal;
+  int n = 17 * nlocal + avec_bacillus->size_restart_bonus();
+
+  if (atom->nextra_restart)
+    for (int iextra = 0; iextra < atom->nextra_restart; iextra++)
+      for (i = 0; i < nlocal; i++)
+        n += modify->fix[atom->extra_restart[iextra]]->size_restart(i);
+
+  return n;
+}
+
+/* ----------------------------------------------------------------------
+   pack atom I's data for restart file including extra quantities
+   xyz must be 1st 3 values, so that read_restart can test on them
+------------------------------------------------------------------------- */
+
+int AtomVecBacillusKokkos::pack_restart(int i, double *buf)
+{
+  atomKK->sync(Host,X_MASK|TAG_MASK|TYPE_MASK|MASK_MASK|IMAGE_MASK|V_MASK|
+               RADIUS_MASK|RMASS_MASK|BIOMASS_MASK|ANGMOM_MASK|BACILLUS_MASK);
+
+  int m = 1;
+  buf[m++] = h_x(i,0);
+  buf[m++] = h_x(i,1);
+  buf[m++] = h_x(i,2);
+  buf[m++] = ubuf(h_tag[i]).d;
+  buf[m++] = ubuf(h_type[i]).d;
+  buf[m++] = ubuf(h_mask[i]).d;
+  buf[m++] = ubuf(h_image[i]).d;
+  buf[m++] = h_v(i,0);
+  buf[m++] = h_v(i,1);
+  buf[m++] = h_v(i,2);
+  buf[m++] = h_radius[i];
+  buf[m++] = h_rmass[i];
+  buf[m++] = h_biomass[i];
+  buf[m++] = h_angmom(i,0);
+  buf[m++] = h_angmom(i,1);
+  buf[m++] = h_angmom(i,2);
+
+  m += avec_bacillus->pack_restart_bonus(i,&buf[m]);
+
+  if (atom->nextra_restart)
+    for (int iextra = 0; iextra < atom->nextra_restart; iextra++)
+      m += modify->fix[atom->extra_restart[iextra]]->pack_restart(i,&buf[m]);
+
+  buf[0] = m;
+  return m;
+}
+
+/* ----------------------------------------------------------------------
+   unpack data for one atom from restart file including extra quantities
+------------------------------------------------------------------------- */
+
+int AtomVecBacillusKokkos::unpack_restart(double *buf)
+{
+  int nlocal = atom->nlocal;
+  if (nlocal == nmax) {
+    grow(0);
+    if (atom->nextra_store)
+      memory->grow(atom->extra,nmax,atom->nextra_store,"atom:extra");
+  }
+
+  int m = 1;
+  h_x(nlocal,0) = buf[m++];
+  h_x(nlocal,1) = buf[m++];
+  h_x(nlocal,2) = buf[m++];
+  h_tag[nlocal] = (tagint) ubuf(buf[m++]).i;
+  h_type[nlocal] = (int) ubuf(buf[m++]).i;
+  h_mask[nlocal] = (int) ubuf(buf[m++]).i;
+  h_image[nlocal] = (imageint) ubuf(buf[m++]).i;
+  h_v(nlocal,0) = buf[m++];
+  h_v(nlocal,1) = buf[m++];
+  h_v(nlocal,2) = buf[m++];
+  h_radius[nlocal] = buf[m++];
+  h_rmass[nlocal] = buf[m++];
+  h_biomass[nlocal] = buf[m++];
+  h_angmom(nlocal,0) = buf[m++];
+  h_angmom(nlocal,1) = buf[m++];
+  h_angmom(nlocal,2) = buf[m++];
+
+  m += avec_bacillus->unpack_restart_bonus(nlocal,&buf[m]);
+
+  double **extra = atom->extra;
+  if (atom->nextra_store) {
+    int size = static_cast<int> (buf[0]) - m;
+    for (int i = 0; i < size; i++) extra[nlocal][i] = buf[m++];
+  }
+
+  atomKK->modified(Host,X_MASK|TAG_MASK|TYPE_MASK|MASK_MASK|IMAGE_MASK|V_MASK|
+                   RADIUS_MASK|RMASS_MASK|BIOMASS_MASK|ANGMOM_MASK|BACILLUS_MASK);
+
+  atom->nlocal++;
+  return m;
+}
+
+/* ----------------------------------------------------------------------
+   create one atom of itype at coord
+   set other values to defaults
+------------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::create_atom(int itype, double *coord)
+{
+  int nlocal = atom->nlocal;
+  if (nlocal == nmax) {
+    grow(0);
+  }
+
+  atomKK->sync(Host,ALL_MASK);
+
+  h_tag[nlocal] = 0;
+  h_type[nlocal] = itype;
+  h_x(nlocal,0) = coord[0];
+  h_x(nlocal,1) = coord[1];
+  h_x(nlocal,2) = coord[2];
+  h_mask[nlocal] = 1;
+  h_image[nlocal] = ((imageint) IMGMAX << IMG2BITS) |
+    ((imageint) IMGMAX << IMGBITS) | IMGMAX;
+  h_v(nlocal,0) = 0.0;
+  h_v(nlocal,1) = 0.0;
+  h_v(nlocal,2) = 0.0;
+  h_radius[nlocal] = 0.5e-6;
+  h_rmass[nlocal] = 1.0;
+  h_biomass[nlocal] = 1.0;
+  h_angmom(nlocal,0) = 0.0;
+  h_angmom(nlocal,1) = 0.0;
+  h_angmom(nlocal,2) = 0.0;
+  h_bacillus[nlocal] = -1;
+
+  atomKK->modified(Host,ALL_MASK);
+
+  atom->nlocal++;
+}
+
+/* ----------------------------------------------------------------------
+   unpack one line from Atoms section of data file
+   initialize other atom quantities
+   rmass holds the density until the Bacilli section sets the mass
+------------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::data_atom(double *coord, imageint imagetmp, char **values)
+{
+  int nlocal = atom->nlocal;
+  if (nlocal == nmax) grow(0);
+
+  tag[nlocal] = utils::tnumeric(FLERR,values[0],true,lmp);
+  type[nlocal] = utils::inumeric(FLERR,values[1],true,lmp);
+  if (type[nlocal] <= 0 || type[nlocal] > atom->ntypes)
+    error->one(FLERR,"Invalid atom type in Atoms section of data file");
+
+  int bacillusflag = utils::inumeric(FLERR,values[2],true,lmp);
+  if (bacillusflag == 0) bacillus[nlocal] = -1;
+  else if (bacillusflag == 1) bacillus[nlocal] = 0;
+  else error->one(FLERR,"Invalid bacillus flag in Atoms section of data file");
+
+  rmass[nlocal] = utils::numeric(FLERR,values[3],true,lmp);
+  if (rmass[nlocal] <= 0.0)
+    error->one(FLERR,"Invalid density in Atoms section of data file");
+  radius[nlocal] = 0.0;
+
+  x[nlocal][0] = coord[0];
+  x[nlocal][1] = coord[1];
+  x[nlocal][2] = coord[2];
+
+  image[nlocal] = imagetmp;
+
+  mask[nlocal] = 1;
+  v[nlocal][0] = 0.0;
+  v[nlocal][1] = 0.0;
+  v[nlocal][2] = 0.0;
+  angmom[nlocal][0] = 0.0;
+  angmom[nlocal][1] = 0.0;
+  angmom[nlocal][2] = 0.0;
+  biomass[nlocal] = 1.0;
+
+  atomKK->modified(Host,ALL_MASK);
+
+  atom->nlocal++;
+}
+
+/* ----------------------------------------------------------------------
+   unpack one line from Velocities section of data file
+------------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::data_vel(int m, char **values)
+{
+  atomKK->sync(Host,V_MASK|ANGMOM_MASK);
+  h_v(m,0) = utils::numeric(FLERR,values[0],true,lmp);
+  h_v(m,1) = utils::numeric(FLERR,values[1],true,lmp);
+  h_v(m,2) = utils::numeric(FLERR,values[2],true,lmp);
+  h_angmom(m,0) = utils::numeric(FLERR,values[3],true,lmp);
+  h_angmom(m,1) = utils::numeric(FLERR,values[4],true,lmp);
+  h_angmom(m,2) = utils::numeric(FLERR,values[5],true,lmp);
+  atomKK->modified(Host,V_MASK|ANGMOM_MASK);
+}
+
+/* ----------------------------------------------------------------------
+   pack atom info for data file including 3 image flags
+   bacillus mass is converted back to a density
+------------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::pack_data(double **buf)
+{
+  atomKK->sync(Host,TAG_MASK|TYPE_MASK|RADIUS_MASK|RMASS_MASK|X_MASK|
+               IMAGE_MASK|BACILLUS_MASK);
+
+  AtomVecBacillus::Bonus *bonus = avec_bacillus->bonus;
+
+  int nlocal = atom->nlocal;
+  for (int i = 0; i < nlocal; i++) {
+    buf[i][0] = ubuf(h_tag[i]).d;
+    buf[i][1] = ubuf(h_type[i]).d;
+    if (h_bacillus[i] < 0) {
+      buf[i][2] = ubuf(0).d;
+      buf[i][3] = h_rmass[i];
+    } else {
+      const double r = h_radius[i];
+      buf[i][2] = ubuf(1).d;
+      buf[i][3] = h_rmass[i] / (4.0*MY_PI/3.0*r*r*r +
+                                MY_PI*r*r*bonus[h_bacillus[i]].length);
+    }
+    buf[i][4] = h_x(i,0);
+    buf[i][5] = h_x(i,1);
+    buf[i][6] = h_x(i,2);
+    buf[i][7] = ubuf((h_image[i] & IMGMASK) - IMGMAX).d;
+    buf[i][8] = ubuf((h_image[i] >> IMGBITS & IMGMASK) - IMGMAX).d;
+    buf[i][9] = ubuf((h_image[i] >> IMG2BITS) - IMGMAX).d;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   write atom info to data file including 3 image flags
+------------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::write_data(FILE *fp, int n, double **buf)
+{
+  for (int i = 0; i < n; i++)
+    fprintf(fp,TAGINT_FORMAT
+            " %d %d %-1.16e %-1.16e %-1.16e %-1.16e %d %d %d\n",
+            (tagint) ubuf(buf[i][0]).i,(int) ubuf(buf[i][1]).i,
+            (int) ubuf(buf[i][2]).i,buf[i][3],
+            buf[i][4],buf[i][5],buf[i][6],
+            (int) ubuf(buf[i][7]).i,(int) ubuf(buf[i][8]).i,
+            (int) ubuf(buf[i][9]).i);
+}
+
+/* ----------------------------------------------------------------------
+   pack velocity info for data file
+------------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::pack_vel(double **buf)
+{
+  atomKK->sync(Host,TAG_MASK|V_MASK|ANGMOM_MASK);
+
+  int nlocal = atom->nlocal;
+  for (int i = 0; i < nlocal; i++) {
+    buf[i][0] = ubuf(h_tag[i]).d;
+    buf[i][1] = h_v(i,0);
+    buf[i][2] = h_v(i,1);
+    buf[i][3] = h_v(i,2);
+    buf[i][4] = h_angmom(i,0);
+    buf[i][5] = h_angmom(i,1);
+    buf[i][6] = h_angmom(i,2);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   write velocity info to data file
+------------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::write_vel(FILE *fp, int n, double **buf)
+{
+  for (int i = 0; i < n; i++)
+    fprintf(fp,TAGINT_FORMAT
+            " %-1.16e %-1.16e %-1.16e %-1.16e %-1.16e %-1.16e\n",
+            (tagint) ubuf(buf[i][0]).i,buf[i][1],buf[i][2],buf[i][3],
+            buf[i][4],buf[i][5],buf[i][6]);
+}
+
+/* ----------------------------------------------------------------------
+   bonus data of the host style
+------------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::clear_bonus()
+{
+  avec_bacillus->clear_bonus();
+}
+
+/* ---------------------------------------------------------------------- */
+
+double AtomVecBacillusKokkos::memory_usage_bonus()
+{
+  return avec_bacillus->memory_usage_bonus();
+}
+
+/* ---------------------------------------------------------------------- */
+
+int AtomVecBacillusKokkos::pack_data_bonus(double *buf, int flag)
+{
+  atomKK->sync(Host,TAG_MASK|BACILLUS_MASK);
+  return avec_bacillus->pack_data_bonus(buf,flag);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::write_data_bonus(FILE *fp, int n, double *buf, int flag)
+{
+  avec_bacillus->write_data_bonus(fp,n,buf,flag);
+}
+
+/* ----------------------------------------------------------------------
+   return # of bytes of allocated memory
+------------------------------------------------------------------------- */
+
+double AtomVecBacillusKokkos::memory_usage()
+{
+  double bytes = 0;
+
+  if (atom->memcheck("tag")) bytes += memory->usage(tag,nmax);
+  if (atom->memcheck("type")) bytes += memory->usage(type,nmax);
+  if (atom->memcheck("mask")) bytes += memory->usage(mask,nmax);
+  if (atom->memcheck("image")) bytes += memory->usage(image,nmax);
+  if (atom->memcheck("x")) bytes += memory->usage(x,nmax,3);
+  if (atom->memcheck("v")) bytes += memory->usage(v,nmax,3);
+  if (atom->memcheck("f")) bytes += memory->usage(f,nmax*comm->nthreads,3);
+  if (atom->memcheck("radius")) bytes += memory->usage(radius,nmax);
+  if (atom->memcheck("rmass")) bytes += memory->usage(rmass,nmax);
+  if (atom->memcheck("biomass")) bytes += memory->usage(biomass,nmax);
+  if (atom->memcheck("angmom")) bytes += memory->usage(angmom,nmax,3);
+  if (atom->memcheck("torque"))
+    bytes += memory->usage(torque,nmax*comm->nthreads,3);
+  if (atom->memcheck("bacillus")) bytes += memory->usage(bacillus,nmax);
+
+  // per-atom copies of quat, inertia, poles, length and diameter
+
+  bytes += (double) nmax * 16 * sizeof(double);
+  bytes += memory_usage_bonus();
+
+  return bytes;
+}
+
+/* ----------------------------------------------------------------------
+   copy the bonus data of the host style into the per-atom views
+   a local atom flagged as bacillus by data_atom() has no bonus entry
+   until the Bacilli section is read, so only valid indices are copied
+------------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::bonus_to_views()
+{
+  const int nlocal = atom->nlocal;
+  const int nall = nlocal + atom->nghost;
+  const int nlocal_bonus = avec_bacillus->nlocal_bonus;
+  AtomVecBacillus::Bonus *bonus = avec_bacillus->bonus;
+
+  HAT::t_float_2d h_quat = k_quat.h_view;
+  HAT::t_float_2d h_inertia = k_inertia.h_view;
+  HAT::t_float_2d h_pole1 = k_pole1.h_view;
+  HAT::t_float_2d h_pole2 = k_pole2.h_view;
+  HAT::t_float_1d h_length = k_length.h_view;
+  HAT::t_float_1d h_diameter = k_diameter.h_view;
+
+  for (int i = 0; i < nall; i++) {
+    const int k = h_bacillus[i];
+    if (k < 0 || (i < nlocal && k >= nlocal_bonus)) continue;
+    for (int d = 0; d < 4; d++) h_quat(i,d) = bonus[k].quat[d];
+    for (int d = 0; d < 3; d++) {
+      h_inertia(i,d) = bonus[k].inertia[d];
+      h_pole1(i,d) = bonus[k].pole1[d];
+      h_pole2(i,d) = bonus[k].pole2[d];
+    }
+    h_length[i] = bonus[k].length;
+    h_diameter[i] = bonus[k].diameter;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   copy the per-atom views back into the bonus data of the host style
+------------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::views_to_bonus()
+{
+  const int nlocal = atom->nlocal;
+  const int nall = nlocal + atom->nghost;
+  const int nlocal_bonus = avec_bacillus->nlocal_bonus;
+  AtomVecBacillus::Bonus *bonus = avec_bacillus->bonus;
+
+  HAT::t_float_2d h_quat = k_quat.h_view;
+  HAT::t_float_2d h_inertia = k_inertia.h_view;
+  HAT::t_float_2d h_pole1 = k_pole1.h_view;
+  HAT::t_float_2d h_pole2 = k_pole2.h_view;
+  HAT::t_float_1d h_length = k_length.h_view;
+  HAT::t_float_1d h_diameter = k_diameter.h_view;
+
+  for (int i = 0; i < nall; i++) {
+    const int k = h_bacillus[i];
+    if (k < 0 || (i < nlocal && k >= nlocal_bonus)) continue;
+    for (int d = 0; d < 4; d++) bonus[k].quat[d] = h_quat(i,d);
+    for (int d = 0; d < 3; d++) {
+      bonus[k].inertia[d] = h_inertia(i,d);
+      bonus[k].pole1[d] = h_pole1(i,d);
+      bonus[k].pole2[d] = h_pole2(i,d);
+    }
+    bonus[k].length = h_length[i];
+    bonus[k].diameter = h_diameter[i];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   BACILLUS_MASK covers the bonus index and the bonus array of the host
+   style, the views are brought up to date on a device sync
+------------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::sync(ExecutionSpace space, unsigned int mask)
+{
+  if (space == Device) {
+    if (mask & X_MASK) atomKK->k_x.sync<LMPDeviceType>();
+    if (mask & V_MASK) atomKK->k_v.sync<LMPDeviceType>();
+    if (mask & F_MASK) atomKK->k_f.sync<LMPDeviceType>();
+    if (mask & TAG_MASK) atomKK->k_tag.sync<LMPDeviceType>();
+    if (mask & TYPE_MASK) atomKK->k_type.sync<LMPDeviceType>();
+    if (mask & MASK_MASK) atomKK->k_mask.sync<LMPDeviceType>();
+    if (mask & IMAGE_MASK) atomKK->k_image.sync<LMPDeviceType>();
+    if (mask & RADIUS_MASK) atomKK->k_radius.sync<LMPDeviceType>();
+    if (mask & RMASS_MASK) atomKK->k_rmass.sync<LMPDeviceType>();
+    if (mask & BIOMASS_MASK) atomKK->k_biomass.sync<LMPDeviceType>();
+    if (mask & ANGMOM_MASK) atomKK->k_angmom.sync<LMPDeviceType>();
+    if (mask & TORQUE_MASK) atomKK->k_torque.sync<LMPDeviceType>();
+    if (mask & BACILLUS_MASK) {
+      atomKK->k_bacillus.sync<LMPDeviceType>();
+      sync_bonus(Device);
+    }
+  } else {
+    if (mask & X_MASK) atomKK->k_x.sync<LMPHostType>();
+    if (mask & V_MASK) atomKK->k_v.sync<LMPHostType>();
+    if (mask & F_MASK) atomKK->k_f.sync<LMPHostType>();
+    if (mask & TAG_MASK) atomKK->k_tag.sync<LMPHostType>();
+    if (mask & TYPE_MASK) atomKK->k_type.sync<LMPHostType>();
+    if (mask & MASK_MASK) atomKK->k_mask.sync<LMPHostType>();
+    if (mask & IMAGE_MASK) atomKK->k_image.sync<LMPHostType>();
+    if (mask & RADIUS_MASK) atomKK->k_radius.sync<LMPHostType>();
+    if (mask & RMASS_MASK) atomKK->k_rmass.sync<LMPHostType>();
+    if (mask & BIOMASS_MASK) atomKK->k_biomass.sync<LMPHostType>();
+    if (mask & ANGMOM_MASK) atomKK->k_angmom.sync<LMPHostType>();
+    if (mask & TORQUE_MASK) atomKK->k_torque.sync<LMPHostType>();
+    if (mask & BACILLUS_MASK) {
+      atomKK->k_bacillus.sync<LMPHostType>();
+      if (views_modified) {
+        k_quat.sync<LMPHostType>();
+        k_inertia.sync<LMPHostType>();
+        k_pole1.sync<LMPHostType>();
+        k_pole2.sync<LMPHostType>();
+        k_length.sync<LMPHostType>();
+        k_diameter.sync<LMPHostType>();
+        views_to_bonus();
+        views_modified = 0;
+      }
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::sync_overlapping_device(ExecutionSpace space, unsigned int mask)
+{
+  // the bonus views need a host-side copy first, so they are synced
+  // synchronously
+
+  if (mask & BACILLUS_MASK) sync(space,BACILLUS_MASK);
+
+  if (space == Device) {
+    if ((mask & X_MASK) && atomKK->k_x.need_sync<LMPDeviceType>())
+      perform_async_copy<DAT::tdual_x_array>(atomKK->k_x,space);
+    if ((mask & V_MASK) && atomKK->k_v.need_sync<LMPDeviceType>())
+      perform_async_copy<DAT::tdual_v_array>(atomKK->k_v,space);
+    if ((mask & F_MASK) && atomKK->k_f.need_sync<LMPDeviceType>())
+      perform_async_copy<DAT::tdual_f_array>(atomKK->k_f,space);
+    if ((mask & TAG_MASK) && atomKK->k_tag.need_sync<LMPDeviceType>())
+      perform_async_copy<DAT::tdual_tagint_1d>(atomKK->k_tag,space);
+    if ((mask & TYPE_MASK) && atomKK->k_type.need_sync<LMPDeviceType>())
+      perform_async_copy<DAT::tdual_int_1d>(atomKK->k_type,space);
+    if ((mask & MASK_MASK) && atomKK->k_mask.need_sync<LMPDeviceType>())
+      perform_async_copy<DAT::tdual_int_1d>(atomKK->k_mask,space);
+    if ((mask & IMAGE_MASK) && atomKK->k_image.need_sync<LMPDeviceType>())
+      perform_async_copy<DAT::tdual_imageint_1d>(atomKK->k_image,space);
+    if ((mask & RADIUS_MASK) && atomKK->k_radius.need_sync<LMPDeviceType>())
+      perform_async_copy<DAT::tdual_float_1d>(atomKK->k_radius,space);
+    if ((mask & RMASS_MASK) && atomKK->k_rmass.need_sync<LMPDeviceType>())
+      perform_async_copy<DAT::tdual_float_1d>(atomKK->k_rmass,space);
+    if ((mask & BIOMASS_MASK) && atomKK->k_biomass.need_sync<LMPDeviceType>())
+      perform_async_copy<DAT::tdual_float_1d>(atomKK->k_biomass,space);
+    if ((mask & ANGMOM_MASK) && atomKK->k_angmom.need_sync<LMPDeviceType>())
+      perform_async_copy<DAT::tdual_v_array>(atomKK->k_angmom,space);
+    if ((mask & TORQUE_MASK) && atomKK->k_torque.need_sync<LMPDeviceType>())
+      perform_async_copy<DAT::tdual_f_array>(atomKK->k_torque,space);
+  } else {
+    if ((mask & X_MASK) && atomKK->k_x.need_sync<LMPHostType>())
+      perform_async_copy<DAT::tdual_x_array>(atomKK->k_x,space);
+    if ((mask & V_MASK) && atomKK->k_v.need_sync<LMPHostType>())
+      perform_async_copy<DAT::tdual_v_array>(atomKK->k_v,space);
+    if ((mask & F_MASK) && atomKK->k_f.need_sync<LMPHostType>())
+      perform_async_copy<DAT::tdual_f_array>(atomKK->k_f,space);
+    if ((mask & TAG_MASK) && atomKK->k_tag.need_sync<LMPHostType>())
+      perform_async_copy<DAT::tdual_tagint_1d>(atomKK->k_tag,space);
+    if ((mask & TYPE_MASK) && atomKK->k_type.need_sync<LMPHostType>())
+      perform_async_copy<DAT::tdual_int_1d>(atomKK->k_type,space);
+    if ((mask & MASK_MASK) && atomKK->k_mask.need_sync<LMPHostType>())
+      perform_async_copy<DAT::tdual_int_1d>(atomKK->k_mask,space);
+    if ((mask & IMAGE_MASK) && atomKK->k_image.need_sync<LMPHostType>())
+      perform_async_copy<DAT::tdual_imageint_1d>(atomKK->k_image,space);
+    if ((mask & RADIUS_MASK) && atomKK->k_radius.need_sync<LMPHostType>())
+      perform_async_copy<DAT::tdual_float_1d>(atomKK->k_radius,space);
+    if ((mask & RMASS_MASK) && atomKK->k_rmass.need_sync<LMPHostType>())
+      perform_async_copy<DAT::tdual_float_1d>(atomKK->k_rmass,space);
+    if ((mask & BIOMASS_MASK) && atomKK->k_biomass.need_sync<LMPHostType>())
+      perform_async_copy<DAT::tdual_float_1d>(atomKK->k_biomass,space);
+    if ((mask & ANGMOM_MASK) && atomKK->k_angmom.need_sync<LMPHostType>())
+      perform_async_copy<DAT::tdual_v_array>(atomKK->k_angmom,space);
+    if ((mask & TORQUE_MASK) && atomKK->k_torque.need_sync<LMPHostType>())
+      perform_async_copy<DAT::tdual_f_array>(atomKK->k_torque,space);
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::modified(ExecutionSpace space, unsigned int mask)
+{
+  if (space == Device) {
+    if (mask & X_MASK) atomKK->k_x.modify<LMPDeviceType>();
+    if (mask & V_MASK) atomKK->k_v.modify<LMPDeviceType>();
+    if (mask & F_MASK) atomKK->k_f.modify<LMPDeviceType>();
+    if (mask & TAG_MASK) atomKK->k_tag.modify<LMPDeviceType>();
+    if (mask & TYPE_MASK) atomKK->k_type.modify<LMPDeviceType>();
+    if (mask & MASK_MASK) atomKK->k_mask.modify<LMPDeviceType>();
+    if (mask & IMAGE_MASK) atomKK->k_image.modify<LMPDeviceType>();
+    if (mask & RADIUS_MASK) atomKK->k_radius.modify<LMPDeviceType>();
+    if (mask & RMASS_MASK) atomKK->k_rmass.modify<LMPDeviceType>();
+    if (mask & BIOMASS_MASK) atomKK->k_biomass.modify<LMPDeviceType>();
+    if (mask & ANGMOM_MASK) atomKK->k_angmom.modify<LMPDeviceType>();
+    if (mask & TORQUE_MASK) atomKK->k_torque.modify<LMPDeviceType>();
+    if (mask & BACILLUS_MASK) {
+      atomKK->k_bacillus.modify<LMPDeviceType>();
+      modified_bonus(Device);
+    }
+  } else {
+    if (mask & X_MASK) atomKK->k_x.modify<LMPHostType>();
+    if (mask & V_MASK) atomKK->k_v.modify<LMPHostType>();
+    if (mask & F_MASK) atomKK->k_f.modify<LMPHostType>();
+    if (mask & TAG_MASK) atomKK->k_tag.modify<LMPHostType>();
+    if (mask & TYPE_MASK) atomKK->k_type.modify<LMPHostType>();
+    if (mask & MASK_MASK) atomKK->k_mask.modify<LMPHostType>();
+    if (mask & IMAGE_MASK) atomKK->k_image.modify<LMPHostType>();
+    if (mask & RADIUS_MASK) atomKK->k_radius.modify<LMPHostType>();
+    if (mask & RMASS_MASK) atomKK->k_rmass.modify<LMPHostType>();
+    if (mask & BIOMASS_MASK) atomKK->k_biomass.modify<LMPHostType>();
+    if (mask & ANGMOM_MASK) atomKK->k_angmom.modify<LMPHostType>();
+    if (mask & TORQUE_MASK) atomKK->k_torque.modify<LMPHostType>();
+    if (mask & BACILLUS_MASK) {
+      atomKK->k_bacillus.modify<LMPHostType>();
+      bonus_modified = 1;
+      views_modified = 0;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   bring the bonus views of the given space up to date with the bonus
+   array, a single memory space build never reports a need to sync so
+   the state of the bonus array is tracked separately
+------------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::sync_bonus(ExecutionSpace space)
+{
+  if (bonus_modified) {
+    atomKK->k_bacillus.sync<LMPHostType>();
+    bonus_to_views();
+    k_quat.modify<LMPHostType>();
+    k_inertia.modify<LMPHostType>();
+    k_pole1.modify<LMPHostType>();
+    k_pole2.modify<LMPHostType>();
+    k_length.modify<LMPHostType>();
+    k_diameter.modify<LMPHostType>();
+    bonus_modified = 0;
+  }
+
+  if (space == Device) {
+    k_quat.sync<LMPDeviceType>();
+    k_inertia.sync<LMPDeviceType>();
+    k_pole1.sync<LMPDeviceType>();
+    k_pole2.sync<LMPDeviceType>();
+    k_length.sync<LMPDeviceType>();
+    k_diameter.sync<LMPDeviceType>();
+  } else {
+    k_quat.sync<LMPHostType>();
+    k_inertia.sync<LMPHostType>();
+    k_pole1.sync<LMPHostType>();
+    k_pole2.sync<LMPHostType>();
+    k_length.sync<LMPHostType>();
+    k_diameter.sync<LMPHostType>();
+  }
+}
+
+/* ----------------------------------------------------------------------
+   flag the bonus views of the given space as newer than the bonus array
+------------------------------------------------------------------------- */
+
+void AtomVecBacillusKokkos::modified_bonus(ExecutionSpace space)
+{
+  views_modified = 1;
+  bonus_modified = 0;
+
+  if (space == Device) {
+    k_quat.modify<LMPDeviceType>();
+    k_inertia.modify<LMPDeviceType>();
+    k_pole1.modify<LMPDeviceType>();
+    k_pole2.modify<LMPDeviceType>();
+    k_length.modify<LMPDeviceType>();
+    k_diameter.modify<LMPDeviceType>();
+  } else {
+    k_quat.modify<LMPHostType>();
+    k_inertia.modify<LMPHostType>();
+    k_pole1.modify<LMPHostType>();
+    k_pole2.modify<LMPHostType>();
+    k_length.modify<LMPHostType>();
+    k_diameter.modify<LMPHostType>();
+  }
+}
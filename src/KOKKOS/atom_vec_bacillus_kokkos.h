@@ -0,0 +1,198 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef ATOM_CLASS
+
+AtomStyle(bacillus/kk,AtomVecBacillusKokkos)
+AtomStyle(bacillus/kk/device,AtomVecBacillusKokkos)
+AtomStyle(bacillus/kk/host,AtomVecBacillusKokkos)
+
+#else
+
+#ifndef LMP_ATOM_VEC_BACILLUS_KOKKOS_H
+#define LMP_ATOM_VEC_BACILLUS_KOKKOS_H
+
+#include "atom_vec_kokkos.h"
+#include "kokkos_type.h"
+
+namespace LAMMPS_NS {
+
+class AtomVecBacillusKokkos : public AtomVecKokkos {
+ public:
+  AtomVecBacillusKokkos(class LAMMPS *);
+  ~AtomVecBacillusKokkos();
+  void process_args(int, char **);
+  void init();
+  void grow(int);
+  void grow_pointers();
+  void copy(int, int, int);
+  int pack_comm(int, int *, double *, int, int *);
+  int pack_comm_vel(int, int *, double *, int, int *);
+  void unpack_comm(int, int, double *);
+  void unpack_comm_vel(int, int, double *);
+  int pack_reverse(int, int, double *);
+  void unpack_reverse(int, int *, double *);
+  int pack_border(int, int *, double *, int, int *);
+  int pack_border_vel(int, int *, double *, int, int *);
+  void unpack_border(int, int, double *);
+  void unpack_border_vel(int, int, double *);
+  int pack_exchange(int, double *);
+  int unpack_exchange(double *);
+  int size_restart();
+  int pack_restart(int, double *);
+  int unpack_restart(double *);
+  void create_atom(int, double *);
+  void data_atom(double *, imageint, char **);
+  void data_vel(int, char **);
+  void pack_data(double **);
+  void write_data(FILE *, int, double **);
+  void pack_vel(double **);
+  void write_vel(FILE *, int, double **);
+  double memory_usage();
+
+  // bonus data are kept by the host AtomVecBacillus
+
+  void clear_bonus();
+  double memory_usage_bonus();
+  int pack_data_bonus(double *, int);
+  void write_data_bonus(FILE *, int, double *, int);
+
+  int pack_comm_kokkos(const int &n, const DAT::tdual_int_2d &k_sendlist,
+                       const int & iswap,
+                       const DAT::tdual_xfloat_2d &buf,
+                       const int &pbc_flag, const int pbc[]);
+  void unpack_comm_kokkos(const int &n, const int &nfirst,
+                          const DAT::tdual_xfloat_2d &buf);
+  int pack_comm_vel_kokkos(const int &n, const DAT::tdual_int_2d &k_sendlist,
+                           const int & iswap,
+                           const DAT::tdual_xfloat_2d &buf,
+                           const int &pbc_flag, const int pbc[]);
+  void unpack_comm_vel_kokkos(const int &n, const int &nfirst,
+                              const DAT::tdual_xfloat_2d &buf);
+  int pack_comm_self(const int &n, const DAT::tdual_int_2d &list,
+                     const int & iswap, const int nfirst,
+                     const int &pbc_flag, const int pbc[]);
+  int pack_comm_self_fused(const int &n, const DAT::tdual_int_2d &list,
+                           const DAT::tdual_int_1d &sendnum_scan,
+                           const DAT::tdual_int_1d &firstrecv,
+                           const DAT::tdual_int_1d &pbc_flag,
+                           const DAT::tdual_int_2d &pbc,
+                           const DAT::tdual_int_1d &g2l);
+  int pack_border_kokkos(int n, DAT::tdual_int_2d k_sendlist,
+                         DAT::tdual_xfloat_2d buf,int iswap,
+                         int pbc_flag, int *pbc, ExecutionSpace space);
+  void unpack_border_kokkos(const int &n, const int &nfirst,
+                            const DAT::tdual_xfloat_2d &buf,
+                            ExecutionSpace space);
+  int pack_exchange_kokkos(const int &nsend,DAT::tdual_xfloat_2d &buf,
+                           DAT::tdual_int_1d k_sendlist,
+                           DAT::tdual_int_1d k_copylist,
+                           ExecutionSpace space, int dim,
+                           X_FLOAT lo, X_FLOAT hi);
+  int unpack_exchange_kokkos(DAT::tdual_xfloat_2d &k_buf, int nrecv,
+                             int nlocal, int dim, X_FLOAT lo, X_FLOAT hi,
+                             ExecutionSpace space);
+
+  void sync(ExecutionSpace space, unsigned int mask);
+  void modified(ExecutionSpace space, unsigned int mask);
+  void sync_overlapping_device(ExecutionSpace space, unsigned int mask);
+
+  // BACILLUS_MASK on the host refers to the bonus array of the host style,
+  // kernels reading or writing the per-atom copies below use these instead
+
+  void sync_bonus(ExecutionSpace space);
+  void modified_bonus(ExecutionSpace space);
+
+  // per-atom copies of the bonus data, valid for atoms with bacillus >= 0
+
+  DAT::tdual_float_2d k_quat;
+  DAT::tdual_float_2d k_inertia;
+  DAT::tdual_float_2d k_pole1, k_pole2;
+  DAT::tdual_float_1d k_length, k_diameter;
+
+ private:
+  class AtomVecBacillus *avec_bacillus;   // host style holding the bonus data
+  int bonus_modified;    // 1 if the bonus array is newer than the views
+  int views_modified;    // 1 if the views are newer than the bonus array
+
+  tagint *tag;
+  int *type,*mask;
+  imageint *image;
+  double **x,**v,**f;
+  double *radius,*rmass,*biomass;
+  double **angmom,**torque;
+  int *bacillus;
+  int radvary;
+
+  DAT::t_tagint_1d d_tag;
+  HAT::t_tagint_1d h_tag;
+  DAT::t_imageint_1d d_image;
+  HAT::t_imageint_1d h_image;
+  DAT::t_int_1d d_type, d_mask;
+  HAT::t_int_1d h_type, h_mask;
+
+  DAT::t_x_array d_x;
+  DAT::t_v_array d_v;
+  DAT::t_f_array d_f;
+  DAT::t_float_1d d_radius;
+  HAT::t_float_1d h_radius;
+  DAT::t_float_1d d_rmass;
+  HAT::t_float_1d h_rmass;
+  DAT::t_float_1d d_biomass;
+  HAT::t_float_1d h_biomass;
+  DAT::t_v_array d_angmom;
+  HAT::t_v_array h_angmom;
+  DAT::t_f_array d_torque;
+  HAT::t_f_array h_torque;
+  DAT::t_int_1d d_bacillus;
+  HAT::t_int_1d h_bacillus;
+
+  void bonus_to_views();
+  void views_to_bonus();
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Illegal atom_style bacillus command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.
+
+E: Per-processor system is too big
+
+The number of owned atoms plus ghost atoms on a single
+processor must fit in 32-bit integer.
+
+E: Invalid atom type in Atoms section of data file
+
+Atom types must range from 1 to specified # of types.
+
+E: Invalid density in Atoms section of data file
+
+Density value cannot be <= 0.0.
+
+E: Invalid bacillus flag in Atoms section of data file
+
+The bacillus flag must be 0 or 1.
+
+E: Atom style bacillus/kk does not support Kokkos border or exchange communication
+
+The bonus data of this style are only communicated by the host
+routines.  This error should not occur.  Contact the developers.
+
+*/
@@ -141,6 +141,9 @@ void CommKokkos::init()
 
   if (ghost_velocity && ((AtomVecKokkos*)atom->avec)->no_comm_vel_flag) // not all Kokkos atom_vec styles have comm vel pack/unpack routines yet
     forward_comm_classic = true;
+
+  if (atom->avec->bonus_flag) // bonus data only have host border/exchange routines
+    exchange_comm_classic = true;
 }
 
 /* ----------------------------------------------------------------------
@@ -356,35 +359,35 @@ void CommKokkos::reverse_comm_device()
 
 /* ---------------------------------------------------------------------- */
 
-void CommKokkos::forward_comm_fix(Fix *fix, int size)
+void CommKokkos::forward_comm(Fix *fix, int size)
 {
   k_sendlist.sync<LMPHostType>();
-  CommBrick::forward_comm_fix(fix,size);
+  CommBrick::forward_comm(fix,size);
 }
 
-void CommKokkos::reverse_comm_fix(Fix *fix, int size)
+void CommKokkos::reverse_comm(Fix *fix, int size)
 {
   k_sendlist.sync<LMPHostType>();
-  CommBrick::reverse_comm_fix(fix, size);
+  CommBrick::reverse_comm(fix, size);
 }
 
-void CommKokkos::forward_comm_compute(Compute *compute)
+void CommKokkos::forward_comm(Compute *compute)
 {
   k_sendlist.sync<LMPHostType>();
-  CommBrick::forward_comm_compute(compute);
+  CommBrick::forward_comm(compute);
 }
 
-void CommKokkos::reverse_comm_compute(Compute *compute)
+void CommKokkos::reverse_comm(Compute *compute)
 {
   k_sendlist.sync<LMPHostType>();
-  CommBrick::reverse_comm_compute(compute);
+  CommBrick::reverse_comm(compute);
 }
 
-void CommKokkos::forward_comm_pair(Pair *pair)
+void CommKokkos::forward_comm(Pair *pair)
 {
   if (pair->execution_space == Host) {
     k_sendlist.sync<LMPHostType>();
-    CommBrick::forward_comm_pair(pair);
+    CommBrick::forward_comm(pair);
   } else if (pair->execution_space == Device) {
     k_sendlist.sync<LMPDeviceType>();
     forward_comm_pair_device<LMPDeviceType>(pair);
@@ -460,22 +463,22 @@ void CommKokkos::grow_buf_pair(int n) {
   k_buf_recv_pair.resize(max_buf_pair);
 }
 
-void CommKokkos::reverse_comm_pair(Pair *pair)
+void CommKokkos::reverse_comm(Pair *pair)
 {
   k_sendlist.sync<LMPHostType>();
-  CommBrick::reverse_comm_pair(pair);
+  CommBrick::reverse_comm(pair);
 }
 
-void CommKokkos::forward_comm_dump(Dump *dump)
+void CommKokkos::forward_comm(Dump *dump)
 {
   k_sendlist.sync<LMPHostType>();
-  CommBrick::forward_comm_dump(dump);
+  CommBrick::forward_comm(dump);
 }
 
-void CommKokkos::reverse_comm_dump(Dump *dump)
+void CommKokkos::reverse_comm(Dump *dump)
 {
   k_sendlist.sync<LMPHostType>();
-  CommBrick::reverse_comm_dump(dump);
+  CommBrick::reverse_comm(dump);
 }
 
 /* ----------------------------------------------------------------------
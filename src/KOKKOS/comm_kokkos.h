@@ -39,14 +39,14 @@ class CommKokkos : public CommBrick {
   void exchange();                     // move atoms to new procs
   void borders();                      // setup list of atoms to comm
 
-  void forward_comm_pair(class Pair *);    // forward comm from a Pair
-  void reverse_comm_pair(class Pair *);    // reverse comm from a Pair
-  void forward_comm_fix(class Fix *, int size=0);      // forward comm from a Fix
-  void reverse_comm_fix(class Fix *, int size=0);      // reverse comm from a Fix
-  void forward_comm_compute(class Compute *);  // forward from a Compute
-  void reverse_comm_compute(class Compute *);  // reverse from a Compute
-  void forward_comm_dump(class Dump *);    // forward comm from a Dump
-  void reverse_comm_dump(class Dump *);    // reverse comm from a Dump
+  void forward_comm(class Pair *);    // forward comm from a Pair
+  void reverse_comm(class Pair *);    // reverse comm from a Pair
+  void forward_comm(class Fix *, int size=0);      // forward comm from a Fix
+  void reverse_comm(class Fix *, int size=0);      // reverse comm from a Fix
+  void forward_comm(class Compute *);  // forward from a Compute
+  void reverse_comm(class Compute *);  // reverse from a Compute
+  void forward_comm(class Dump *);    // forward comm from a Dump
+  void reverse_comm(class Dump *);    // reverse comm from a Dump
 
   template<class DeviceType> void forward_comm_device(int dummy);
   template<class DeviceType> void reverse_comm_device();
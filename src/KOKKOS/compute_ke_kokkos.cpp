@@ -15,6 +15,7 @@
 #include "compute_ke_kokkos.h"
 #include "atom_kokkos.h"
 #include "atom_masks.h"
+#include "force.h"
 #include "update.h"
 
 using namespace LAMMPS_NS;
@@ -56,7 +57,7 @@ double ComputeKEKokkos<DeviceType>::compute_scalar()
   copymode = 0;
 
   MPI_Allreduce(&ke,&scalar,1,MPI_DOUBLE,MPI_SUM,world);
-  scalar *= pfactor;
+  scalar *= 0.5 * force->mvv2e;    // ComputeKE::pfactor is private
   return scalar;
 }
 
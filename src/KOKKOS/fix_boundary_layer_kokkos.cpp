@@ -44,11 +44,10 @@ void FixBoundaryLayerKokkos<DeviceType>::compute()
 {
   d_mask = atomKK->k_mask.template view<DeviceType>();
   d_x = atomKK->k_x.template view<DeviceType>();
-  d_boundary = gridKK->k_boundary.template view<DeviceType>();
   d_gmask = gridKK->k_mask.template view<DeviceType>();
 
   atomKK->sync(execution_space, datamask_read);
-  gridKK->sync(execution_space, GMASK_MASK | BOUNDARY_MASK);
+  gridKK->sync(execution_space, GMASK_MASK);
 
   copymode = 1;
   Functor f(this);
@@ -61,7 +60,7 @@ void FixBoundaryLayerKokkos<DeviceType>::compute()
   // compute maximum and minimum atom position w.r.t 6 planes in the system
   // not use LAMMPS_LAMBDA due to incompatiability issue with some gpu devices
   // xlo
-  if (boundary[0] == DIRICHLET) {
+  if (xlo) {
     Kokkos::parallel_reduce(
 	Kokkos::RangePolicy<
 	DeviceType,
@@ -69,7 +68,7 @@ void FixBoundaryLayerKokkos<DeviceType>::compute()
   }
 
   // ylo
-  if (boundary[2] == DIRICHLET) {
+  if (ylo) {
     Kokkos::parallel_reduce(
       Kokkos::RangePolicy<
       DeviceType,
@@ -77,7 +76,7 @@ void FixBoundaryLayerKokkos<DeviceType>::compute()
   }
 
   // zlo
-  if (boundary[4] == DIRICHLET) {
+  if (zlo) {
     Kokkos::parallel_reduce(
       Kokkos::RangePolicy<
       DeviceType,
@@ -85,7 +84,7 @@ void FixBoundaryLayerKokkos<DeviceType>::compute()
   }
 
   // xhi
-  if (boundary[1] == DIRICHLET) {
+  if (xhi) {
     Kokkos::parallel_reduce(
       Kokkos::RangePolicy<
       DeviceType,
@@ -93,7 +92,7 @@ void FixBoundaryLayerKokkos<DeviceType>::compute()
   }
 
   // yhi
-  if (boundary[3] == DIRICHLET) {
+  if (yhi) {
     Kokkos::parallel_reduce(
       Kokkos::RangePolicy<
       DeviceType,
@@ -101,7 +100,7 @@ void FixBoundaryLayerKokkos<DeviceType>::compute()
   }
 
   // zhi
-  if (boundary[5] == DIRICHLET) {
+  if (zhi) {
     Kokkos::parallel_reduce(
       Kokkos::RangePolicy<
       DeviceType,
@@ -132,15 +131,17 @@ void FixBoundaryLayerKokkos<DeviceType>::compute()
   copymode = 0;
 
   gridKK->modified(execution_space, GMASK_MASK);
+  grid->mask_version++;
 }
 
 /* ---------------------------------------------------------------------- */
 
 template <class DeviceType>
 FixBoundaryLayerKokkos<DeviceType>::Functor::Functor(FixBoundaryLayerKokkos<DeviceType> *ptr):
-  d_mask(ptr->d_mask), d_x(ptr->d_x), d_gmask(ptr->d_gmask),
-  d_boundary(ptr->d_boundary), groupbit(ptr->groupbit),
-  isub(ptr->isub)
+  groupbit(ptr->groupbit),
+  xlo(ptr->xlo), xhi(ptr->xhi), ylo(ptr->ylo),
+  yhi(ptr->yhi), zlo(ptr->zlo), zhi(ptr->zhi),
+  d_x(ptr->d_x), d_mask(ptr->d_mask), d_gmask(ptr->d_gmask)
 {
   for (int i = 0; i < 3; i++) {
     layerhi[i] = ptr->layerhi[i];
@@ -223,31 +224,24 @@ void FixBoundaryLayerKokkos<DeviceType>::Functor::operator()(FixLayerUpdateMaskT
   for (int y = 0; y < grid_subbox[1]; y++) {
     for (int x = 0; x < grid_subbox[0]; x++) {
       int i = x + y * grid_subbox[0] + z * grid_subbox[0] * grid_subbox[1];
-      int m = 0;
-      if (d_gmask(i) & GHOST_MASK)
-	m |= GHOST_MASK;
-      if (d_gmask(i) & CORNER_MASK)
-	m |= CORNER_MASK;
-      else {
-	if ((grid_sublo[0] < 0 && x == 0) ||
-	    (d_boundary(isub, 0) == 0 && x <= sublayerlo[0]))
-	  m |= X_NB_MASK;
-	if ((grid_subhi[0] > grid_box[0] && x == grid_subbox[0] - 1) ||
-	    (d_boundary(isub, 1) == 0 && x >= sublayerhi[0]))
-	  m |= X_PB_MASK;
-	if ((grid_sublo[1] < 0 && y == 0) ||
-	    (d_boundary(isub, 2) == 0 && y <= sublayerlo[1]))
-	  m |= Y_NB_MASK;
-	if ((grid_subhi[1] > grid_box[1] && y == grid_subbox[1] - 1) ||
-	    (d_boundary(isub, 3) == 0 && y >= sublayerhi[1]))
-	  m |= Y_PB_MASK;
-	if ((grid_sublo[2] < 0 && z == 0) ||
-	    (d_boundary(isub, 4) == 0 && z <= sublayerlo[2]))
-	  m |= Z_NB_MASK;
-	if ((grid_subhi[2] > grid_box[2] && z == grid_subbox[2] - 1) ||
-	    (d_boundary(isub, 5) == 0 && z >= sublayerhi[2]))
-	  m |= Z_PB_MASK;
+      int m = d_gmask(i) & (GHOST_MASK | CORNER_MASK |
+                            X_NB_MASK | X_PB_MASK |
+                            Y_NB_MASK | Y_PB_MASK |
+                            Z_NB_MASK | Z_PB_MASK);
+
+      if ((xlo && x <= sublayerlo[0]) ||
+          (xhi && x >= sublayerhi[0]) ||
+          (ylo && y <= sublayerlo[1]) ||
+          (yhi && y >= sublayerhi[1]) ||
+          (zlo && z <= sublayerlo[2]) ||
+          (zhi && z >= sublayerhi[2])) {
+        m |= BLAYER_MASK;
       }
+
+      if (!(m & GHOST_MASK) && !(m & BLAYER_MASK)) {
+        m |= GRID_MASK;
+      }
+
       d_gmask(i) = m;
     }
   }
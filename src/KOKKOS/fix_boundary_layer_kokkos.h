@@ -45,8 +45,8 @@ class FixBoundaryLayerKokkos : public FixBoundaryLayer {
 
   struct Functor
   {
-    int isub;
     int groupbit;
+    int xlo, xhi, ylo, yhi, zlo, zhi;
 
     int grid_box[3];
     int grid_subbox[3];
@@ -63,7 +63,6 @@ class FixBoundaryLayerKokkos : public FixBoundaryLayer {
     typename AT::t_x_array d_x;
     typename AT::t_int_1d d_mask;
     typename AT::t_int_1d d_gmask;
-    typename AT::t_int_2d d_boundary;
 
     Functor(FixBoundaryLayerKokkos *ptr);
 
@@ -100,7 +99,6 @@ class FixBoundaryLayerKokkos : public FixBoundaryLayer {
   typename AT::t_x_array d_x;
   typename AT::t_int_1d d_mask;
   typename AT::t_int_1d d_gmask;
-  typename AT::t_int_2d d_boundary;
 };
 
 }
@@ -104,6 +104,8 @@ void FixDensityKokkos<DeviceType>::compute()
   copymode = 0;
 
   gridKK->modified(execution_space, DENS_MASK);
+  // host density is not up to date, occupied() returns all cells
+  grid->set_occupied(0);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -32,6 +32,11 @@ FixDiffusionReactionKokkos<DeviceType>::FixDiffusionReactionKokkos(LAMMPS *lmp,
   kokkosable = 1;
   execution_space = ExecutionSpaceFromDevice<DeviceType>::space;
   closed_system = FixDiffusionReaction::closed_system;
+
+  if (solver != EXPLICIT)
+    error->all(FLERR, "Fix nufeb/diffusion_reaction/kk only supports the explicit solver");
+  if (freeze_size)
+    error->all(FLERR, "Fix nufeb/diffusion_reaction/kk does not support freeze");
 }
 
 /* ---------------------------------------------------------------------- */
@@ -0,0 +1,56 @@
+/* ----------------------------------------------------------------------
+ LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+ http://lammps.sandia.gov, Sandia National Laboratories
+ Steve Plimpton, sjplimp@sandia.gov
+
+ Copyright (2003) Sandia Corporation.  Under the terms of Contract
+ DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+ certain rights in this software.  This software is distributed under
+ the GNU General Public License.
+
+ See the README file in the top-level LAMMPS directory.
+ ------------------------------------------------------------------------- */
+
+#include "fix_divide_bacillus_kokkos.h"
+#include "atom_kokkos.h"
+#include "atom_masks.h"
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+/* ---------------------------------------------------------------------- */
+
+template <class DeviceType>
+FixDivideBacillusKokkos<DeviceType>::FixDivideBacillusKokkos(LAMMPS *lmp, int narg, char **arg) :
+  FixDivideBacillus(lmp, narg, arg)
+{
+  kokkosable = 1;
+  atomKK = (AtomKokkos *) atom;
+  execution_space = ExecutionSpaceFromDevice<DeviceType>::space;
+
+  datamask_read = ALL_MASK;
+  datamask_modify = ALL_MASK;
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class DeviceType>
+void FixDivideBacillusKokkos<DeviceType>::compute()
+{
+  // division of rods is rare and serial by nature (the random stream is
+  // shared by all procs and new atoms are appended one at a time), so it
+  // runs on the host copies of the per-atom and bonus data
+
+  atomKK->sync(Host,datamask_read);
+  FixDivideBacillus::compute();
+  atomKK->modified(Host,datamask_modify);
+}
+
+/* ---------------------------------------------------------------------- */
+
+namespace LAMMPS_NS {
+template class FixDivideBacillusKokkos<LMPDeviceType>;
+#ifdef LMP_KOKKOS_GPU
+template class FixDivideBacillusKokkos<LMPHostType>;
+#endif
+}
@@ -0,0 +1,45 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+
+FixStyle(nufeb/division/bacillus/kk,FixDivideBacillusKokkos<LMPDeviceType>)
+FixStyle(nufeb/division/bacillus/kk/device,FixDivideBacillusKokkos<LMPDeviceType>)
+FixStyle(nufeb/division/bacillus/kk/host,FixDivideBacillusKokkos<LMPHostType>)
+
+#else
+
+#ifndef LMP_FIX_DIVIDE_BACILLUS_KOKKOS_H
+#define LMP_FIX_DIVIDE_BACILLUS_KOKKOS_H
+
+#include "fix_divide_bacillus.h"
+#include "kokkos_type.h"
+
+namespace LAMMPS_NS {
+
+template <class DeviceType>
+class FixDivideBacillusKokkos : public FixDivideBacillus {
+ public:
+  FixDivideBacillusKokkos(class LAMMPS *, int, char **);
+  ~FixDivideBacillusKokkos() {}
+
+  void compute();
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+*/
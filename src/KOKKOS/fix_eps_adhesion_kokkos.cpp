@@ -39,7 +39,7 @@ FixEPSAdhesionKokkos<DeviceType>::FixEPSAdhesionKokkos(LAMMPS *lmp, int narg, ch
   kokkosable = 1;
   execution_space = ExecutionSpaceFromDevice<DeviceType>::space;
 
-  virial_flag = 0;
+  virial_global_flag = 0;
 
   datamask_read = X_MASK | F_MASK | MASK_MASK | RMASS_MASK | RADIUS_MASK | OUTER_MASS_MASK | OUTER_RADIUS_MASK;
   datamask_modify = F_MASK;
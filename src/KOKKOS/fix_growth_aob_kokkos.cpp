@@ -154,7 +154,7 @@ void FixGrowthAOBKokkos<DeviceType>::Functor::operator()(FixGrowthAOBCellsGrowth
   double tmp2 = maintain * d_conc(io2, i) / (o2_affinity + d_conc(io2, i));
 
   if (!(d_gmask(i) & GHOST_MASK)) {
-    d_growth(igroup, i, 0) = tmp1 - tmp2 - decay;
+    d_growth(igroup, i) = tmp1 - tmp2 - decay;
   }
 }
 
@@ -183,7 +183,7 @@ void FixGrowthAOBKokkos<DeviceType>::Functor::operator()(FixGrowthAOBAtomsTag, i
     const double density = d_rmass(i) /
       (4.0 * MY_PI / 3.0 * d_radius(i) * d_radius(i) * d_radius(i));
 
-    d_rmass(i) = d_rmass(i) * (1 + d_growth(igroup, cell, 0) * dt);
+    d_rmass(i) = d_rmass(i) * (1 + d_growth(igroup, cell) * dt);
     d_outer_mass(i) = 0.0;
 
     d_radius(i) = pow((3.0 / (4.0 * MY_PI)) * (d_rmass(i) / density), 1.0 / 3.0);
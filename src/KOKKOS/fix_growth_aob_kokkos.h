@@ -70,7 +70,7 @@ class FixGrowthAOBKokkos: public FixGrowthAOB {
     typename AT::t_float_2d d_conc;
     typename AT::t_float_2d d_reac;
     typename AT::t_float_2d d_dens;
-    typename AT::t_float_3d d_growth;
+    typename AT::t_float_2d d_growth;
 
     typename AT::t_x_array d_x;
     typename AT::t_float_1d d_rmass;
@@ -102,7 +102,7 @@ class FixGrowthAOBKokkos: public FixGrowthAOB {
   typename AT::t_float_2d d_conc;
   typename AT::t_float_2d d_reac;
   typename AT::t_float_2d d_dens;
-  typename AT::t_float_3d d_growth;
+  typename AT::t_float_2d d_growth;
 
   typename AT::t_x_array d_x;
   typename AT::t_float_1d d_rmass;
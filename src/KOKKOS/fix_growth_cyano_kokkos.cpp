@@ -118,17 +118,17 @@ FixGrowthCyanoKokkos<DeviceType>::Functor::Functor(FixGrowthCyanoKokkos<DeviceTy
   isuc(ptr->isuc), io2(ptr->io2),
   light_affinity(ptr->light_affinity), co2_affinity(ptr->co2_affinity),
   growth(ptr->growth), yield(ptr->yield), maintain(ptr->maintain), decay(ptr->decay),
-  suc_exp(ptr->suc_exp), gco2_flag(ptr->gco2_flag),
+  suc_exp(ptr->suc_exp),
   cell_size(ptr->cell_size), vol(ptr->vol),
   d_mask(ptr->d_mask), d_gmask(ptr->d_gmask), d_conc(ptr->d_conc), d_reac(ptr->d_reac),
   d_dens(ptr->d_dens), d_growth(ptr->d_growth), d_x(ptr->d_x), d_rmass(ptr->d_rmass),
   d_radius(ptr->d_radius), d_outer_mass(ptr->d_outer_mass), d_outer_radius(ptr->d_outer_radius)
 {
-for (int i = 0; i < 3; i++) {
-  boxlo[i] = ptr->boxlo[i];
-  grid_sublo[i] = ptr->grid_sublo[i];
-  grid_subbox[i] = ptr->grid_subbox[i];
-}
+  for (int i = 0; i < 3; i++) {
+    boxlo[i] = ptr->boxlo[i];
+    grid_sublo[i] = ptr->grid_sublo[i];
+    grid_subbox[i] = ptr->grid_subbox[i];
+  }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -139,7 +139,8 @@ void FixGrowthCyanoKokkos<DeviceType>::Functor::operator()(FixGrowthCyanoCellsRe
 {
   double tmp1 = growth * d_conc(ilight, i) / (light_affinity + d_conc(ilight, i)) *
       d_conc(ico2, i) / (co2_affinity + d_conc(ico2, i));
-  double tmp3 = 4 * tmp1 * suc_exp;
+  // sucrose export-induced growth reduction
+  double tmp3 = tmp1 * (-3.4897 * exp(-suc_exp/0.048) + 3.4092);
 
   if (!(d_gmask(i) & GHOST_MASK)) {
     // nutrient utilization
@@ -150,10 +151,6 @@ void FixGrowthCyanoKokkos<DeviceType>::Functor::operator()(FixGrowthCyanoCellsRe
     d_reac(io2, i) += (0.727 / yield) * (tmp1 + tmp3) * d_dens(igroup, i);
     // sucrose export
     d_reac(isuc, i) += (0.65 / yield) * tmp3 * d_dens(igroup, i);
-
-    // co2 dissolution
-    if (gco2_flag == 1)
-      d_reac(ico2, i) += 4.4e-6 * d_conc(igco2, i) - (4.4e-6 * d_conc(ico2, i));
   }
 }
 
@@ -165,10 +162,11 @@ void FixGrowthCyanoKokkos<DeviceType>::Functor::operator()(FixGrowthCyanoCellsGr
 {
   double tmp1 = growth * d_conc(ilight, i) / (light_affinity + d_conc(ilight, i)) *
       d_conc(ico2, i) / (co2_affinity + d_conc(ico2, i));
-  double tmp2 = 0.2 * tmp1 * suc_exp;
+  // sucrose export-induced growth reduction
+  double tmp2 = tmp1 * (0.141 * exp(-suc_exp/0.063) + 0.9);
 
   if (!(d_gmask(i) & GHOST_MASK)) {
-    d_growth(igroup, i, 0) = tmp1 - tmp2 - decay - maintain;
+    d_growth(igroup, i) = tmp2 - decay - maintain;
   }
 }
 
@@ -197,7 +195,7 @@ void FixGrowthCyanoKokkos<DeviceType>::Functor::operator()(FixGrowthCyanoAtomsTa
     const double density = d_rmass(i) /
       (4.0 * MY_PI / 3.0 * d_radius(i) * d_radius(i) * d_radius(i));
 
-    d_rmass(i) = d_rmass(i) * (1 + d_growth(igroup, cell, 0) * dt);
+    d_rmass(i) = d_rmass(i) * (1 + d_growth(igroup, cell) * dt);
     d_outer_mass(i) = 0.0;
 
     d_radius(i) = pow((3.0 / (4.0 * MY_PI)) * (d_rmass(i) / density), 1.0 / 3.0);
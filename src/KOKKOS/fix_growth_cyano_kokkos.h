@@ -60,7 +60,6 @@ class FixGrowthCyanoKokkos: public FixGrowthCyano {
     double maintain;
     double decay;
     double suc_exp;
-    double gco2_flag;
 
     double boxlo[3];
     int grid_sublo[3];
@@ -74,7 +73,7 @@ class FixGrowthCyanoKokkos: public FixGrowthCyano {
     typename AT::t_float_2d d_conc;
     typename AT::t_float_2d d_reac;
     typename AT::t_float_2d d_dens;
-    typename AT::t_float_3d d_growth;
+    typename AT::t_float_2d d_growth;
 
     typename AT::t_x_array d_x;
     typename AT::t_float_1d d_rmass;
@@ -107,7 +106,7 @@ class FixGrowthCyanoKokkos: public FixGrowthCyano {
   typename AT::t_float_2d d_conc;
   typename AT::t_float_2d d_reac;
   typename AT::t_float_2d d_dens;
-  typename AT::t_float_3d d_growth;
+  typename AT::t_float_2d d_growth;
 
   typename AT::t_x_array d_x;
   typename AT::t_float_1d d_rmass;
@@ -144,7 +144,7 @@ KOKKOS_INLINE_FUNCTION
 void FixGrowthEPSKokkos<DeviceType>::Functor::operator()(FixGrowthEPSCellsGrowthTag, int i) const
 {
   if (!(d_gmask(i) & GHOST_MASK)) {
-    d_growth(igroup, i, 0) = -decay;
+    d_growth(igroup, i) = -decay;
   }
 }
 
@@ -174,7 +174,7 @@ void FixGrowthEPSKokkos<DeviceType>::Functor::operator()(FixGrowthEPSAtomsTag, i
     const double density = d_rmass(i) /
       (4.0 * MY_PI / 3.0 * d_radius(i) * d_radius(i) * d_radius(i));
 
-    d_rmass(i) = d_rmass(i) * (1 + d_growth(igroup, cell, 0) * dt);
+    d_rmass(i) = d_rmass(i) * (1 + d_growth(igroup, cell) * dt);
     d_outer_mass(i) = 0.0;
 
     d_radius(i) = pow((3.0 / (4.0 * MY_PI)) * (d_rmass(i) / density), 1.0 / 3.0);
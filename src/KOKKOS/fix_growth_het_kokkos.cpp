@@ -84,6 +84,7 @@ void FixGrowthHETKokkos<DeviceType>::update_atoms()
   d_gmask = gridKK->k_mask.template view<DeviceType>();
   d_conc = gridKK->k_conc.template view<DeviceType>();
   d_growth = gridKK->k_growth.template view<DeviceType>();
+  d_eps_rate = gridKK->k_eps_rate.template view<DeviceType>();
 
   cell_size = grid->cell_size;
   vol = cell_size * cell_size * cell_size;
@@ -121,7 +122,8 @@ FixGrowthHETKokkos<DeviceType>::Functor::Functor(FixGrowthHETKokkos<DeviceType>
   eps_yield(ptr->eps_yield), anoxic(ptr->anoxic), eps_dens(ptr->eps_dens),
   cell_size(ptr->cell_size), vol(ptr->vol),
   d_mask(ptr->d_mask), d_gmask(ptr->d_gmask), d_conc(ptr->d_conc), d_reac(ptr->d_reac),
-  d_dens(ptr->d_dens), d_growth(ptr->d_growth), d_x(ptr->d_x), d_rmass(ptr->d_rmass),
+  d_dens(ptr->d_dens), d_growth(ptr->d_growth), d_eps_rate(ptr->d_eps_rate),
+  d_x(ptr->d_x), d_rmass(ptr->d_rmass),
   d_radius(ptr->d_radius), d_outer_mass(ptr->d_outer_mass), d_outer_radius(ptr->d_outer_radius)
 {
   for (int i = 0; i < 3; i++) {
@@ -166,8 +168,8 @@ void FixGrowthHETKokkos<DeviceType>::Functor::operator()(FixGrowthHETCellsGrowth
   double tmp6 = 1 / 1.17 * maintain * anoxic * d_conc(ino2, i) / (no2_affinity + d_conc(ino2, i)) * o2_affinity / (o2_affinity + d_conc(io2, i));
 
   if (!(d_gmask(i) & GHOST_MASK)) {
-    d_growth(igroup, i, 0) = tmp1 + tmp2 + tmp3 - tmp4 - tmp5 - tmp6 - decay;
-    d_growth(igroup, i, 1) = (eps_yield / yield) * (tmp1 + tmp2 + tmp3);
+    d_growth(igroup, i) = tmp1 + tmp2 + tmp3 - tmp4 - tmp5 - tmp6 - decay;
+    d_eps_rate(igroup, i) = (eps_yield / yield) * (tmp1 + tmp2 + tmp3);
   }
 }
 
@@ -196,11 +198,11 @@ void FixGrowthHETKokkos<DeviceType>::Functor::operator()(FixGrowthHETAtomsTag, i
     const double density = d_rmass(i) /
       (4.0 * MY_PI / 3.0 * d_radius(i) * d_radius(i) * d_radius(i));
 
-    d_rmass(i) = d_rmass(i) * (1 + d_growth(igroup, cell, 0) * dt);
+    d_rmass(i) = d_rmass(i) * (1 + d_growth(igroup, cell) * dt);
     d_outer_mass(i) = 4.0 * MY_PI / 3.0 *
       (d_outer_radius(i) * d_outer_radius(i) * d_outer_radius(i) -
        d_radius(i) * d_radius(i) * d_radius(i)) *
-      eps_dens + d_growth(igroup, cell, 1) * d_rmass(i) * dt;
+      eps_dens + d_eps_rate(igroup, cell) * d_rmass(i) * dt;
 
     d_radius(i) = pow((3.0 / (4.0 * MY_PI)) * (d_rmass(i) / density), 1.0 / 3.0);
     d_outer_radius(i) = pow((3.0 / (4.0 * MY_PI)) *
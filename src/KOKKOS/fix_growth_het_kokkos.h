@@ -75,7 +75,8 @@ class FixGrowthHETKokkos: public FixGrowthHET {
     typename AT::t_float_2d d_conc;
     typename AT::t_float_2d d_reac;
     typename AT::t_float_2d d_dens;
-    typename AT::t_float_3d d_growth;
+    typename AT::t_float_2d d_growth;
+    typename AT::t_float_2d d_eps_rate;
 
     typename AT::t_x_array d_x;
     typename AT::t_float_1d d_rmass;
@@ -108,7 +109,8 @@ class FixGrowthHETKokkos: public FixGrowthHET {
   typename AT::t_float_2d d_conc;
   typename AT::t_float_2d d_reac;
   typename AT::t_float_2d d_dens;
-  typename AT::t_float_3d d_growth;
+  typename AT::t_float_2d d_growth;
+  typename AT::t_float_2d d_eps_rate;
 
   typename AT::t_x_array d_x;
   typename AT::t_float_1d d_rmass;
@@ -0,0 +1,96 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+
+FixStyle(nve/bacillus/kk,FixNVEBacillusKokkos<LMPDeviceType>)
+FixStyle(nve/bacillus/kk/device,FixNVEBacillusKokkos<LMPDeviceType>)
+FixStyle(nve/bacillus/kk/host,FixNVEBacillusKokkos<LMPHostType>)
+
+#else
+
+#ifndef LMP_FIX_NVE_BACILLUS_KOKKOS_H
+#define LMP_FIX_NVE_BACILLUS_KOKKOS_H
+
+#include "fix_nve_bacillus.h"
+#include "kokkos_type.h"
+
+namespace LAMMPS_NS {
+
+struct FixNVEBacillusInitialTag {};
+struct FixNVEBacillusFinalTag {};
+
+template<class DeviceType>
+class FixNVEBacillusKokkos : public FixNVEBacillus {
+ public:
+  FixNVEBacillusKokkos(class LAMMPS *, int, char **);
+  ~FixNVEBacillusKokkos() {}
+  void init();
+  void initial_integrate(int);
+  void final_integrate();
+
+  struct Functor
+  {
+    int groupbit;
+    double dtf;
+    double dtv;
+    double dtq;
+
+    typedef ArrayTypes<DeviceType> AT;
+    typename AT::t_x_array x;
+    typename AT::t_v_array v;
+    typename AT::t_f_array_const f;
+    typename AT::t_v_array angmom;
+    typename AT::t_f_array_const torque;
+    typename AT::t_float_1d rmass;
+    typename AT::t_int_1d mask;
+    typename AT::t_float_2d quat;
+    typename AT::t_float_2d inertia;
+
+    Functor(FixNVEBacillusKokkos *ptr);
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(FixNVEBacillusInitialTag, int) const;
+    KOKKOS_INLINE_FUNCTION
+    void operator()(FixNVEBacillusFinalTag, int) const;
+  };
+
+ private:
+  typedef ArrayTypes<DeviceType> AT;
+  typename AT::t_x_array x;
+  typename AT::t_v_array v;
+  typename AT::t_f_array_const f;
+  typename AT::t_v_array angmom;
+  typename AT::t_f_array_const torque;
+  typename AT::t_float_1d rmass;
+  typename AT::t_int_1d mask;
+  typename AT::t_float_2d quat;
+  typename AT::t_float_2d inertia;
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Fix nve/bacillus requires atom style bacillus
+
+Self-explanatory.
+
+E: Fix nve/bacillus requires bacilli
+
+This fix can only be used for particles that are bacilli.
+
+*/
@@ -0,0 +1,186 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "fix_nve_bacillus_limit_kokkos.h"
+#include "atom_masks.h"
+#include "atom_kokkos.h"
+#include "atom_vec_bacillus_kokkos.h"
+#include "math_extra_kokkos.h"
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+/* ---------------------------------------------------------------------- */
+
+template<class DeviceType>
+FixNVEBacillusLimitKokkos<DeviceType>::FixNVEBacillusLimitKokkos(LAMMPS *lmp, int narg, char **arg) :
+  FixNVEBacillusLimit(lmp, narg, arg)
+{
+  kokkosable = 1;
+  atomKK = (AtomKokkos *) atom;
+  execution_space = ExecutionSpaceFromDevice<DeviceType>::space;
+
+  datamask_read = X_MASK | V_MASK | F_MASK | MASK_MASK | RMASS_MASK | ANGMOM_MASK | TORQUE_MASK | BACILLUS_MASK;
+  datamask_modify = X_MASK | V_MASK | ANGMOM_MASK;
+}
+
+/* ---------------------------------------------------------------------- */
+
+template<class DeviceType>
+void FixNVEBacillusLimitKokkos<DeviceType>::initial_integrate(int /*vflag*/)
+{
+  atomKK->sync(execution_space,datamask_read);
+  atomKK->modified(execution_space,datamask_modify);
+
+  AtomVecBacillusKokkos *avecKK = (AtomVecBacillusKokkos *) atom->avec;
+  avecKK->sync_bonus(execution_space);
+  avecKK->modified_bonus(execution_space);
+
+  x = atomKK->k_x.view<DeviceType>();
+  v = atomKK->k_v.view<DeviceType>();
+  f = atomKK->k_f.view<DeviceType>();
+  angmom = atomKK->k_angmom.view<DeviceType>();
+  torque = atomKK->k_torque.view<DeviceType>();
+  rmass = atomKK->k_rmass.view<DeviceType>();
+  mask = atomKK->k_mask.view<DeviceType>();
+  quat = avecKK->k_quat.view<DeviceType>();
+  inertia = avecKK->k_inertia.view<DeviceType>();
+  int nlocal = atomKK->nlocal;
+  if (igroup == atomKK->firstgroup) nlocal = atomKK->nfirst;
+
+  // set timestep here since dt may have changed or come via rRESPA
+
+  dtq = 0.5 * dtv;
+
+  int nlimit = 0;
+  Functor functor(this);
+  Kokkos::parallel_reduce(Kokkos::RangePolicy<DeviceType, FixNVEBacillusLimitInitialTag>(0, nlocal), functor, nlimit);
+  ncount += nlimit;
+}
+
+/* ---------------------------------------------------------------------- */
+
+template<class DeviceType>
+void FixNVEBacillusLimitKokkos<DeviceType>::final_integrate()
+{
+  atomKK->sync(execution_space,V_MASK | F_MASK | MASK_MASK | RMASS_MASK | ANGMOM_MASK | TORQUE_MASK);
+  atomKK->modified(execution_space,V_MASK | ANGMOM_MASK);
+
+  v = atomKK->k_v.view<DeviceType>();
+  f = atomKK->k_f.view<DeviceType>();
+  angmom = atomKK->k_angmom.view<DeviceType>();
+  torque = atomKK->k_torque.view<DeviceType>();
+  rmass = atomKK->k_rmass.view<DeviceType>();
+  mask = atomKK->k_mask.view<DeviceType>();
+  int nlocal = atomKK->nlocal;
+  if (igroup == atomKK->firstgroup) nlocal = atomKK->nfirst;
+
+  int nlimit = 0;
+  Functor functor(this);
+  Kokkos::parallel_reduce(Kokkos::RangePolicy<DeviceType, FixNVEBacillusLimitFinalTag>(0, nlocal), functor, nlimit);
+  ncount += nlimit;
+}
+
+/* ---------------------------------------------------------------------- */
+
+template<class DeviceType>
+FixNVEBacillusLimitKokkos<DeviceType>::Functor::Functor(FixNVEBacillusLimitKokkos<DeviceType> *ptr):
+  groupbit(ptr->groupbit), dtf(ptr->dtf), dtv(ptr->dtv), dtq(ptr->dtq),
+  vlimitsq(ptr->vlimitsq), x(ptr->x), v(ptr->v), f(ptr->f),
+  angmom(ptr->angmom), torque(ptr->torque), rmass(ptr->rmass),
+  mask(ptr->mask), quat(ptr->quat), inertia(ptr->inertia) {}
+
+/* ---------------------------------------------------------------------- */
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void FixNVEBacillusLimitKokkos<DeviceType>::Functor::limit(int i, int &nlimit) const
+{
+  const double vsq = v(i,0)*v(i,0) + v(i,1)*v(i,1) + v(i,2)*v(i,2);
+  if (vsq > vlimitsq) {
+    nlimit++;
+    const double scale = sqrt(vlimitsq/vsq);
+    v(i,0) *= scale;
+    v(i,1) *= scale;
+    v(i,2) *= scale;
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void FixNVEBacillusLimitKokkos<DeviceType>::Functor::operator()(FixNVEBacillusLimitInitialTag, int i, int &nlimit) const
+{
+  if (mask[i] & groupbit) {
+    const double dtfm = dtf / rmass[i];
+    v(i,0) += dtfm * f(i,0);
+    v(i,1) += dtfm * f(i,1);
+    v(i,2) += dtfm * f(i,2);
+    limit(i,nlimit);
+
+    x(i,0) += dtv * v(i,0);
+    x(i,1) += dtv * v(i,1);
+    x(i,2) += dtv * v(i,2);
+
+    // update angular momentum by 1/2 step
+
+    angmom(i,0) += dtf * torque(i,0);
+    angmom(i,1) += dtf * torque(i,1);
+    angmom(i,2) += dtf * torque(i,2);
+
+    // compute omega at 1/2 step from angmom at 1/2 step and current q
+    // update quaternion a full step via Richardson iteration
+
+    double q[4] = {quat(i,0),quat(i,1),quat(i,2),quat(i,3)};
+    const double m[3] = {angmom(i,0),angmom(i,1),angmom(i,2)};
+    const double moments[3] = {inertia(i,0),inertia(i,1),inertia(i,2)};
+    double omega[3];
+
+    MathExtraKokkos::mq_to_omega(m,q,moments,omega);
+    MathExtraKokkos::richardson(q,m,omega,moments,dtq);
+
+    quat(i,0) = q[0];
+    quat(i,1) = q[1];
+    quat(i,2) = q[2];
+    quat(i,3) = q[3];
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void FixNVEBacillusLimitKokkos<DeviceType>::Functor::operator()(FixNVEBacillusLimitFinalTag, int i, int &nlimit) const
+{
+  if (mask[i] & groupbit) {
+    const double dtfm = dtf / rmass[i];
+    v(i,0) += dtfm * f(i,0);
+    v(i,1) += dtfm * f(i,1);
+    v(i,2) += dtfm * f(i,2);
+    limit(i,nlimit);
+
+    angmom(i,0) += dtf * torque(i,0);
+    angmom(i,1) += dtf * torque(i,1);
+    angmom(i,2) += dtf * torque(i,2);
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+namespace LAMMPS_NS {
+template class FixNVEBacillusLimitKokkos<LMPDeviceType>;
+#ifdef LMP_KOKKOS_GPU
+template class FixNVEBacillusLimitKokkos<LMPHostType>;
+#endif
+}
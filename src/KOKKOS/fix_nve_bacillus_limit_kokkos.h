@@ -0,0 +1,98 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+
+FixStyle(nve/bacillus/limit/kk,FixNVEBacillusLimitKokkos<LMPDeviceType>)
+FixStyle(nve/bacillus/limit/kk/device,FixNVEBacillusLimitKokkos<LMPDeviceType>)
+FixStyle(nve/bacillus/limit/kk/host,FixNVEBacillusLimitKokkos<LMPHostType>)
+
+#else
+
+#ifndef LMP_FIX_NVE_BACILLUS_LIMIT_KOKKOS_H
+#define LMP_FIX_NVE_BACILLUS_LIMIT_KOKKOS_H
+
+#include "fix_nve_bacillus_limit.h"
+#include "kokkos_type.h"
+
+namespace LAMMPS_NS {
+
+struct FixNVEBacillusLimitInitialTag {};
+struct FixNVEBacillusLimitFinalTag {};
+
+template<class DeviceType>
+class FixNVEBacillusLimitKokkos : public FixNVEBacillusLimit {
+ public:
+  FixNVEBacillusLimitKokkos(class LAMMPS *, int, char **);
+  ~FixNVEBacillusLimitKokkos() {}
+  void initial_integrate(int);
+  void final_integrate();
+
+  struct Functor
+  {
+    int groupbit;
+    double dtf;
+    double dtv;
+    double dtq;
+    double vlimitsq;
+
+    typedef ArrayTypes<DeviceType> AT;
+    typename AT::t_x_array x;
+    typename AT::t_v_array v;
+    typename AT::t_f_array_const f;
+    typename AT::t_v_array angmom;
+    typename AT::t_f_array_const torque;
+    typename AT::t_float_1d rmass;
+    typename AT::t_int_1d mask;
+    typename AT::t_float_2d quat;
+    typename AT::t_float_2d inertia;
+
+    Functor(FixNVEBacillusLimitKokkos *ptr);
+
+    // the reduced value is the number of limited velocities
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()(FixNVEBacillusLimitInitialTag, int, int &) const;
+    KOKKOS_INLINE_FUNCTION
+    void operator()(FixNVEBacillusLimitFinalTag, int, int &) const;
+    KOKKOS_INLINE_FUNCTION
+    void limit(int, int &) const;
+  };
+
+ private:
+  typedef ArrayTypes<DeviceType> AT;
+  typename AT::t_x_array x;
+  typename AT::t_v_array v;
+  typename AT::t_f_array_const f;
+  typename AT::t_v_array angmom;
+  typename AT::t_f_array_const torque;
+  typename AT::t_float_1d rmass;
+  typename AT::t_int_1d mask;
+  typename AT::t_float_2d quat;
+  typename AT::t_float_2d inertia;
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Illegal ... command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.  You can use -echo screen as a
+command-line option when running LAMMPS to see the offending line.
+
+*/
@@ -17,6 +17,8 @@
 #include "atom_masks.h"
 #include "atom_kokkos.h"
 #include "error.h"
+#include "force.h"
+#include "update.h"
 
 using namespace LAMMPS_NS;
 using namespace FixConst;
@@ -33,6 +35,27 @@ FixNVELimitKokkos<DeviceType>::FixNVELimitKokkos(LAMMPS *lmp, int narg, char **a
 
   datamask_read = X_MASK | V_MASK | F_MASK | MASK_MASK | RMASS_MASK | TYPE_MASK;
   datamask_modify = X_MASK | V_MASK;
+
+  xlimit = utils::numeric(FLERR,arg[3],false,lmp);
+}
+
+/* ---------------------------------------------------------------------- */
+
+template<class DeviceType>
+void FixNVELimitKokkos<DeviceType>::init()
+{
+  FixNVELimit::init();
+  reset_dt();
+}
+
+/* ---------------------------------------------------------------------- */
+
+template<class DeviceType>
+void FixNVELimitKokkos<DeviceType>::reset_dt()
+{
+  dtv = update->dt;
+  dtf = 0.5 * update->dt * force->ftm2v;
+  vlimitsq = (xlimit/dtv) * (xlimit/dtv);
 }
 
 /* ----------------------------------------------------------------------
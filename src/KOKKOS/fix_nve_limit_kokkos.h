@@ -37,8 +37,10 @@ class FixNVELimitKokkos : public FixNVELimit {
  public:
   FixNVELimitKokkos(class LAMMPS *, int, char **);
   ~FixNVELimitKokkos() {}
+  void init();
   void initial_integrate(int);
   void final_integrate();
+  void reset_dt();
   double compute_scalar();
 
   struct Functor
@@ -70,6 +72,9 @@ class FixNVELimitKokkos : public FixNVELimit {
   };
   
  private:
+  double dtv,dtf;              // FixNVELimit keeps its copies private
+  double xlimit,vlimitsq;
+
   typedef ArrayTypes<DeviceType> AT;
   typename AT::t_x_array x;
   typename AT::t_v_array v;
@@ -39,6 +39,7 @@ GridKokkos::~GridKokkos()
   memoryKK->destroy_kokkos(k_dens, dens);
   memoryKK->destroy_kokkos(k_boundary, boundary);
   memoryKK->destroy_kokkos(k_growth, growth);
+  memoryKK->destroy_kokkos(k_eps_rate, eps_rate);
 }
 
 /* ---------------------------------------------------------------------- */
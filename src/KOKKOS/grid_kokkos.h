@@ -28,7 +28,8 @@ class GridKokkos : public Grid {
   DAT::tdual_float_2d k_diff_coeff;
   DAT::tdual_float_2d k_dens;
   DAT::tdual_int_2d k_boundary;
-  DAT::tdual_float_3d k_growth;
+  DAT::tdual_float_2d k_growth;
+  DAT::tdual_float_2d k_eps_rate;
 
   GridKokkos(class LAMMPS *);
   ~GridKokkos();
@@ -23,6 +23,8 @@
 #include "kokkos.h"
 #include "force.h"
 
+#include <cstring>
+
 using namespace LAMMPS_NS;
 
 /* ---------------------------------------------------------------------- */
@@ -37,6 +39,7 @@ GridVecChemostatKokkos::GridVecChemostatKokkos(LAMMPS *lmp) : GridVecKokkos(lmp)
   dens = NULL;
   boundary = NULL;
   growth = NULL;
+  eps_rate = NULL;
   grid->chemostat_flag = 1;
 }
 
@@ -46,6 +49,9 @@ void GridVecChemostatKokkos::init()
 {
   GridVec::init();
 
+  if (grid->nghost > 1)
+    error->all(FLERR, "Grid style nufeb/chemostat/kk requires a ghost depth of 1");
+
   size_forward = grid->nsubs;
   size_exchange = grid->nsubs;
 }
@@ -68,9 +74,11 @@ void GridVecChemostatKokkos::grow(int n)
     memoryKK->grow_kokkos(gridKK->k_diff_coeff, gridKK->diff_coeff, grid->nsubs, n, "nufeb/chemostat:diff_coeff");
     memoryKK->grow_kokkos(gridKK->k_dens, gridKK->dens, group->ngroup, n, "nufeb/chemostat:dens");
     memoryKK->grow_kokkos(gridKK->k_boundary, gridKK->boundary, grid->nsubs, 6, "nufeb/chemostat:boundary");
-    memoryKK->grow_kokkos(gridKK->k_growth, gridKK->growth, group->ngroup, n, 2, "nufeb/chemostat:grow");
+    memoryKK->grow_kokkos(gridKK->k_growth, gridKK->growth, group->ngroup, n, "nufeb/chemostat:growth");
+    memoryKK->grow_kokkos(gridKK->k_eps_rate, gridKK->eps_rate, group->ngroup, n, "nufeb/chemostat:eps_rate");
     nmax = n;
     grid->nmax = nmax;
+    grid->pitch = nmax;
 
     mask = gridKK->mask;
     d_mask = gridKK->k_mask.d_view;
@@ -96,6 +104,9 @@ void GridVecChemostatKokkos::grow(int n)
     growth = gridKK->growth;
     d_growth = gridKK->k_growth.d_view;
     h_growth = gridKK->k_growth.h_view;
+    eps_rate = gridKK->eps_rate;
+    d_eps_rate = gridKK->k_eps_rate.d_view;
+    h_eps_rate = gridKK->k_eps_rate.h_view;
 
     sync(Host, ALL_MASK);
   }
@@ -284,7 +295,7 @@ void GridVecChemostatKokkos::set(int narg, char **arg)
 {
   sync(Host, GMASK_MASK);
 
-  if (narg != 7) error->all(FLERR, "Invalid grid_modify set command");
+  if (narg < 6) error->all(FLERR, "Invalid grid_modify set command");
   int isub = grid->find(arg[1]);
   if (isub < 0) error->all(FLERR,"Cannot find substrate name");
 
@@ -310,8 +321,20 @@ void GridVecChemostatKokkos::set(int narg, char **arg)
   double domain = utils::numeric(FLERR,arg[5],true,lmp);
   if (domain < 0) error->all(FLERR, "Illegal initial substrate concentration");
 
-  bulk[isub] = utils::numeric(FLERR,arg[6],true,lmp);
-  if (bulk[isub] < 0) error->all(FLERR, "Illegal initial bulk concentration");
+  bulk[isub] = domain;
+  int iarg = 6;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg], "bulk") == 0) {
+      if (iarg+2 > narg) error->all(FLERR, "Illegal grid_modify command");
+      bulk[isub] = utils::numeric(FLERR, arg[iarg+1], true, lmp);
+      if (bulk[isub] < 0) error->all(FLERR, "Illegal initial bulk concentration");
+      iarg += 2;
+    } else if (strcmp(arg[iarg], "mw") == 0) {
+      error->all(FLERR, "Grid style nufeb/chemostat/kk does not support mw keyword");
+    } else {
+      error->all(FLERR, "Illegal grid_modify command");
+    }
+  }
 
   set_grid(isub, domain, bulk[isub]);
 
@@ -351,6 +374,7 @@ void GridVecChemostatKokkos::sync(ExecutionSpace space, unsigned int mask)
     if (mask & DENS_MASK) gridKK->k_dens.sync<LMPDeviceType>();
     if (mask & DIFF_COEFF_MASK) gridKK->k_diff_coeff.sync<LMPDeviceType>();
     if (mask & GROWTH_MASK) gridKK->k_growth.sync<LMPDeviceType>();
+    if (mask & GROWTH_MASK) gridKK->k_eps_rate.sync<LMPDeviceType>();
     if (mask & BULK_MASK) gridKK->k_bulk.sync<LMPDeviceType>();
     if (mask & BOUNDARY_MASK) gridKK->k_boundary.sync<LMPDeviceType>();
   } else {
@@ -360,6 +384,7 @@ void GridVecChemostatKokkos::sync(ExecutionSpace space, unsigned int mask)
     if (mask & DIFF_COEFF_MASK) gridKK->k_diff_coeff.sync<LMPHostType>();
     if (mask & DENS_MASK) gridKK->k_dens.sync<LMPHostType>();
     if (mask & GROWTH_MASK) gridKK->k_growth.sync<LMPHostType>();
+    if (mask & GROWTH_MASK) gridKK->k_eps_rate.sync<LMPHostType>();
     if (mask & BULK_MASK) gridKK->k_bulk.sync<LMPHostType>();
     if (mask & BOUNDARY_MASK) gridKK->k_boundary.sync<LMPHostType>();
   }
@@ -376,6 +401,7 @@ void GridVecChemostatKokkos::modified(ExecutionSpace space, unsigned int mask)
     if (mask & DIFF_COEFF_MASK) gridKK->k_diff_coeff.modify<LMPDeviceType>();
     if (mask & DENS_MASK) gridKK->k_dens.modify<LMPDeviceType>();
     if (mask & GROWTH_MASK) gridKK->k_growth.modify<LMPDeviceType>();
+    if (mask & GROWTH_MASK) gridKK->k_eps_rate.modify<LMPDeviceType>();
     if (mask & BULK_MASK) gridKK->k_bulk.modify<LMPDeviceType>();
     if (mask & BOUNDARY_MASK) gridKK->k_boundary.modify<LMPDeviceType>();
   } else {
@@ -385,6 +411,7 @@ void GridVecChemostatKokkos::modified(ExecutionSpace space, unsigned int mask)
     if (mask & DIFF_COEFF_MASK) gridKK->k_diff_coeff.modify<LMPHostType>();
     if (mask & DENS_MASK) gridKK->k_dens.modify<LMPHostType>();
     if (mask & GROWTH_MASK) gridKK->k_growth.modify<LMPHostType>();
+    if (mask & GROWTH_MASK) gridKK->k_eps_rate.modify<LMPHostType>();
     if (mask & BULK_MASK) gridKK->k_bulk.modify<LMPHostType>();
     if (mask & BOUNDARY_MASK) gridKK->k_boundary.modify<LMPHostType>();
   }
@@ -404,7 +431,9 @@ void GridVecChemostatKokkos::sync_overlapping_device(ExecutionSpace space, unsig
     if ((mask & DENS_MASK) && gridKK->k_dens.need_sync<LMPDeviceType>())
       perform_async_copy<DAT::tdual_float_2d>(gridKK->k_dens, space);
     if ((mask & GROWTH_MASK) && gridKK->k_growth.need_sync<LMPDeviceType>())
-      perform_async_copy<DAT::tdual_float_3d>(gridKK->k_growth, space);
+      perform_async_copy<DAT::tdual_float_2d>(gridKK->k_growth, space);
+    if ((mask & GROWTH_MASK) && gridKK->k_eps_rate.need_sync<LMPDeviceType>())
+      perform_async_copy<DAT::tdual_float_2d>(gridKK->k_eps_rate, space);
     if ((mask & BULK_MASK) && gridKK->k_bulk.need_sync<LMPDeviceType>())
       perform_async_copy<DAT::tdual_float_1d>(gridKK->k_bulk, space);
     if ((mask & BOUNDARY_MASK) && gridKK->k_boundary.need_sync<LMPDeviceType>())
@@ -421,7 +450,9 @@ void GridVecChemostatKokkos::sync_overlapping_device(ExecutionSpace space, unsig
     if ((mask & DENS_MASK) && gridKK->k_dens.need_sync<LMPHostType>())
       perform_async_copy<DAT::tdual_float_2d>(gridKK->k_dens, space);
     if ((mask & GROWTH_MASK) && gridKK->k_growth.need_sync<LMPHostType>())
-      perform_async_copy<DAT::tdual_float_3d>(gridKK->k_growth, space);
+      perform_async_copy<DAT::tdual_float_2d>(gridKK->k_growth, space);
+    if ((mask & GROWTH_MASK) && gridKK->k_eps_rate.need_sync<LMPHostType>())
+      perform_async_copy<DAT::tdual_float_2d>(gridKK->k_eps_rate, space);
     if ((mask & BULK_MASK) && gridKK->k_bulk.need_sync<LMPHostType>())
       perform_async_copy<DAT::tdual_float_1d>(gridKK->k_bulk, space);
     if ((mask & BOUNDARY_MASK) && gridKK->k_boundary.need_sync<LMPHostType>())
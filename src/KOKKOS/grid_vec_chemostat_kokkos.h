@@ -58,7 +58,8 @@ class GridVecChemostatKokkos : public GridVecKokkos {
   double **dens;    // density
   double **diff_coeff; // diffusion coeff
   int **boundary;   // boundary conditions (-x, +x, -y, +y, -z, +z)
-  double ***growth; // growth rate
+  double **growth;  // specific growth rate
+  double **eps_rate; // specific EPS production rate
 
   DAT::t_int_1d d_mask;
   HAT::t_int_1d h_mask;
@@ -74,8 +75,10 @@ class GridVecChemostatKokkos : public GridVecKokkos {
   HAT::t_float_2d h_dens;
   DAT::t_int_2d d_boundary;
   HAT::t_int_2d h_boundary;
-  DAT::t_float_3d d_growth;
-  HAT::t_float_3d h_growth;
+  DAT::t_float_2d d_growth;
+  HAT::t_float_2d h_growth;
+  DAT::t_float_2d d_eps_rate;
+  HAT::t_float_2d h_eps_rate;
 
 };
 
@@ -1,7 +1,8 @@
+// clang-format off
 /* -*- c++ -*- ----------------------------------------------------------
    LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
-   http://lammps.sandia.gov, Sandia National Laboratories
-   Steve Plimpton, sjplimp@sandia.gov
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
 
    Copyright (2003) Sandia Corporation.  Under the terms of Contract
    DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
@@ -15,21 +16,25 @@
 #define LMP_LMPTYPE_KOKKOS_H
 
 #include "pointers.h"
+#include "lmptype.h"
 
 #include <Kokkos_Core.hpp>
 #include <Kokkos_DualView.hpp>
-#include <impl/Kokkos_Timer.hpp>
+#include <Kokkos_Timer.hpp>
 #include <Kokkos_Vectorization.hpp>
 #include <Kokkos_ScatterView.hpp>
+#include <Kokkos_UnorderedMap.hpp>
 
-enum{FULL=1u,HALFTHREAD=2u,HALF=4u};
+constexpr int FULL = 1;
+constexpr int HALFTHREAD = 2;
+constexpr int HALF = 4;
 
 #if defined(KOKKOS_ENABLE_CXX11)
 #undef ISFINITE
 #define ISFINITE(x) std::isfinite(x)
 #endif
 
-#if defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_HIP)
+#if defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_HIP) || defined(KOKKOS_ENABLE_SYCL) || defined(KOKKOS_ENABLE_OPENMPTARGET)
 #define LMP_KOKKOS_GPU
 #endif
 
@@ -40,10 +45,12 @@ enum{FULL=1u,HALFTHREAD=2u,HALF=4u};
 #endif
 
 #define MAX_TYPES_STACKPARAMS 12
-#define NeighClusterSize 8
+static constexpr LAMMPS_NS::bigint LMP_KOKKOS_AV_DELTA = 10;
 
 namespace Kokkos {
-  using NoInit = ViewAllocateWithoutInitializing;
+  static auto NoInit = [](std::string const& label) {
+    return Kokkos::view_alloc(Kokkos::WithoutInitializing, label);
+  };
 }
 
   struct lmp_float3 {
@@ -190,6 +197,15 @@ public:
 #endif
 };
 
+// Helpers for readability
+
+using KKScatterSum = Kokkos::Experimental::ScatterSum;
+using KKScatterDuplicated = Kokkos::Experimental::ScatterDuplicated;
+using KKScatterNonDuplicated = Kokkos::Experimental::ScatterNonDuplicated;
+
+template<typename DataType, typename Layout, typename Device, typename... Args>
+using KKScatterView = Kokkos::Experimental::ScatterView<DataType, Layout, Device, Args...>;
+
 
 // set ExecutionSpace stuct with variable "space"
 
@@ -206,13 +222,21 @@ template<>
 struct ExecutionSpaceFromDevice<Kokkos::Cuda> {
   static const LAMMPS_NS::ExecutionSpace space = LAMMPS_NS::Device;
 };
-#endif
-
-#if defined(KOKKOS_ENABLE_HIP)
+#elif defined(KOKKOS_ENABLE_HIP)
 template<>
 struct ExecutionSpaceFromDevice<Kokkos::Experimental::HIP> {
   static const LAMMPS_NS::ExecutionSpace space = LAMMPS_NS::Device;
 };
+#elif defined(KOKKOS_ENABLE_SYCL)
+template<>
+struct ExecutionSpaceFromDevice<Kokkos::Experimental::SYCL> {
+  static const LAMMPS_NS::ExecutionSpace space = LAMMPS_NS::Device;
+};
+#elif defined(KOKKOS_ENABLE_OPENMPTARGET)
+template<>
+struct ExecutionSpaceFromDevice<Kokkos::Experimental::OpenMPTarget> {
+  static const LAMMPS_NS::ExecutionSpace space = LAMMPS_NS::Device;
+};
 #endif
 
 // set host pinned space
@@ -220,14 +244,24 @@ struct ExecutionSpaceFromDevice<Kokkos::Experimental::HIP> {
 typedef Kokkos::CudaHostPinnedSpace LMPPinnedHostType;
 #elif defined(KOKKOS_ENABLE_HIP)
 typedef Kokkos::Experimental::HIPHostPinnedSpace LMPPinnedHostType;
+#elif defined(KOKKOS_ENABLE_SYCL)
+typedef Kokkos::Experimental::SYCLHostUSMSpace LMPPinnedHostType;
+#elif defined(KOKKOS_ENABLE_OPENMPTARGET)
+typedef Kokkos::Serial LMPPinnedHostType;
+#else
+typedef LMPHostType LMPPinnedHostType;
 #endif
 
-// create simple LMPDeviceSpace typedef for non HIP or CUDA specific
+// create simple LMPDeviceSpace typedef for non CUDA-, HIP-, or SYCL-specific
 // behaviour
 #if defined(KOKKOS_ENABLE_CUDA)
 typedef Kokkos::Cuda LMPDeviceSpace;
 #elif defined(KOKKOS_ENABLE_HIP)
 typedef Kokkos::Experimental::HIP LMPDeviceSpace;
+#elif defined(KOKKOS_ENABLE_SYCL)
+typedef Kokkos::Experimental::SYCL LMPDeviceSpace;
+#elif defined(KOKKOS_ENABLE_OPENMPTARGET)
+typedef Kokkos::Experimental::OpenMPTarget LMPDeviceSpace;
 #endif
 
 
@@ -251,18 +285,29 @@ struct AtomicDup {
   using value = Kokkos::Experimental::ScatterNonAtomic;
 };
 
+template<int NEIGHFLAG, class DeviceType>
+using AtomicDup_v = typename AtomicDup<NEIGHFLAG, DeviceType>::value;
+
 #ifdef KOKKOS_ENABLE_CUDA
 template<>
 struct AtomicDup<HALFTHREAD,Kokkos::Cuda> {
   using value = Kokkos::Experimental::ScatterAtomic;
 };
-#endif
-
-#ifdef KOKKOS_ENABLE_HIP
+#elif defined(KOKKOS_ENABLE_HIP)
 template<>
 struct AtomicDup<HALFTHREAD,Kokkos::Experimental::HIP> {
   using value = Kokkos::Experimental::ScatterAtomic;
 };
+#elif defined(KOKKOS_ENABLE_SYCL)
+template<>
+struct AtomicDup<HALFTHREAD,Kokkos::Experimental::SYCL> {
+  using value = Kokkos::Experimental::ScatterAtomic;
+};
+#elif defined(KOKKOS_ENABLE_OPENMPTARGET)
+template<>
+struct AtomicDup<HALFTHREAD,Kokkos::Experimental::OpenMPTarget> {
+  using value = Kokkos::Experimental::ScatterAtomic;
+};
 #endif
 
 #ifdef LMP_KOKKOS_USE_ATOMICS
@@ -291,6 +336,9 @@ struct NeedDup {
   using value = Kokkos::Experimental::ScatterNonDuplicated;
 };
 
+template<int NEIGHFLAG, class DeviceType>
+using NeedDup_v = typename NeedDup<NEIGHFLAG,DeviceType>::value;
+
 #ifndef LMP_KOKKOS_USE_ATOMICS
 
 #ifdef KOKKOS_ENABLE_OPENMP
@@ -371,32 +419,24 @@ struct s_EV_FLOAT {
   s_EV_FLOAT() {
     evdwl = 0;
     ecoul = 0;
-    v[0] = 0; v[1] = 0; v[2] = 0;
-    v[3] = 0; v[4] = 0; v[5] = 0;
+    for (int i = 0; i < 6; ++i)
+      v[i] = 0;
   }
 
   KOKKOS_INLINE_FUNCTION
   void operator+=(const s_EV_FLOAT &rhs) {
     evdwl += rhs.evdwl;
     ecoul += rhs.ecoul;
-    v[0] += rhs.v[0];
-    v[1] += rhs.v[1];
-    v[2] += rhs.v[2];
-    v[3] += rhs.v[3];
-    v[4] += rhs.v[4];
-    v[5] += rhs.v[5];
+    for (int i = 0; i < 6; ++i)
+      v[i] += rhs.v[i];
   }
 
   KOKKOS_INLINE_FUNCTION
   void operator+=(const volatile s_EV_FLOAT &rhs) volatile {
     evdwl += rhs.evdwl;
     ecoul += rhs.ecoul;
-    v[0] += rhs.v[0];
-    v[1] += rhs.v[1];
-    v[2] += rhs.v[2];
-    v[3] += rhs.v[3];
-    v[4] += rhs.v[4];
-    v[5] += rhs.v[5];
+    for (int i = 0; i < 6; ++i)
+      v[i] += rhs.v[i];
   }
 };
 typedef struct s_EV_FLOAT EV_FLOAT;
@@ -405,58 +445,35 @@ struct s_EV_FLOAT_REAX {
   E_FLOAT evdwl;
   E_FLOAT ecoul;
   E_FLOAT v[6];
-  E_FLOAT ereax[10];
+  E_FLOAT ereax[9];
   KOKKOS_INLINE_FUNCTION
   s_EV_FLOAT_REAX() {
     evdwl = 0;
     ecoul = 0;
-    v[0] = 0; v[1] = 0; v[2] = 0;
-    v[3] = 0; v[4] = 0; v[5] = 0;
-    ereax[0] = 0; ereax[1] = 0; ereax[2] = 0;
-    ereax[3] = 0; ereax[4] = 0; ereax[5] = 0;
-    ereax[6] = 0; ereax[7] = 0; ereax[8] = 0;
+    for (int i = 0; i < 6; ++i)
+      v[i] = 0;
+    for (int i = 0; i < 9; ++i)
+      ereax[i] = 0;
   }
 
   KOKKOS_INLINE_FUNCTION
   void operator+=(const s_EV_FLOAT_REAX &rhs) {
     evdwl += rhs.evdwl;
     ecoul += rhs.ecoul;
-    v[0] += rhs.v[0];
-    v[1] += rhs.v[1];
-    v[2] += rhs.v[2];
-    v[3] += rhs.v[3];
-    v[4] += rhs.v[4];
-    v[5] += rhs.v[5];
-    ereax[0] += rhs.ereax[0];
-    ereax[1] += rhs.ereax[1];
-    ereax[2] += rhs.ereax[2];
-    ereax[3] += rhs.ereax[3];
-    ereax[4] += rhs.ereax[4];
-    ereax[5] += rhs.ereax[5];
-    ereax[6] += rhs.ereax[6];
-    ereax[7] += rhs.ereax[7];
-    ereax[8] += rhs.ereax[8];
+    for (int i = 0; i < 6; ++i)
+      v[i] += rhs.v[i];
+    for (int i = 0; i < 9; ++i)
+      ereax[i] += rhs.ereax[i];
   }
 
   KOKKOS_INLINE_FUNCTION
   void operator+=(const volatile s_EV_FLOAT_REAX &rhs) volatile {
     evdwl += rhs.evdwl;
     ecoul += rhs.ecoul;
-    v[0] += rhs.v[0];
-    v[1] += rhs.v[1];
-    v[2] += rhs.v[2];
-    v[3] += rhs.v[3];
-    v[4] += rhs.v[4];
-    v[5] += rhs.v[5];
-    ereax[0] += rhs.ereax[0];
-    ereax[1] += rhs.ereax[1];
-    ereax[2] += rhs.ereax[2];
-    ereax[3] += rhs.ereax[3];
-    ereax[4] += rhs.ereax[4];
-    ereax[5] += rhs.ereax[5];
-    ereax[6] += rhs.ereax[6];
-    ereax[7] += rhs.ereax[7];
-    ereax[8] += rhs.ereax[8];
+    for (int i = 0; i < 6; ++i)
+      v[i] += rhs.v[i];
+    for (int i = 0; i < 9; ++i)
+      ereax[i] += rhs.ereax[i];
   }
 };
 typedef struct s_EV_FLOAT_REAX EV_FLOAT_REAX;
@@ -468,44 +485,64 @@ struct s_FEV_FLOAT {
   E_FLOAT v[6];
   KOKKOS_INLINE_FUNCTION
   s_FEV_FLOAT() {
-    f[0] = 0; f[1] = 0; f[2] = 0;
     evdwl = 0;
     ecoul = 0;
-    v[0] = 0; v[1] = 0; v[2] = 0;
-    v[3] = 0; v[4] = 0; v[5] = 0;
+    for (int i = 0; i < 6; ++i)
+      v[i] = 0;
+    for (int i = 0; i < 3; ++i)
+      f[i] = 0;
   }
 
   KOKKOS_INLINE_FUNCTION
   void operator+=(const s_FEV_FLOAT &rhs) {
-    f[0] += rhs.f[0];
-    f[1] += rhs.f[1];
-    f[2] += rhs.f[2];
     evdwl += rhs.evdwl;
     ecoul += rhs.ecoul;
-    v[0] += rhs.v[0];
-    v[1] += rhs.v[1];
-    v[2] += rhs.v[2];
-    v[3] += rhs.v[3];
-    v[4] += rhs.v[4];
-    v[5] += rhs.v[5];
+    for (int i = 0; i < 6; ++i)
+      v[i] += rhs.v[i];
+    for (int i = 0; i < 3; ++i)
+      f[i] += rhs.f[i];
   }
 
   KOKKOS_INLINE_FUNCTION
   void operator+=(const volatile s_FEV_FLOAT &rhs) volatile {
-    f[0] += rhs.f[0];
-    f[1] += rhs.f[1];
-    f[2] += rhs.f[2];
     evdwl += rhs.evdwl;
     ecoul += rhs.ecoul;
+    for (int i = 0; i < 6; ++i)
+      v[i] += rhs.v[i];
+    for (int i = 0; i < 3; ++i)
+      f[i] += rhs.f[i];
+  }
+};
+typedef struct s_FEV_FLOAT FEV_FLOAT;
+
+struct alignas(2*sizeof(F_FLOAT)) s_FLOAT2 {
+  F_FLOAT v[2];
+
+  KOKKOS_INLINE_FUNCTION
+  s_FLOAT2() {
+    v[0] = v[1] = 0.0;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  s_FLOAT2(const s_FLOAT2 & rhs) {
+    for (int i = 0; i < 2; i++){
+      v[i] = rhs.v[i];
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator+=(const s_FLOAT2 &rhs) {
+    v[0] += rhs.v[0];
+    v[1] += rhs.v[1];
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  void operator+=(const volatile s_FLOAT2 &rhs) volatile {
     v[0] += rhs.v[0];
     v[1] += rhs.v[1];
-    v[2] += rhs.v[2];
-    v[3] += rhs.v[3];
-    v[4] += rhs.v[4];
-    v[5] += rhs.v[5];
   }
 };
-typedef struct s_FEV_FLOAT FEV_FLOAT;
+typedef struct s_FLOAT2 F_FLOAT2;
 
 #ifndef PREC_POS
 #define PREC_POS PRECISION
@@ -539,6 +576,23 @@ typedef int T_INT;
 
 // LAMMPS types
 
+typedef Kokkos::UnorderedMap<LAMMPS_NS::tagint,int,LMPDeviceType> hash_type;
+typedef hash_type::HostMirror host_hash_type;
+
+struct dual_hash_type {
+  hash_type d_view;
+  host_hash_type h_view;
+
+  template<class DeviceType>
+  KOKKOS_INLINE_FUNCTION
+  std::enable_if_t<(std::is_same<DeviceType,LMPDeviceType>::value || Kokkos::SpaceAccessibility<LMPDeviceType::memory_space,LMPHostType::memory_space>::accessible),hash_type&> view() {return d_view;}
+
+  template<class DeviceType>
+  KOKKOS_INLINE_FUNCTION
+  std::enable_if_t<!(std::is_same<DeviceType,LMPDeviceType>::value || Kokkos::SpaceAccessibility<LMPDeviceType::memory_space,LMPHostType::memory_space>::accessible),host_hash_type&> view() {return h_view;}
+
+};
+
 template <class DeviceType>
 struct ArrayTypes;
 
@@ -729,6 +783,14 @@ typedef tdual_ffloat_1d::t_dev_um t_ffloat_1d_um;
 typedef tdual_ffloat_1d::t_dev_const_um t_ffloat_1d_const_um;
 typedef tdual_ffloat_1d::t_dev_const_randomread t_ffloat_1d_randomread;
 
+// 1d F_FLOAT2 array n
+typedef Kokkos::DualView<F_FLOAT*[2], Kokkos::LayoutRight, LMPDeviceType> tdual_ffloat2_1d;
+typedef tdual_ffloat2_1d::t_dev t_ffloat2_1d;
+typedef tdual_ffloat2_1d::t_dev_const t_ffloat2_1d_const;
+typedef tdual_ffloat2_1d::t_dev_um t_ffloat2_1d_um;
+typedef tdual_ffloat2_1d::t_dev_const_um t_ffloat2_1d_const_um;
+typedef tdual_ffloat2_1d::t_dev_const_randomread t_ffloat2_1d_randomread;
+
 //2d F_FLOAT array n*m
 
 typedef Kokkos::DualView<F_FLOAT**, Kokkos::LayoutRight, LMPDeviceType> tdual_ffloat_2d;
@@ -766,6 +828,36 @@ typedef tdual_virial_array::t_dev_um t_virial_array_um;
 typedef tdual_virial_array::t_dev_const_um t_virial_array_const_um;
 typedef tdual_virial_array::t_dev_const_randomread t_virial_array_randomread;
 
+// Spin Types
+
+//3d SP_FLOAT array n*4
+#ifdef LMP_KOKKOS_NO_LEGACY
+typedef Kokkos::DualView<X_FLOAT*[4], Kokkos::LayoutLeft, LMPDeviceType> tdual_float_1d_4;
+#else
+typedef Kokkos::DualView<X_FLOAT*[4], Kokkos::LayoutRight, LMPDeviceType> tdual_float_1d_4;
+#endif
+typedef tdual_float_1d_4::t_dev t_sp_array;
+typedef tdual_float_1d_4::t_dev_const t_sp_array_const;
+typedef tdual_float_1d_4::t_dev_um t_sp_array_um;
+typedef tdual_float_1d_4::t_dev_const_um t_sp_array_const_um;
+typedef tdual_float_1d_4::t_dev_const_randomread t_sp_array_randomread;
+
+//3d FM_FLOAT array n*3
+
+typedef tdual_f_array::t_dev t_fm_array;
+typedef tdual_f_array::t_dev_const t_fm_array_const;
+typedef tdual_f_array::t_dev_um t_fm_array_um;
+typedef tdual_f_array::t_dev_const_um t_fm_array_const_um;
+typedef tdual_f_array::t_dev_const_randomread t_fm_array_randomread;
+
+//3d FML_FLOAT array n*3
+
+typedef tdual_f_array::t_dev t_fm_long_array;
+typedef tdual_f_array::t_dev_const t_fm_long_array_const;
+typedef tdual_f_array::t_dev_um t_fm_long_array_um;
+typedef tdual_f_array::t_dev_const_um t_fm_long_array_const_um;
+typedef tdual_f_array::t_dev_const_randomread t_fm_long_array_randomread;
+
 //Energy Types
 //1d E_FLOAT array n
 
@@ -803,6 +895,13 @@ typedef tdual_neighbors_2d::t_dev_um t_neighbors_2d_um;
 typedef tdual_neighbors_2d::t_dev_const_um t_neighbors_2d_const_um;
 typedef tdual_neighbors_2d::t_dev_const_randomread t_neighbors_2d_randomread;
 
+typedef Kokkos::DualView<int**, Kokkos::LayoutRight, LMPDeviceType> tdual_neighbors_2d_lr;
+typedef tdual_neighbors_2d_lr::t_dev t_neighbors_2d_lr;
+typedef tdual_neighbors_2d_lr::t_dev_const t_neighbors_2d_const_lr;
+typedef tdual_neighbors_2d_lr::t_dev_um t_neighbors_2d_um_lr;
+typedef tdual_neighbors_2d_lr::t_dev_const_um t_neighbors_2d_const_um_lr;
+typedef tdual_neighbors_2d_lr::t_dev_const_randomread t_neighbors_2d_randomread_lr;
+
 };
 
 #ifdef LMP_KOKKOS_GPU
@@ -977,6 +1076,14 @@ typedef tdual_ffloat_1d::t_host_um t_ffloat_1d_um;
 typedef tdual_ffloat_1d::t_host_const_um t_ffloat_1d_const_um;
 typedef tdual_ffloat_1d::t_host_const_randomread t_ffloat_1d_randomread;
 
+// 1d F_FLOAT2 array n
+typedef Kokkos::DualView<F_FLOAT*[2], Kokkos::LayoutRight, LMPDeviceType> tdual_ffloat2_1d;
+typedef tdual_ffloat2_1d::t_host t_ffloat2_1d;
+typedef tdual_ffloat2_1d::t_host_const t_ffloat2_1d_const;
+typedef tdual_ffloat2_1d::t_host_um t_ffloat2_1d_um;
+typedef tdual_ffloat2_1d::t_host_const_um t_ffloat2_1d_const_um;
+typedef tdual_ffloat2_1d::t_host_const_randomread t_ffloat2_1d_randomread;
+
 //2d F_FLOAT array n*m
 typedef Kokkos::DualView<F_FLOAT**, Kokkos::LayoutRight, LMPDeviceType> tdual_ffloat_2d;
 typedef tdual_ffloat_2d::t_host t_ffloat_2d;
@@ -1010,6 +1117,33 @@ typedef tdual_virial_array::t_host_um t_virial_array_um;
 typedef tdual_virial_array::t_host_const_um t_virial_array_const_um;
 typedef tdual_virial_array::t_host_const_randomread t_virial_array_randomread;
 
+// Spin types
+
+//2d X_FLOAT array n*4
+#ifdef LMP_KOKKOS_NO_LEGACY
+typedef Kokkos::DualView<X_FLOAT*[4], Kokkos::LayoutLeft, LMPDeviceType> tdual_float_1d_4;
+#else
+typedef Kokkos::DualView<X_FLOAT*[4], Kokkos::LayoutRight, LMPDeviceType> tdual_float_1d_4;
+#endif
+typedef tdual_float_1d_4::t_host t_sp_array;
+typedef tdual_float_1d_4::t_host_const t_sp_array_const;
+typedef tdual_float_1d_4::t_host_um t_sp_array_um;
+typedef tdual_float_1d_4::t_host_const_um t_sp_array_const_um;
+typedef tdual_float_1d_4::t_host_const_randomread t_sp_array_randomread;
+
+//2d F_FLOAT array n*3
+typedef tdual_f_array::t_host t_fm_array;
+typedef tdual_f_array::t_host_const t_fm_array_const;
+typedef tdual_f_array::t_host_um t_fm_array_um;
+typedef tdual_f_array::t_host_const_um t_fm_array_const_um;
+typedef tdual_f_array::t_host_const_randomread t_fm_array_randomread;
+
+//2d F_FLOAT array n*3
+typedef tdual_f_array::t_host t_fm_long_array;
+typedef tdual_f_array::t_host_const t_fm_long_array_const;
+typedef tdual_f_array::t_host_um t_fm_long_array_um;
+typedef tdual_f_array::t_host_const_um t_fm_long_array_const_um;
+typedef tdual_f_array::t_host_const_randomread t_fm_long_array_randomread;
 
 
 //Energy Types
@@ -1045,6 +1179,13 @@ typedef tdual_neighbors_2d::t_host_um t_neighbors_2d_um;
 typedef tdual_neighbors_2d::t_host_const_um t_neighbors_2d_const_um;
 typedef tdual_neighbors_2d::t_host_const_randomread t_neighbors_2d_randomread;
 
+typedef Kokkos::DualView<int**, Kokkos::LayoutRight, LMPDeviceType> tdual_neighbors_2d_lr;
+typedef tdual_neighbors_2d_lr::t_host t_neighbors_2d_lr;
+typedef tdual_neighbors_2d_lr::t_host_const t_neighbors_2d_const_lr;
+typedef tdual_neighbors_2d_lr::t_host_um t_neighbors_2d_um_lr;
+typedef tdual_neighbors_2d_lr::t_host_const_um t_neighbors_2d_const_um_lr;
+typedef tdual_neighbors_2d_lr::t_host_const_randomread t_neighbors_2d_randomread_lr;
+
 };
 #endif
 //default LAMMPS Types
@@ -1083,28 +1224,48 @@ void memset_kokkos (ViewType &view) {
 
 struct params_lj_coul {
   KOKKOS_INLINE_FUNCTION
-  params_lj_coul(){cut_ljsq=0;cut_coulsq=0;lj1=0;lj2=0;lj3=0;lj4=0;offset=0;};
+  params_lj_coul() {cut_ljsq=0;cut_coulsq=0;lj1=0;lj2=0;lj3=0;lj4=0;offset=0;};
   KOKKOS_INLINE_FUNCTION
-  params_lj_coul(int /*i*/){cut_ljsq=0;cut_coulsq=0;lj1=0;lj2=0;lj3=0;lj4=0;offset=0;};
+  params_lj_coul(int /*i*/) {cut_ljsq=0;cut_coulsq=0;lj1=0;lj2=0;lj3=0;lj4=0;offset=0;};
   F_FLOAT cut_ljsq,cut_coulsq,lj1,lj2,lj3,lj4,offset;
 };
 
+// ReaxFF
+
+struct alignas(4 * sizeof(int)) reax_int4 {
+  int i0, i1, i2, i3;
+};
+
 // Pair SNAP
 
+#define SNAP_KOKKOS_REAL double
+#define SNAP_KOKKOS_HOST_VECLEN 1
+
+#ifdef LMP_KOKKOS_GPU
+#define SNAP_KOKKOS_DEVICE_VECLEN 32
+#else
+#define SNAP_KOKKOS_DEVICE_VECLEN 1
+#endif
+
+
+// intentional: SNAreal/complex gets reused beyond SNAP
 typedef double SNAreal;
 
 //typedef struct { SNAreal re, im; } SNAcomplex;
-template <typename real>
-struct alignas(2*sizeof(real)) SNAComplex
+template <typename real_type_>
+struct alignas(2*sizeof(real_type_)) SNAComplex
 {
-  real re,im;
+  using real_type = real_type_;
+  using complex = SNAComplex<real_type>;
+  real_type re,im;
 
-  SNAComplex() = default;
+  KOKKOS_FORCEINLINE_FUNCTION SNAComplex()
+   : re(static_cast<real_type>(0.)), im(static_cast<real_type>(0.)) { ; }
 
-  KOKKOS_FORCEINLINE_FUNCTION SNAComplex(real re)
-   : re(re), im(static_cast<real>(0.)) { ; }
+  KOKKOS_FORCEINLINE_FUNCTION SNAComplex(real_type re)
+   : re(re), im(static_cast<real_type>(0.)) { ; }
 
-  KOKKOS_FORCEINLINE_FUNCTION SNAComplex(real re, real im)
+  KOKKOS_FORCEINLINE_FUNCTION SNAComplex(real_type re, real_type im)
    : re(re), im(im) { ; }
 
   KOKKOS_FORCEINLINE_FUNCTION SNAComplex(const SNAComplex& other)
@@ -1132,40 +1293,54 @@ struct alignas(2*sizeof(real)) SNAComplex
     return *this;
   }
 
-};
-
-template <typename real>
-KOKKOS_FORCEINLINE_FUNCTION SNAComplex<real> operator*(const real& r, const SNAComplex<real>& self) {
-  return SNAComplex<real>(r*self.re, r*self.im);
-}
+  KOKKOS_INLINE_FUNCTION
+  static constexpr complex zero() { return complex(static_cast<real_type>(0.), static_cast<real_type>(0.)); }
 
-typedef SNAComplex<SNAreal> SNAcomplex;
+  KOKKOS_INLINE_FUNCTION
+  static constexpr complex one() { return complex(static_cast<real_type>(1.), static_cast<real_type>(0.)); }
 
-// Cayley-Klein pack
-// Can guarantee it's aligned to 2 complex
-struct alignas(32) CayleyKleinPack {
+  KOKKOS_INLINE_FUNCTION
+  const complex conj() const { return complex(re, -im); }
 
-  SNAcomplex a, b;
-  SNAcomplex da[3], db[3];
-  SNAreal sfac;
-  SNAreal dsfacu[3];
+  KOKKOS_INLINE_FUNCTION
+  const real_type real_part_product(const complex &cm2) { return re * cm2.re - im * cm2.im; }
 
+  KOKKOS_INLINE_FUNCTION
+  const real_type real_part_product(const real_type &r) const { return re * r; }
 };
 
+template <typename real_type>
+KOKKOS_FORCEINLINE_FUNCTION SNAComplex<real_type> operator*(const real_type& r, const SNAComplex<real_type>& self) {
+  return SNAComplex<real_type>(r*self.re, r*self.im);
+}
+
+template <typename real_type>
+KOKKOS_FORCEINLINE_FUNCTION SNAComplex<real_type> operator*(const SNAComplex<real_type>& self, const real_type& r) {
+  return SNAComplex<real_type>(r*self.re, r*self.im);
+}
+
+template <typename real_type>
+KOKKOS_FORCEINLINE_FUNCTION SNAComplex<real_type> operator*(const SNAComplex<real_type>& self, const SNAComplex<real_type>& cm2) {
+  return SNAComplex<real_type>(self.re*cm2.re - self.im*cm2.im, self.re*cm2.im + self.im*cm2.re);
+}
+
+typedef SNAComplex<SNAreal> SNAcomplex;
 
 #if defined(KOKKOS_ENABLE_CXX11)
 #undef ISFINITE
 #define ISFINITE(x) std::isfinite(x)
 #endif
 
-#ifdef LMP_KOKKOS_GPU
-#define LAMMPS_LAMBDA [=] __device__
+#define LAMMPS_LAMBDA KOKKOS_LAMBDA
+
+#if defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_HIP)
+#define LAMMPS_DEVICE_FUNCTION __device__
 #else
-#define LAMMPS_LAMBDA [=]
+#define LAMMPS_DEVICE_FUNCTION
 #endif
 
 #ifdef LMP_KOKKOS_GPU
-#if defined(__CUDA_ARCH__) || defined(__HIP_DEVICE_COMPILE__)
+#if defined(__CUDA_ARCH__) || defined(__HIP_DEVICE_COMPILE__) || defined(__SYCL_DEVICE_ONLY__)
 #define LMP_KK_DEVICE_COMPILE
 #endif
 #endif
@@ -0,0 +1,252 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   device versions of the MathExtra routines used by rigid body styles
+------------------------------------------------------------------------- */
+
+#ifndef LMP_MATH_EXTRA_KOKKOS_H
+#define LMP_MATH_EXTRA_KOKKOS_H
+
+#include "kokkos_type.h"
+#include <cmath>
+
+namespace MathExtraKokkos {
+
+/* ----------------------------------------------------------------------
+   c = a x b
+------------------------------------------------------------------------- */
+
+KOKKOS_INLINE_FUNCTION
+void cross3(const double *a, const double *b, double *c)
+{
+  c[0] = a[1]*b[2] - a[2]*b[1];
+  c[1] = a[2]*b[0] - a[0]*b[2];
+  c[2] = a[0]*b[1] - a[1]*b[0];
+}
+
+/* ----------------------------------------------------------------------
+   dot product of 2 vectors
+------------------------------------------------------------------------- */
+
+KOKKOS_INLINE_FUNCTION
+double dot3(const double *a, const double *b)
+{
+  return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+}
+
+/* ----------------------------------------------------------------------
+   matrix times vector
+------------------------------------------------------------------------- */
+
+KOKKOS_INLINE_FUNCTION
+void matvec(const double m[3][3], const double *v, double *ans)
+{
+  ans[0] = m[0][0]*v[0] + m[0][1]*v[1] + m[0][2]*v[2];
+  ans[1] = m[1][0]*v[0] + m[1][1]*v[1] + m[1][2]*v[2];
+  ans[2] = m[2][0]*v[0] + m[2][1]*v[1] + m[2][2]*v[2];
+}
+
+/* ----------------------------------------------------------------------
+   transposed matrix times vector
+------------------------------------------------------------------------- */
+
+KOKKOS_INLINE_FUNCTION
+void transpose_matvec(const double m[3][3], const double *v, double *ans)
+{
+  ans[0] = m[0][0]*v[0] + m[1][0]*v[1] + m[2][0]*v[2];
+  ans[1] = m[0][1]*v[0] + m[1][1]*v[1] + m[2][1]*v[2];
+  ans[2] = m[0][2]*v[0] + m[1][2]*v[1] + m[2][2]*v[2];
+}
+
+/* ----------------------------------------------------------------------
+   normalize a quaternion
+------------------------------------------------------------------------- */
+
+KOKKOS_INLINE_FUNCTION
+void qnormalize(double *q)
+{
+  double norm = 1.0 / sqrt(q[0]*q[0] + q[1]*q[1] + q[2]*q[2] + q[3]*q[3]);
+  q[0] *= norm;
+  q[1] *= norm;
+  q[2] *= norm;
+  q[3] *= norm;
+}
+
+/* ----------------------------------------------------------------------
+   vector-quaternion multiply: c = a*b, where a = (0,a)
+------------------------------------------------------------------------- */
+
+KOKKOS_INLINE_FUNCTION
+void vecquat(const double *a, const double *b, double *c)
+{
+  c[0] = -a[0]*b[1] - a[1]*b[2] - a[2]*b[3];
+  c[1] = b[0]*a[0] + a[1]*b[3] - a[2]*b[2];
+  c[2] = b[0]*a[1] + a[2]*b[1] - a[0]*b[3];
+  c[3] = b[0]*a[2] + a[0]*b[2] - a[1]*b[1];
+}
+
+/* ----------------------------------------------------------------------
+   compute rotation matrix from quaternion
+   quat = [w i j k]
+------------------------------------------------------------------------- */
+
+KOKKOS_INLINE_FUNCTION
+void quat_to_mat(const double *quat, double mat[3][3])
+{
+  double w2 = quat[0]*quat[0];
+  double i2 = quat[1]*quat[1];
+  double j2 = quat[2]*quat[2];
+  double k2 = quat[3]*quat[3];
+  double twoij = 2.0*quat[1]*quat[2];
+  double twoik = 2.0*quat[1]*quat[3];
+  double twojk = 2.0*quat[2]*quat[3];
+  double twoiw = 2.0*quat[1]*quat[0];
+  double twojw = 2.0*quat[2]*quat[0];
+  double twokw = 2.0*quat[3]*quat[0];
+
+  mat[0][0] = w2+i2-j2-k2;
+  mat[0][1] = twoij-twokw;
+  mat[0][2] = twojw+twoik;
+
+  mat[1][0] = twoij+twokw;
+  mat[1][1] = w2-i2+j2-k2;
+  mat[1][2] = twojk-twoiw;
+
+  mat[2][0] = twoik-twojw;
+  mat[2][1] = twojk+twoiw;
+  mat[2][2] = w2-i2-j2+k2;
+}
+
+/* ----------------------------------------------------------------------
+   compute space-frame ex,ey,ez from current quaternion q
+------------------------------------------------------------------------- */
+
+KOKKOS_INLINE_FUNCTION
+void q_to_exyz(const double *q, double *ex, double *ey, double *ez)
+{
+  ex[0] = q[0]*q[0] + q[1]*q[1] - q[2]*q[2] - q[3]*q[3];
+  ex[1] = 2.0 * (q[1]*q[2] + q[0]*q[3]);
+  ex[2] = 2.0 * (q[1]*q[3] - q[0]*q[2]);
+
+  ey[0] = 2.0 * (q[1]*q[2] - q[0]*q[3]);
+  ey[1] = q[0]*q[0] - q[1]*q[1] + q[2]*q[2] - q[3]*q[3];
+  ey[2] = 2.0 * (q[2]*q[3] + q[0]*q[1]);
+
+  ez[0] = 2.0 * (q[1]*q[3] + q[0]*q[2]);
+  ez[1] = 2.0 * (q[2]*q[3] - q[0]*q[1]);
+  ez[2] = q[0]*q[0] - q[1]*q[1] - q[2]*q[2] + q[3]*q[3];
+}
+
+/* ----------------------------------------------------------------------
+   compute omega from angular momentum, both in space frame
+   only know Idiag so need to do M = Iw in body frame
+   set wbody component to 0.0 if inertia component is 0.0
+------------------------------------------------------------------------- */
+
+KOKKOS_INLINE_FUNCTION
+void angmom_to_omega(const double *m, const double *ex, const double *ey,
+                     const double *ez, const double *idiag, double *w)
+{
+  double wbody[3];
+
+  if (idiag[0] == 0.0) wbody[0] = 0.0;
+  else wbody[0] = (m[0]*ex[0] + m[1]*ex[1] + m[2]*ex[2]) / idiag[0];
+  if (idiag[1] == 0.0) wbody[1] = 0.0;
+  else wbody[1] = (m[0]*ey[0] + m[1]*ey[1] + m[2]*ey[2]) / idiag[1];
+  if (idiag[2] == 0.0) wbody[2] = 0.0;
+  else wbody[2] = (m[0]*ez[0] + m[1]*ez[1] + m[2]*ez[2]) / idiag[2];
+
+  w[0] = wbody[0]*ex[0] + wbody[1]*ey[0] + wbody[2]*ez[0];
+  w[1] = wbody[0]*ex[1] + wbody[1]*ey[1] + wbody[2]*ez[1];
+  w[2] = wbody[0]*ex[2] + wbody[1]*ey[2] + wbody[2]*ez[2];
+}
+
+/* ----------------------------------------------------------------------
+   compute omega from angular momentum and quaternion
+------------------------------------------------------------------------- */
+
+KOKKOS_INLINE_FUNCTION
+void mq_to_omega(const double *m, const double *q, const double *moments,
+                 double *w)
+{
+  double wbody[3];
+  double rot[3][3];
+
+  quat_to_mat(q,rot);
+  transpose_matvec(rot,m,wbody);
+  if (moments[0] == 0.0) wbody[0] = 0.0;
+  else wbody[0] /= moments[0];
+  if (moments[1] == 0.0) wbody[1] = 0.0;
+  else wbody[1] /= moments[1];
+  if (moments[2] == 0.0) wbody[2] = 0.0;
+  else wbody[2] /= moments[2];
+  matvec(rot,wbody,w);
+}
+
+/* ----------------------------------------------------------------------
+   Richardson iteration to update quaternion from angular momentum
+   return new normalized quaternion q
+   also returns updated omega at 1/2 step
+------------------------------------------------------------------------- */
+
+KOKKOS_INLINE_FUNCTION
+void richardson(double *q, const double *m, double *w, const double *moments,
+                double dtq)
+{
+  // full update from dq/dt = 1/2 w q
+
+  double wq[4];
+  vecquat(w,q,wq);
+
+  double qfull[4];
+  qfull[0] = q[0] + dtq * wq[0];
+  qfull[1] = q[1] + dtq * wq[1];
+  qfull[2] = q[2] + dtq * wq[2];
+  qfull[3] = q[3] + dtq * wq[3];
+  qnormalize(qfull);
+
+  // 1st half update from dq/dt = 1/2 w q
+
+  double qhalf[4];
+  qhalf[0] = q[0] + 0.5*dtq * wq[0];
+  qhalf[1] = q[1] + 0.5*dtq * wq[1];
+  qhalf[2] = q[2] + 0.5*dtq * wq[2];
+  qhalf[3] = q[3] + 0.5*dtq * wq[3];
+  qnormalize(qhalf);
+
+  // re-compute omega at 1/2 step from m at 1/2 step and q at 1/2 step
+
+  mq_to_omega(m,qhalf,moments,w);
+  vecquat(w,qhalf,wq);
+
+  // 2nd half update from dq/dt = 1/2 w q
+
+  qhalf[0] += 0.5*dtq * wq[0];
+  qhalf[1] += 0.5*dtq * wq[1];
+  qhalf[2] += 0.5*dtq * wq[2];
+  qhalf[3] += 0.5*dtq * wq[3];
+  qnormalize(qhalf);
+
+  // corrected Richardson update
+
+  q[0] = 2.0*qhalf[0] - qfull[0];
+  q[1] = 2.0*qhalf[1] - qfull[1];
+  q[2] = 2.0*qhalf[2] - qfull[2];
+  q[3] = 2.0*qhalf[3] - qfull[3];
+  qnormalize(q);
+}
+
+}
+
+#endif
@@ -95,6 +95,21 @@ void NufebRunKokkos::init()
   update->integrate_style = new char[13];
   strcpy(update->integrate_style, "verlet/nufeb\0");
 
+  if (diffdt_auto)
+    error->all(FLERR,"Run_style nufeb/kk does not support diffdt auto");
+  if (anderson_depth)
+    error->all(FLERR,"Run_style nufeb/kk does not support diffaccel");
+  if (warm_order)
+    error->all(FLERR,"Run_style nufeb/kk does not support warmstart");
+  if (biodt_flag)
+    error->all(FLERR,"Run_style nufeb/kk does not support biodt adaptive");
+  if (relax_flag)
+    error->all(FLERR,"Run_style nufeb/kk does not support relax fire");
+  if (active_flag)
+    error->all(FLERR,"Run_style nufeb/kk does not support pairactive");
+  if (pairconv != PRESSURE)
+    error->all(FLERR,"Run_style nufeb/kk does not support pairconv force");
+
   // allocate space for storing fixes
   fix_diffusion = new FixDiffusionReaction*[modify->nfix];
 
@@ -465,13 +480,6 @@ void NufebRunKokkos::run(int n)
     update->dt = biodt;
     reset_dt();
 
-    // call all fixes implementing post_chemistry_nufeb()
-    if (modify->n_post_chemistry_nufeb) {
-      timer->stamp();
-      modify->post_chemistry_nufeb();
-      timer->stamp(Timer::MODIFY);
-    }
-
     // run reactor module
     t = get_time();
     module_reactor();
@@ -557,9 +565,19 @@ void NufebRunKokkos::module_biology()
   reset_dt();
 
   // call all fixes implementing biology_nufeb()
+  // atom data is synced with the data masks of each fix, as in ModifyKokkos
+  // Kokkos fixes sync the grid themselves, host fixes get all of it
   if (modify->n_biology_nufeb) {
     timer->stamp();
-    modify->biology_nufeb();
+    for (int i = 0; i < modify->nfix; i++) {
+      if (!(modify->fmask[i] & FixConst::BIOLOGY_NUFEB)) continue;
+      Fix *fix = modify->fix[i];
+      atomKK->sync(fix->execution_space,fix->datamask_read);
+      if (!fix->kokkosable) gridKK->sync(Host,ALL_MASK);
+      fix->biology_nufeb();
+      atomKK->modified(fix->execution_space,fix->datamask_modify);
+      if (!fix->kokkosable) gridKK->modified(Host,ALL_MASK);
+    }
     timer->stamp(Timer::MODIFY);
   }
 }
@@ -602,9 +620,14 @@ int NufebRunKokkos::module_chemistry()
       timer->stamp(Timer::MODIFY);
     }
 
+    // the residuals are only computed every diffcheck iterations
+    int check = (niter + 1) % diffcheck == 0;
+    if (!check) conv_flag = false;
+
     for (int i = 0; i < nfix_diffusion; i++) {
       if (converge[i]) continue;
       fix_diffusion[i]->compute_final();
+      if (!check) continue;
       double res = fix_diffusion[i]->compute_scalar();
       if (res < difftol) converge[i] = true;
       if (!converge[i]) conv_flag = false;
@@ -643,7 +666,7 @@ double NufebRunKokkos::module_physics()
   int n_post_neighbor = modify->n_post_neighbor;
   int n_pre_force = modify->n_pre_force;
   int n_pre_reverse = modify->n_pre_reverse;
-  int n_post_force = modify->n_post_force;
+  int n_post_force = modify->n_post_force_any;
   int n_end_of_step = modify->n_end_of_step;
 
   update->dt = pairdt;
@@ -654,7 +677,14 @@ double NufebRunKokkos::module_physics()
 
   npair = 0;
   double press = 0.0;
+  int check;
+  vflag_step = vflag;
   do {
+    // convergence is checked every paircheck iterations and on the last one
+
+    check = ((npair + 1) % paircheck == 0) || (pairmax > 0 && npair + 1 >= pairmax);
+    vflag = check ? vflag_step : 0;
+
     // initial time integration
 
     //ktimer.reset();
@@ -804,7 +834,6 @@ double NufebRunKokkos::module_physics()
     if (pair_compute_flag) {
       atomKK->sync(force->pair->execution_space,force->pair->datamask_read);
       atomKK->sync(force->pair->execution_space,~(~force->pair->datamask_read|(F_MASK | ENERGY_MASK | VIRIAL_MASK)));
-      Kokkos::Impl::Timer ktimer;
       force->pair->compute(eflag,vflag);
       atomKK->modified(force->pair->execution_space,force->pair->datamask_modify);
       atomKK->modified(force->pair->execution_space,~(~force->pair->datamask_modify|(F_MASK | ENERGY_MASK | VIRIAL_MASK)));
@@ -885,11 +914,14 @@ double NufebRunKokkos::module_physics()
 
     ++npair;
 
-    press = comp_pressure->compute_scalar() * domain->xprd * domain->yprd * domain->zprd;
-    press += comp_ke->compute_scalar();
-    press /= 3.0 * vol;
-  } while(fabs(press) > pairtol && ((pairmax > 0) ? npair < pairmax : true));
+    if (check) {
+      press = comp_pressure->compute_scalar() * domain->xprd * domain->yprd * domain->zprd;
+      press += comp_ke->compute_scalar();
+      press /= 3.0 * vol;
+    }
+  } while((!check || fabs(press) > pairtol) && ((pairmax > 0) ? npair < pairmax : true));
 
+  vflag = vflag_step;
   return press;
 }
 /* ---------------------------------------------------------------------- */
@@ -0,0 +1,658 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "pair_bacillus_kokkos.h"
+#include "kokkos.h"
+#include "atom_kokkos.h"
+#include "atom_masks.h"
+#include "atom_vec_bacillus_kokkos.h"
+#include "math_extra_kokkos.h"
+#include "memory_kokkos.h"
+#include "force.h"
+#include "neighbor.h"
+#include "neigh_list_kokkos.h"
+#include "neigh_request.h"
+#include "error.h"
+
+using namespace LAMMPS_NS;
+
+#define EPSILON 1e-30
+
+/* ---------------------------------------------------------------------- */
+
+template<class DeviceType>
+PairBacillusKokkos<DeviceType>::PairBacillusKokkos(LAMMPS *lmp) : PairBacillus(lmp)
+{
+  atomKK = (AtomKokkos *) atom;
+  execution_space = ExecutionSpaceFromDevice<DeviceType>::space;
+  datamask_read = X_MASK | V_MASK | F_MASK | TORQUE_MASK | TYPE_MASK | ANGMOM_MASK | RADIUS_MASK | BACILLUS_MASK | ENERGY_MASK | VIRIAL_MASK;
+  datamask_modify = F_MASK | TORQUE_MASK | ENERGY_MASK | VIRIAL_MASK;
+}
+
+/* ---------------------------------------------------------------------- */
+
+template<class DeviceType>
+PairBacillusKokkos<DeviceType>::~PairBacillusKokkos()
+{
+  if (copymode) return;
+}
+
+/* ----------------------------------------------------------------------
+   init specific to this pair style
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PairBacillusKokkos<DeviceType>::init_style()
+{
+  // the parent class reads the bonus data on the host
+
+  atomKK->sync(Host,TYPE_MASK|BACILLUS_MASK);
+
+  PairBacillus::init_style();
+
+  int n = atom->ntypes;
+  k_kn = DAT::tdual_ffloat_2d("pair:k_n",n+1,n+1);
+  k_kna = DAT::tdual_ffloat_2d("pair:k_na",n+1,n+1);
+
+  // adjust neighbor list request for KOKKOS
+
+  neighflag = lmp->kokkos->neighflag;
+  if (neighflag != HALF && neighflag != HALFTHREAD)
+    error->all(FLERR,"Must use half neighbor list with pair bacillus/kk");
+
+  auto request = neighbor->find_request(this);
+  request->set_kokkos_host(std::is_same<DeviceType,LMPHostType>::value &&
+                           !std::is_same<DeviceType,LMPDeviceType>::value);
+  request->set_kokkos_device(std::is_same<DeviceType,LMPDeviceType>::value);
+}
+
+/* ----------------------------------------------------------------------
+   init for one type pair i,j and corresponding j,i
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+double PairBacillusKokkos<DeviceType>::init_one(int i, int j)
+{
+  double cutone = PairBacillus::init_one(i,j);
+
+  k_kn.h_view(i,j) = k_kn.h_view(j,i) = k_n[i][j];
+  k_kna.h_view(i,j) = k_kna.h_view(j,i) = k_na[i][j];
+  k_kn.template modify<LMPHostType>();
+  k_kna.template modify<LMPHostType>();
+
+  return cutone;
+}
+
+/* ---------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PairBacillusKokkos<DeviceType>::compute(int eflag_in, int vflag_in)
+{
+  copymode = 1;
+
+  eflag = eflag_in;
+  vflag = vflag_in;
+
+  ev_init(eflag,vflag,0);
+
+  if (eflag_atom || vflag_atom)
+    error->all(FLERR,"Pair style bacillus/kk does not support per-atom energy or virial");
+
+  atomKK->sync(execution_space,datamask_read);
+  if (eflag || vflag) atomKK->modified(execution_space,datamask_modify);
+  else atomKK->modified(execution_space,F_MASK | TORQUE_MASK);
+
+  k_kn.template sync<DeviceType>();
+  k_kna.template sync<DeviceType>();
+  d_kn = k_kn.template view<DeviceType>();
+  d_kna = k_kna.template view<DeviceType>();
+
+  AtomVecBacillusKokkos *avecKK = (AtomVecBacillusKokkos *) atom->avec;
+  avecKK->sync_bonus(execution_space);
+
+  x = atomKK->k_x.view<DeviceType>();
+  v = atomKK->k_v.view<DeviceType>();
+  angmom = atomKK->k_angmom.view<DeviceType>();
+  f = atomKK->k_f.view<DeviceType>();
+  torque = atomKK->k_torque.view<DeviceType>();
+  type = atomKK->k_type.view<DeviceType>();
+  bacillus = atomKK->k_bacillus.view<DeviceType>();
+  radius = atomKK->k_radius.view<DeviceType>();
+  quat = avecKK->k_quat.view<DeviceType>();
+  inertia = avecKK->k_inertia.view<DeviceType>();
+  pole1 = avecKK->k_pole1.view<DeviceType>();
+  pole2 = avecKK->k_pole2.view<DeviceType>();
+  length = avecKK->k_length.view<DeviceType>();
+  diameter = avecKK->k_diameter.view<DeviceType>();
+  nlocal = atom->nlocal;
+  nall = atom->nlocal + atom->nghost;
+
+  int inum = list->inum;
+  NeighListKokkos<DeviceType>* k_list = static_cast<NeighListKokkos<DeviceType>*>(list);
+  d_numneigh = k_list->d_numneigh;
+  d_neighbors = k_list->d_neighbors;
+  d_ilist = k_list->d_ilist;
+
+  EV_FLOAT ev;
+
+  // newton pair is required by the parent class
+
+  if (neighflag == HALF) {
+    if (evflag)
+      Kokkos::parallel_reduce(Kokkos::RangePolicy<DeviceType, TagPairBacillusCompute<HALF,1>>(0,inum),*this,ev);
+    else
+      Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPairBacillusCompute<HALF,0>>(0,inum),*this);
+  } else { // HALFTHREAD
+    if (evflag)
+      Kokkos::parallel_reduce(Kokkos::RangePolicy<DeviceType, TagPairBacillusCompute<HALFTHREAD,1>>(0,inum),*this,ev);
+    else
+      Kokkos::parallel_for(Kokkos::RangePolicy<DeviceType, TagPairBacillusCompute<HALFTHREAD,0>>(0,inum),*this);
+  }
+
+  if (eflag_global) eng_vdwl += ev.evdwl;
+
+  if (vflag_global) {
+    virial[0] += ev.v[0];
+    virial[1] += ev.v[1];
+    virial[2] += ev.v[2];
+    virial[3] += ev.v[3];
+    virial[4] += ev.v[4];
+    virial[5] += ev.v[5];
+  }
+
+  if (vflag_fdotr) pair_virial_fdotr_compute(this);
+
+  copymode = 0;
+}
+
+/* ----------------------------------------------------------------------
+   same pairwise model as PairBacillus::compute(), with the bonus data
+   read from the per-atom views of the atom style
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+template<int NEIGHFLAG, int EVFLAG>
+KOKKOS_INLINE_FUNCTION
+void PairBacillusKokkos<DeviceType>::operator()(TagPairBacillusCompute<NEIGHFLAG,EVFLAG>, const int ii, EV_FLOAT &ev) const {
+
+  // The f and torque arrays are atomic for Half/Thread neighbor style
+  Kokkos::View<F_FLOAT*[3], typename DAT::t_f_array::array_layout,typename KKDevice<DeviceType>::value,Kokkos::MemoryTraits<AtomicF<NEIGHFLAG>::value> > a_f = f;
+  Kokkos::View<F_FLOAT*[3], typename DAT::t_f_array::array_layout,typename KKDevice<DeviceType>::value,Kokkos::MemoryTraits<AtomicF<NEIGHFLAG>::value> > a_torque = torque;
+
+  const int i = d_ilist[ii];
+  if (bacillus[i] < 0) return;
+
+  const X_FLOAT xtmp = x(i,0);
+  const X_FLOAT ytmp = x(i,1);
+  const X_FLOAT ztmp = x(i,2);
+  const int itype = type[i];
+  const double leni = length[i]/2;
+  const double radi = diameter[i]/2;
+  const int jnum = d_numneigh[i];
+
+  for (int jj = 0; jj < jnum; jj++) {
+    const int j = d_neighbors(i,jj) & NEIGHMASK;
+    if (bacillus[j] < 0) continue;
+
+    const X_FLOAT delx = xtmp - x(j,0);
+    const X_FLOAT dely = ytmp - x(j,1);
+    const X_FLOAT delz = ztmp - x(j,2);
+    const X_FLOAT rsq = delx*delx + dely*dely + delz*delz;
+    const int jtype = type[j];
+    const double lenj = length[j]/2;
+    const double radj = diameter[j]/2;
+
+    // no interaction
+
+    if (sqrt(rsq) > radi+radj+leni+lenj+cutoff) continue;
+
+    double evdwl = 0.0;
+    double fpair,fx,fy,fz;
+    double del[3] = {delx,dely,delz};
+
+    if (leni == 0.0 && lenj == 0.0) {
+
+      // sphere-sphere interaction
+
+      const double rij = sqrt(rsq);
+      const double R = rij - (radi + radj);
+
+      kernel_force_kk(R,itype,jtype,evdwl,fpair);
+
+      fx = delx*fpair/rij;
+      fy = dely*fpair/rij;
+      fz = delz*fpair/rij;
+
+      if (R <= 0) { // in contact
+        const double vr1 = v(i,0) - v(j,0);
+        const double vr2 = v(i,1) - v(j,1);
+        const double vr3 = v(i,2) - v(j,2);
+        const double vnnr = (vr1*delx + vr2*dely + vr3*delz) / rsq;
+        const double vn1 = delx*vnnr;
+        const double vn2 = dely*vnnr;
+        const double vn3 = delz*vnnr;
+        fx += -c_n*vn1 - c_t*(vr1 - vn1);
+        fy += -c_n*vn2 - c_t*(vr2 - vn2);
+        fz += -c_n*vn3 - c_t*(vr3 - vn3);
+      }
+
+      a_f(i,0) += fx;
+      a_f(i,1) += fy;
+      a_f(i,2) += fz;
+      a_f(j,0) -= fx;
+      a_f(j,1) -= fy;
+      a_f(j,2) -= fz;
+
+    } else if (leni == 0.0 || lenj == 0.0) {
+
+      // sphere-rod interaction, ir is the rod and js the sphere
+
+      const int ir = (lenj == 0.0) ? i : j;
+      const int js = (lenj == 0.0) ? j : i;
+      const int irtype = type[ir];
+      const int jstype = type[js];
+      const double contact_dist = radius[ir] + radius[js];
+      const double xs[3] = {x(js,0),x(js,1),x(js,2)};
+      double xi1[3],xi2[3],h[3],d,t;
+
+      pole_coords(ir,xi1,xi2);
+      distance_bt_pt_rod_kk(xs,xi1,xi2,h,d,t);
+
+      if (d > contact_dist + cutoff) continue;
+      if (t < 0 || t > 1) continue;
+
+      del[0] = h[0] - xs[0];
+      del[1] = h[1] - xs[1];
+      del[2] = h[2] - xs[2];
+      const double drsq = del[0]*del[0] + del[1]*del[1] + del[2]*del[2];
+      const double rij = sqrt(drsq);
+      const double R = d - contact_dist;
+
+      kernel_force_kk(R,irtype,jstype,evdwl,fpair);
+
+      fx = del[0]*fpair/rij;
+      fy = del[1]*fpair/rij;
+      fz = del[2]*fpair/rij;
+
+      if (R <= 0) { // in contact
+        double vti[3];
+        total_velocity_kk(ir,h,vti);
+        const double vr1 = vti[0] - v(js,0);
+        const double vr2 = vti[1] - v(js,1);
+        const double vr3 = vti[2] - v(js,2);
+        const double vnnr = (vr1*del[0] + vr2*del[1] + vr3*del[2]) / drsq;
+        const double vn1 = del[0]*vnnr;
+        const double vn2 = del[1]*vnnr;
+        const double vn3 = del[2]*vnnr;
+        fx += -c_n*vn1 - c_t*(vr1 - vn1);
+        fy += -c_n*vn2 - c_t*(vr2 - vn2);
+        fz += -c_n*vn3 - c_t*(vr3 - vn3);
+      }
+
+      const double rx = h[0] - x(ir,0);
+      const double ry = h[1] - x(ir,1);
+      const double rz = h[2] - x(ir,2);
+
+      a_f(ir,0) += fx;
+      a_f(ir,1) += fy;
+      a_f(ir,2) += fz;
+      a_torque(ir,0) += ry*fz - rz*fy;
+      a_torque(ir,1) += rz*fx - rx*fz;
+      a_torque(ir,2) += rx*fy - ry*fx;
+      a_f(js,0) -= fx;
+      a_f(js,1) -= fy;
+      a_f(js,2) -= fz;
+
+    } else {
+
+      // rod-rod interaction, the forces act on j at h2 and on i at h1
+
+      double xi1[3],xi2[3],xj1[3],xj2[3],h1[3],h2[3],t1,t2,r;
+
+      pole_coords(i,xi1,xi2);
+      pole_coords(j,xj1,xj2);
+      const double contact_dist = radi + radj;
+
+      distance_bt_rods_kk(xj1,xj2,xi1,xi2,h2,h1,t2,t1,r);
+
+      fx = fy = fz = 0.0;
+      if (t1 >= 0 && t1 <= 1 && t2 >= 0 && t2 <= 1 &&
+          r < contact_dist + cutoff) {
+        double dx = h2[0] - h1[0];
+        double dy = h2[1] - h1[1];
+        double dz = h2[2] - h1[2];
+        const double R = r - contact_dist;
+
+        kernel_force_kk(R,jtype,itype,evdwl,fpair);
+
+        double fcx = dx*fpair/r;
+        double fcy = dy*fpair/r;
+        double fcz = dz*fpair/r;
+
+        if (R <= 0) {
+
+          // contact forces plus the cohesive force in gross sliding
+
+          double vj[3],vi[3];
+          total_velocity_kk(j,h2,vj);
+          total_velocity_kk(i,h1,vi);
+          const double vr1 = vj[0] - vi[0];
+          const double vr2 = vj[1] - vi[1];
+          const double vr3 = vj[2] - vi[2];
+          const double vnnr = (vr1*dx + vr2*dy + vr3*dz) / (dx*dx + dy*dy + dz*dz);
+          const double vn1 = dx*vnnr;
+          const double vn2 = dy*vnnr;
+          const double vn3 = dz*vnnr;
+          fcx = -c_n*vn1 - c_t*(vr1 - vn1) + mu*fcx;
+          fcy = -c_n*vn2 - c_t*(vr2 - vn2) + mu*fcy;
+          fcz = -c_n*vn3 - c_t*(vr3 - vn3) + mu*fcz;
+        }
+
+        double rjx = h2[0] - x(j,0), rjy = h2[1] - x(j,1), rjz = h2[2] - x(j,2);
+        double rix = h1[0] - x(i,0), riy = h1[1] - x(i,1), riz = h1[2] - x(i,2);
+
+        a_f(j,0) += fcx;
+        a_f(j,1) += fcy;
+        a_f(j,2) += fcz;
+        a_torque(j,0) += rjy*fcz - rjz*fcy;
+        a_torque(j,1) += rjz*fcx - rjx*fcz;
+        a_torque(j,2) += rjx*fcy - rjy*fcx;
+        a_f(i,0) -= fcx;
+        a_f(i,1) -= fcy;
+        a_f(i,2) -= fcz;
+        a_torque(i,0) -= riy*fcz - riz*fcy;
+        a_torque(i,1) -= riz*fcx - rix*fcz;
+        a_torque(i,2) -= rix*fcy - riy*fcx;
+        fx += fcx;
+        fy += fcy;
+        fz += fcz;
+
+        if (R <= 0) {
+
+          // cohesive force rescaled at the contact
+
+          double energy = 0.0;
+          dx = -dx;
+          dy = -dy;
+          dz = -dz;
+          const double rc = sqrt(dx*dx + dy*dy + dz*dz);
+          kernel_force_kk(R,itype,jtype,energy,fpair);
+
+          fcx = dx*fpair/rc;
+          fcy = dy*fpair/rc;
+          fcz = dz*fpair/rc;
+
+          a_f(i,0) += fcx;
+          a_f(i,1) += fcy;
+          a_f(i,2) += fcz;
+          a_torque(i,0) += riy*fcz - riz*fcy;
+          a_torque(i,1) += riz*fcx - rix*fcz;
+          a_torque(i,2) += rix*fcy - riy*fcx;
+          a_f(j,0) -= fcx;
+          a_f(j,1) -= fcy;
+          a_f(j,2) -= fcz;
+          a_torque(j,0) -= rjy*fcz - rjz*fcy;
+          a_torque(j,1) -= rjz*fcx - rjx*fcz;
+          a_torque(j,2) -= rjx*fcy - rjy*fcx;
+          fx += fcx;
+          fy += fcy;
+          fz += fcz;
+        }
+      }
+    }
+
+    if (EVFLAG) ev_tally_xyz(ev,evdwl,fx,fy,fz,del[0],del[1],del[2]);
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+template<class DeviceType>
+template<int NEIGHFLAG, int EVFLAG>
+KOKKOS_INLINE_FUNCTION
+void PairBacillusKokkos<DeviceType>::operator()(TagPairBacillusCompute<NEIGHFLAG,EVFLAG>, const int ii) const {
+  EV_FLOAT ev;
+  this->template operator()<NEIGHFLAG,EVFLAG>(TagPairBacillusCompute<NEIGHFLAG,EVFLAG>(), ii, ev);
+}
+
+/* ----------------------------------------------------------------------
+   tally energy and virial of a pair, newton pair is always on
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PairBacillusKokkos<DeviceType>::ev_tally_xyz(EV_FLOAT &ev, F_FLOAT evdwl,
+                                                  F_FLOAT fx, F_FLOAT fy, F_FLOAT fz,
+                                                  X_FLOAT delx, X_FLOAT dely, X_FLOAT delz) const
+{
+  if (eflag_global) ev.evdwl += evdwl;
+
+  if (vflag_global) {
+    ev.v[0] += delx*fx;
+    ev.v[1] += dely*fy;
+    ev.v[2] += delz*fz;
+    ev.v[3] += delx*fy;
+    ev.v[4] += delx*fz;
+    ev.v[5] += dely*fz;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   harmonic kernel of PairBacillus::kernel_force()
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PairBacillusKokkos<DeviceType>::kernel_force_kk(double R, int itype, int jtype,
+                                                     double &energy, double &fpair) const
+{
+  const double kn = d_kn(itype,jtype);
+  const double kna = d_kna(itype,jtype);
+  const double shift = kna * cutoff;
+  if (R <= 0) {           // deformation occurs
+    fpair = -kn * R - shift;
+    energy += (0.5 * kn * R + shift) * R;
+  } else if (R <= cutoff) {   // not deforming but cohesive ranges overlap
+    fpair = kna * R - shift;
+    energy += (-0.5 * kna * R + shift) * R;
+  } else fpair = 0.0;
+}
+
+/* ----------------------------------------------------------------------
+   space-frame coordinates of the two poles of bacillus i
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PairBacillusKokkos<DeviceType>::pole_coords(int i, double *xp1, double *xp2) const
+{
+  const double q[4] = {quat(i,0),quat(i,1),quat(i,2),quat(i,3)};
+  const double p1[3] = {pole1(i,0),pole1(i,1),pole1(i,2)};
+  const double p2[3] = {pole2(i,0),pole2(i,1),pole2(i,2)};
+  double p[3][3];
+
+  MathExtraKokkos::quat_to_mat(q,p);
+  MathExtraKokkos::matvec(p,p1,xp1);
+  MathExtraKokkos::matvec(p,p2,xp2);
+
+  xp1[0] += x(i,0);
+  xp1[1] += x(i,1);
+  xp1[2] += x(i,2);
+  xp2[0] += x(i,0);
+  xp2[1] += x(i,1);
+  xp2[2] += x(i,2);
+}
+
+/* ----------------------------------------------------------------------
+   velocity of point p of bacillus i: vi = vcm + omega ^ (p - xcm)
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PairBacillusKokkos<DeviceType>::total_velocity_kk(int i, const double *p, double *vi) const
+{
+  const double q[4] = {quat(i,0),quat(i,1),quat(i,2),quat(i,3)};
+  const double m[3] = {angmom(i,0),angmom(i,1),angmom(i,2)};
+  const double idiag[3] = {inertia(i,0),inertia(i,1),inertia(i,2)};
+  double r[3],omega[3],ex[3],ey[3],ez[3];
+
+  r[0] = p[0] - x(i,0);
+  r[1] = p[1] - x(i,1);
+  r[2] = p[2] - x(i,2);
+  MathExtraKokkos::q_to_exyz(q,ex,ey,ez);
+  MathExtraKokkos::angmom_to_omega(m,ex,ey,ez,idiag,omega);
+  vi[0] = omega[1]*r[2] - omega[2]*r[1] + v(i,0);
+  vi[1] = omega[2]*r[0] - omega[0]*r[2] + v(i,1);
+  vi[2] = omega[0]*r[1] - omega[1]*r[0] + v(i,2);
+}
+
+/* ----------------------------------------------------------------------
+   shortest distance between sphere (point) and rod (line segment)
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PairBacillusKokkos<DeviceType>::distance_bt_pt_rod_kk(const double *q,
+  const double *xi1, const double *xi2, double *h, double &d, double &t) const
+{
+  const double vx = xi2[0] - xi1[0];
+  const double vy = xi2[1] - xi1[1];
+  const double vz = xi2[2] - xi1[2];
+
+  const double wx = q[0] - xi1[0];
+  const double wy = q[1] - xi1[1];
+  const double wz = q[2] - xi1[2];
+
+  const double c1 = wx*vx + wy*vy + wz*vz;
+  const double c2 = vx*vx + vy*vy + vz*vz;
+
+  if (c1 <= 0) {
+    t = 0;
+    h[0] = xi1[0];
+    h[1] = xi1[1];
+    h[2] = xi1[2];
+  } else if (c2 <= c1) {
+    t = 1;
+    h[0] = xi2[0];
+    h[1] = xi2[1];
+    h[2] = xi2[2];
+  } else {
+    t = c1 / c2;
+    h[0] = xi1[0] + t * vx;
+    h[1] = xi1[1] + t * vy;
+    h[2] = xi1[2] + t * vz;
+  }
+
+  const double dx = q[0] - h[0];
+  const double dy = q[1] - h[1];
+  const double dz = q[2] - h[2];
+  d = sqrt(dx*dx + dy*dy + dz*dz);
+}
+
+/* ----------------------------------------------------------------------
+   shortest distance between two rods (line segments)
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PairBacillusKokkos<DeviceType>::distance_bt_rods_kk(const double *x1,
+  const double *x2, const double *x3, const double *x4,
+  double *h1, double *h2, double &t1, double &t2, double &r) const
+{
+  const double ux = x2[0] - x1[0];
+  const double uy = x2[1] - x1[1];
+  const double uz = x2[2] - x1[2];
+
+  const double vx = x4[0] - x3[0];
+  const double vy = x4[1] - x3[1];
+  const double vz = x4[2] - x3[2];
+
+  const double wx = x1[0] - x3[0];
+  const double wy = x1[1] - x3[1];
+  const double wz = x1[2] - x3[2];
+
+  const double a = ux*ux + uy*uy + uz*uz;
+  const double b = ux*vx + uy*vy + uz*vz;
+  const double c = vx*vx + vy*vy + vz*vz;
+  const double d = ux*wx + uy*wy + uz*wz;
+  const double e = vx*wx + vy*wy + vz*wz;
+  const double dd = a * c - b * b;
+  double nt1, dt1 = dd;
+  double nt2, dt2 = dd;
+
+  // compute the line parameters of the two closest points
+
+  if (dd < EPSILON) { // the lines are almost parallel
+    nt1 = 0.0;
+    dt1 = 1.0;
+    nt2 = e;
+    dt2 = c;
+  } else {
+    nt1 = (b*e - c*d);
+    nt2 = (a*e - b*d);
+    if (nt1 < 0.0) {
+      nt1 = 0.0;
+      nt2 = e;
+      dt2 = c;
+    } else if (nt1 > dt1) {
+      nt1 = dt1;
+      nt2 = e + b;
+      dt2 = c;
+    }
+  }
+
+  if (nt2 < 0.0) {
+    nt2 = 0.0;
+    if (-d < 0.0)
+      nt1 = 0.0;
+    else if (-d > a)
+      nt1 = dt1;
+    else {
+      nt1 = -d;
+      dt1 = a;
+    }
+  } else if (nt2 > dt2) {
+    nt2 = dt2;
+    if ((-d + b) < 0.0)
+      nt1 = 0;
+    else if ((-d + b) > a)
+      nt1 = dt1;
+    else {
+      nt1 = (-d + b);
+      dt1 = a;
+    }
+  }
+
+  t1 = (fabs(nt1) < EPSILON ? 0.0 : nt1 / dt1);
+  t2 = (fabs(nt2) < EPSILON ? 0.0 : nt2 / dt2);
+
+  const double r1 = wx + t1*ux - t2*vx;
+  const double r2 = wy + t1*uy - t2*vy;
+  const double r3 = wz + t1*uz - t2*vz;
+  r = sqrt(r1*r1 + r2*r2 + r3*r3);
+
+  h1[0] = x1[0] + ux * t1;
+  h1[1] = x1[1] + uy * t1;
+  h1[2] = x1[2] + uz * t1;
+
+  h2[0] = x3[0] + vx * t2;
+  h2[1] = x3[1] + vy * t2;
+  h2[2] = x3[2] + vz * t2;
+}
+
+namespace LAMMPS_NS {
+template class PairBacillusKokkos<LMPDeviceType>;
+#ifdef LMP_KOKKOS_GPU
+template class PairBacillusKokkos<LMPHostType>;
+#endif
+}
@@ -0,0 +1,121 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef PAIR_CLASS
+
+PairStyle(bacillus/kk,PairBacillusKokkos<LMPDeviceType>)
+PairStyle(bacillus/kk/device,PairBacillusKokkos<LMPDeviceType>)
+PairStyle(bacillus/kk/host,PairBacillusKokkos<LMPHostType>)
+
+#else
+
+#ifndef LMP_PAIR_BACILLUS_KOKKOS_H
+#define LMP_PAIR_BACILLUS_KOKKOS_H
+
+#include "pair_bacillus.h"
+#include "pair_kokkos.h"
+#include "kokkos_type.h"
+
+namespace LAMMPS_NS {
+
+template<int NEIGHFLAG, int EVFLAG>
+struct TagPairBacillusCompute {};
+
+template <class DeviceType>
+class PairBacillusKokkos : public PairBacillus {
+ public:
+  typedef DeviceType device_type;
+  typedef ArrayTypes<DeviceType> AT;
+  typedef EV_FLOAT value_type;
+
+  PairBacillusKokkos(class LAMMPS *);
+  virtual ~PairBacillusKokkos();
+  virtual void compute(int, int);
+  void init_style();
+  double init_one(int, int);
+
+  template<int NEIGHFLAG, int EVFLAG>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPairBacillusCompute<NEIGHFLAG,EVFLAG>, const int, EV_FLOAT &ev) const;
+  template<int NEIGHFLAG, int EVFLAG>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPairBacillusCompute<NEIGHFLAG,EVFLAG>, const int) const;
+
+  KOKKOS_INLINE_FUNCTION
+  void ev_tally_xyz(EV_FLOAT &ev, F_FLOAT evdwl,
+                    F_FLOAT fx, F_FLOAT fy, F_FLOAT fz,
+                    X_FLOAT delx, X_FLOAT dely, X_FLOAT delz) const;
+
+ protected:
+  typename AT::t_x_array_randomread x;
+  typename AT::t_v_array_randomread v;
+  typename AT::t_v_array_randomread angmom;
+  typename AT::t_f_array f;
+  typename AT::t_f_array torque;
+  typename AT::t_int_1d_randomread type;
+  typename AT::t_int_1d_randomread bacillus;
+  typename AT::t_float_1d_randomread radius;
+
+  // per-atom bonus data of the bacillus/kk atom style
+
+  typename AT::t_float_2d quat;
+  typename AT::t_float_2d inertia;
+  typename AT::t_float_2d pole1,pole2;
+  typename AT::t_float_1d length,diameter;
+
+  DAT::tdual_ffloat_2d k_kn,k_kna;
+  typename AT::t_ffloat_2d d_kn,d_kna;
+
+  typename AT::t_neighbors_2d d_neighbors;
+  typename AT::t_int_1d_randomread d_ilist;
+  typename AT::t_int_1d_randomread d_numneigh;
+
+  int neighflag;
+  int nlocal,nall,eflag,vflag;
+
+  KOKKOS_INLINE_FUNCTION
+  void kernel_force_kk(double R, int itype, int jtype,
+                       double &energy, double &fpair) const;
+  KOKKOS_INLINE_FUNCTION
+  void pole_coords(int i, double *xp1, double *xp2) const;
+  KOKKOS_INLINE_FUNCTION
+  void total_velocity_kk(int i, const double *p, double *vi) const;
+  KOKKOS_INLINE_FUNCTION
+  void distance_bt_pt_rod_kk(const double *q, const double *xi1,
+                             const double *xi2, double *h,
+                             double &d, double &t) const;
+  KOKKOS_INLINE_FUNCTION
+  void distance_bt_rods_kk(const double *x1, const double *x2,
+                           const double *x3, const double *x4,
+                           double *h1, double *h2,
+                           double &t1, double &t2, double &r) const;
+
+  friend void pair_virial_fdotr_compute<PairBacillusKokkos>(PairBacillusKokkos*);
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Must use half neighbor list with pair bacillus/kk
+
+Self-explanatory.
+
+E: Pair style bacillus/kk does not support per-atom energy or virial
+
+Use pair_style bacillus for per-atom energy or virial computes.
+
+*/
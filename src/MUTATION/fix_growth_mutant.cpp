@@ -85,13 +85,17 @@ void FixGrowthMutant::update_cells()
   double **reac = grid->reac;
   double **dens = grid->dens;
 
-  for (int i = 0; i < grid->ncells; i++) {
-    if (grid->mask[i] & GRID_MASK) {
-      double tmp1 = growth * (conc[isub][i] / (sub_affinity + conc[isub][i])) / (1 + pow((conc[iinh][i] / ic50), nl));
+  const double *monod_sub = grid->monod(isub, sub_affinity, 1);
 
-      reac[isub][i] += -gamma * tmp1 * dens[igroup][i];
-      reac[iinh][i] += 0;
-    }
+  int nocc;
+  const int *occ = grid->occupied(igroup, nocc);
+
+  for (int n = 0; n < nocc; n++) {
+    const int i = occ[n];
+    double tmp1 = growth * monod_sub[i] / (1 + pow((conc[iinh][i] / ic50), nl));
+
+    reac[isub][i] += -gamma * tmp1 * dens[igroup][i];
+    reac[iinh][i] += 0;
   }
 }
 
@@ -101,10 +105,12 @@ void FixGrowthMutant::update_atoms()
 {
   double **conc = grid->conc;
 
+  const double *monod_sub = grid->monod(isub, sub_affinity);
+
   for (int i = 0; i < grid->ncells; i++) {
-    double tmp1 = growth * (conc[isub][i] / (sub_affinity + conc[isub][i])) / (1 + pow ((conc[iinh][i] / ic50),nl));
+    double tmp1 = growth * monod_sub[i] / (1 + pow ((conc[iinh][i] / ic50),nl));
 
-    grid->growth[igroup][i][0] = tmp1;
+    grid->growth[igroup][i] = tmp1;
   }
 
   update_atoms_coccus();
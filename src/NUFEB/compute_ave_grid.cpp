@@ -62,6 +62,8 @@ ComputeAveGrid::ComputeAveGrid(LAMMPS *lmp, int narg, char **arg) :
   } else
     error->all(FLERR,"Unknown keyword in compute nufeb/ave_grid");
 
+  if (gro_flag || den_flag) grid->add_group(igroup);
+
   memory->create(vector,size_vector,"compute:vector");
 }
 
@@ -116,8 +118,9 @@ void ComputeAveGrid::compute_vector()
           sum_cells++;
         }
       } else if (gro_flag) {
-        if (grid->growth[igroup][j][i] > 0) {
-          sum += grid->growth[igroup][j][i];
+        double *field = i ? grid->eps_rate[igroup] : grid->growth[igroup];
+        if (field[j] > 0) {
+          sum += field[j];
           sum_cells++;
         }
       }
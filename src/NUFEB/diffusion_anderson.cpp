@@ -0,0 +1,235 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include <cmath>
+#include "diffusion_anderson.h"
+#include "fix_diffusion_reaction.h"
+#include "grid.h"
+#include "memory.h"
+
+using namespace LAMMPS_NS;
+
+#define THRESHOLD_CONC 1E-20
+
+/* ----------------------------------------------------------------------
+   Anderson acceleration of the diffusion-reaction fixed-point iteration
+   one diffusion iteration is the map g, the unknowns are the
+   concentrations of the GRID_MASK cells of all substrates. the next
+   iterate is g(x) minus the combination of the last m differences of g
+   that best cancels the residual g(x) - x in the least-squares sense
+------------------------------------------------------------------------- */
+
+DiffusionAnderson::DiffusionAnderson(LAMMPS *lmp, FixDiffusionReaction **fixes,
+                                     int nfixes, int m) :
+  Pointers(lmp)
+{
+  nfix = nfixes;
+  mdepth = m;
+  nhist = ihist = 0;
+  nvec = nmax = -1;
+
+  fix = new FixDiffusionReaction*[nfix];
+  for (int k = 0; k < nfix; k++) fix[k] = fixes[k];
+  scale = new double[nfix];
+
+  x = f = g = nullptr;
+  df = dg = nullptr;
+  first = 1;
+  mat = new double[mdepth*mdepth + mdepth];
+}
+
+/* ---------------------------------------------------------------------- */
+
+DiffusionAnderson::~DiffusionAnderson()
+{
+  delete [] fix;
+  delete [] scale;
+  delete [] mat;
+
+  memory->destroy(x);
+  memory->destroy(f);
+  memory->destroy(g);
+  memory->destroy(df);
+  memory->destroy(dg);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void DiffusionAnderson::grow()
+{
+  nmax = nvec;
+  memory->destroy(x);
+  memory->destroy(f);
+  memory->destroy(g);
+  memory->destroy(df);
+  memory->destroy(dg);
+  memory->create(x, nmax, "nufeb/anderson:x");
+  memory->create(f, nmax, "nufeb/anderson:f");
+  memory->create(g, nmax, "nufeb/anderson:g");
+  memory->create(df, mdepth, nmax, "nufeb/anderson:df");
+  memory->create(dg, mdepth, nmax, "nufeb/anderson:dg");
+}
+
+/* ----------------------------------------------------------------------
+   start a new sequence of iterations from the current concentrations
+   each substrate is weighted by its largest concentration
+------------------------------------------------------------------------- */
+
+void DiffusionAnderson::reset()
+{
+  grid->update_runs();
+
+  int ngrid = 0;
+  for (int r = 0; r < grid->nruns; r++)
+    ngrid += grid->run_end[r] - grid->run_begin[r];
+  nvec = ngrid * nfix;
+  if (nvec > nmax) grow();
+
+  int n = 0;
+  for (int k = 0; k < nfix; k++) {
+    double *conc = grid->conc[fix[k]->isub];
+    double cmax = 0.0;
+    for (int r = 0; r < grid->nruns; r++) {
+      for (int i = grid->run_begin[r]; i < grid->run_end[r]; i++) {
+        x[n++] = conc[i];
+        cmax = MAX(cmax, conc[i]);
+      }
+    }
+    scale[k] = cmax;
+  }
+  MPI_Allreduce(MPI_IN_PLACE, scale, nfix, MPI_DOUBLE, MPI_MAX, world);
+  for (int k = 0; k < nfix; k++)
+    scale[k] = scale[k] > 0.0 ? 1.0 / scale[k] : 1.0;
+
+  nhist = ihist = 0;
+  first = 1;
+}
+
+/* ----------------------------------------------------------------------
+   replace the concentrations g(x) computed by the last iteration with
+   the accelerated iterate
+------------------------------------------------------------------------- */
+
+void DiffusionAnderson::mix()
+{
+  // store g(x), the weighted residual and their differences
+
+  int n = 0;
+  for (int k = 0; k < nfix; k++) {
+    double *conc = grid->conc[fix[k]->isub];
+    double w = scale[k];
+    for (int r = 0; r < grid->nruns; r++) {
+      for (int i = grid->run_begin[r]; i < grid->run_end[r]; i++) {
+        double fn = w * (conc[i] - x[n]);
+        if (!first) {
+          df[ihist][n] = fn - f[n];
+          dg[ihist][n] = conc[i] - g[n];
+        }
+        f[n] = fn;
+        g[n++] = conc[i];
+      }
+    }
+  }
+
+  if (first) {
+    first = 0;
+    for (int j = 0; j < nvec; j++) x[j] = g[j];
+    return;
+  }
+  ihist = (ihist + 1) % mdepth;
+  nhist = MIN(nhist + 1, mdepth);
+
+  // least-squares coefficients from the normal equations
+
+  int nmat = nhist * nhist;
+  for (int a = 0; a < nhist; a++) {
+    for (int b = 0; b <= a; b++) {
+      double sum = 0.0;
+      for (int j = 0; j < nvec; j++) sum += df[a][j] * df[b][j];
+      mat[a*nhist+b] = sum;
+    }
+    double sum = 0.0;
+    for (int j = 0; j < nvec; j++) sum += df[a][j] * f[j];
+    mat[nmat+a] = sum;
+  }
+  MPI_Allreduce(MPI_IN_PLACE, mat, nmat + nhist, MPI_DOUBLE, MPI_SUM, world);
+
+  if (!solve(nhist)) {
+    // singular system, restart from plain iterations
+    nhist = ihist = 0;
+    for (int j = 0; j < nvec; j++) x[j] = g[j];
+    return;
+  }
+
+  // x = g(x) - sum gamma_a dg_a, clamped as the explicit update
+
+  for (int j = 0; j < nvec; j++) x[j] = g[j];
+  for (int a = 0; a < nhist; a++) {
+    double gamma = mat[nmat+a];
+    for (int j = 0; j < nvec; j++) x[j] -= gamma * dg[a][j];
+  }
+
+  n = 0;
+  for (int k = 0; k < nfix; k++) {
+    double *conc = grid->conc[fix[k]->isub];
+    for (int r = 0; r < grid->nruns; r++) {
+      for (int i = grid->run_begin[r]; i < grid->run_end[r]; i++) {
+        double c = x[n];
+        c = c > THRESHOLD_CONC ? c : THRESHOLD_CONC;
+        x[n++] = c;
+        conc[i] = c;
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   solve the symmetric system stored in the lower triangle of mat with
+   right-hand side rhs = mat + n*n by Cholesky factorization, with a
+   small regularization of the diagonal. solution replaces rhs
+   return 0 if the system is singular
+------------------------------------------------------------------------- */
+
+int DiffusionAnderson::solve(int n)
+{
+  double *a = mat;
+  double *b = mat + n*n;
+
+  double trace = 0.0;
+  for (int i = 0; i < n; i++) trace += a[i*n+i];
+  if (trace <= 0.0) return 0;
+  for (int i = 0; i < n; i++) a[i*n+i] += 1e-12 * trace;
+
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j <= i; j++) {
+      double sum = a[i*n+j];
+      for (int k = 0; k < j; k++) sum -= a[i*n+k] * a[j*n+k];
+      if (i == j) {
+        if (sum <= 0.0) return 0;
+        a[i*n+i] = sqrt(sum);
+      } else a[i*n+j] = sum / a[j*n+j];
+    }
+  }
+
+  for (int i = 0; i < n; i++) {
+    double sum = b[i];
+    for (int k = 0; k < i; k++) sum -= a[i*n+k] * b[k];
+    b[i] = sum / a[i*n+i];
+  }
+  for (int i = n-1; i >= 0; i--) {
+    double sum = b[i];
+    for (int k = i+1; k < n; k++) sum -= a[k*n+i] * b[k];
+    b[i] = sum / a[i*n+i];
+  }
+  return 1;
+}
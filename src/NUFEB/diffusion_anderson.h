@@ -0,0 +1,52 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifndef LMP_DIFFUSION_ANDERSON_H
+#define LMP_DIFFUSION_ANDERSON_H
+
+#include "pointers.h"
+
+namespace LAMMPS_NS {
+
+class DiffusionAnderson : protected Pointers {
+ public:
+  DiffusionAnderson(class LAMMPS *, class FixDiffusionReaction **, int, int);
+  ~DiffusionAnderson();
+
+  void reset();
+  void mix();
+
+ private:
+  class FixDiffusionReaction **fix;
+  int nfix;
+  int mdepth;                   // max # of stored differences
+  int nhist;                    // # of stored differences
+  int ihist;                    // slot of the next difference (ring buffer)
+  int first;                    // 1 if no iteration since reset()
+  int nvec;                     // # of unknowns on this proc
+  int nmax;
+  double *scale;                // weight of each fix in the inner products
+
+  double *x;                    // current iterate
+  double *f;                    // residual g(x) - x of the last iteration
+  double *g;                    // g(x) of the last iteration
+  double **df, **dg;            // differences of f and g
+  double *mat;                  // normal equations, matrix then rhs
+
+  void grow();
+  int solve(int);
+};
+
+}
+
+#endif
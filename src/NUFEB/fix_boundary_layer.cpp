@@ -112,6 +112,7 @@ void FixBoundaryLayer::compute()
 //  printf("xlo = %i xhi = %i ylo = %i yhi = %i zlo = %i zhi = %i \n ", sublayerlo[0],sublayerhi[0],sublayerlo[1],sublayerhi[1],sublayerlo[2],sublayerhi[2]);
   // update bulk mask
   int *mask = grid->mask;
+  int changed = 0;
   for (int z = 0; z < grid->subbox[2]; z++) {
     for (int y = 0; y < grid->subbox[1]; y++) {
       for (int x = 0; x < grid->subbox[0]; x++) {
@@ -147,10 +148,12 @@ void FixBoundaryLayer::compute()
           m |= GRID_MASK;
         }
 
+        if (mask[i] != m) changed = 1;
         mask[i] = m;
       }
     }
   }
+  if (changed) grid->mask_version++;
 }
 
 
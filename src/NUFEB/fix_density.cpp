@@ -76,7 +76,13 @@ void FixDensity::post_physics_nufeb()
 
 void FixDensity::compute()
 {
+  // only the groups with per-group grid fields are accumulated
+  int ngroups = 0;
+  int groups[Grid::MAXGROUP], bits[Grid::MAXGROUP];
   for (int igroup = 0; igroup < group->ngroup; igroup++) {
+    if (grid->group_field[igroup] < 0) continue;
+    groups[ngroups] = igroup;
+    bits[ngroups++] = group->bitmask[igroup];
     for (int i = 0; i < grid->ncells; i++)
       grid->dens[igroup][i] = 0.0;
   }
@@ -86,18 +92,22 @@ void FixDensity::compute()
   //   sub-domain and were not yet exchanged
   // forward communication garantees that we have the latest ghost positions
   //   which were updated during initial integrate
+  int *cells = grid->atom_cells();
   for (int i = 0; i < atom->nlocal + atom->nghost; i++) {
     if (atom->x[i][0] >= domain->sublo[0] && atom->x[i][0] < domain->subhi[0] &&
         atom->x[i][1] >= domain->sublo[1] && atom->x[i][1] < domain->subhi[1] &&
         atom->x[i][2] >= domain->sublo[2] && atom->x[i][2] < domain->subhi[2]) {
-      int cell = grid->cell(atom->x[i]);
+      int cell = cells[i];
 
       double d = atom->biomass[i] * atom->rmass[i] / vol;
       grid->dens[0][cell] += d;
-      for (int igroup = 0; igroup < group->ngroup; igroup++) {
-        if (atom->mask[i] & group->bitmask[igroup])
-          grid->dens[igroup][cell] += d;
+      for (int g = 0; g < ngroups; g++) {
+        if (atom->mask[i] & bits[g])
+          grid->dens[groups[g]][cell] += d;
       }
     }
   }
+
+  // occupied cell lists are rebuilt on demand
+  grid->set_occupied(1);
 }
@@ -28,13 +28,18 @@ using namespace LAMMPS_NS;
 using namespace FixConst;
 
 #define THRESHOLD_CONC 1E-20
+#define MAXLEVEL 16
+#define NSMOOTH 2      // # of pre- and post-smoothing sweeps
+#define NCOARSE 20     // # of smoothing sweeps on the coarsest level
+
+enum{MG_ACTIVE=-1,MG_FIXED=-2};
 
 /* ---------------------------------------------------------------------- */
 
 FixDiffusionReaction::FixDiffusionReaction(LAMMPS *lmp, int narg, char **arg) :
   Fix(lmp, narg, arg)
 {
-  if (narg < 3)
+  if (narg < 5)
     error->all(FLERR,"Illegal fix nufeb/diffusion_reaction command");
 
   dynamic_group_allow = 1;
@@ -47,11 +52,70 @@ FixDiffusionReaction::FixDiffusionReaction(LAMMPS *lmp, int narg, char **arg) :
   penult = nullptr;
   boundary = nullptr;
 
+  list_version = -1;
+  maxlist = 0;
+  ndirichlet = nneumann = 0;
+  dirichlet = nullptr;
+  neumann = nullptr;
+  neumann_src = nullptr;
+
+  solver = EXPLICIT;
+  check = 1;
+  residual = 0.0;
+  freeze_size = 0;
+  freeze_tol = 0.0;
+  block_version = -1;
+  block_step = -1;
+  nblocks = 0;
+  bbox[0] = bbox[1] = bbox[2] = 0;
+  frozen = nullptr;
+  block_res = nullptr;
+  npieces = npieces_inner = maxpieces = 0;
+  piece_begin = piece_end = piece_block = nullptr;
+  ncycles = 2;
+  nlevels = 0;
+  mg_version = -1;
+  mg_nmax = 0;
+  mg_box = nullptr;
+  mg_idx2 = nullptr;
+  mg_first = nullptr;
+  mg_nmirror = nullptr;
+  mg_type = nullptr;
+  mg_mirror = nullptr;
+  mg_u = nullptr;
+  mg_f = nullptr;
+  mg_r = nullptr;
+
   isub = grid->find(arg[3]);
   if (isub < 0)
     error->all(FLERR, "Can't find substrate for nufeb/diffusion_reaction");
 
   diff_coeff = utils::numeric(FLERR,arg[4],true,lmp);
+
+  int iarg = 5;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg], "solver") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal fix nufeb/diffusion_reaction command");
+      if (strcmp(arg[iarg+1], "explicit") == 0) solver = EXPLICIT;
+      else if (strcmp(arg[iarg+1], "mg") == 0) solver = MULTIGRID;
+      else error->all(FLERR,"Illegal fix nufeb/diffusion_reaction command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg], "cycles") == 0) {
+      if (iarg+2 > narg) error->all(FLERR,"Illegal fix nufeb/diffusion_reaction command");
+      ncycles = utils::inumeric(FLERR,arg[iarg+1],true,lmp);
+      if (ncycles <= 0) error->all(FLERR,"Illegal fix nufeb/diffusion_reaction command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg], "freeze") == 0) {
+      if (iarg+3 > narg) error->all(FLERR,"Illegal fix nufeb/diffusion_reaction command");
+      freeze_size = utils::inumeric(FLERR,arg[iarg+1],true,lmp);
+      freeze_tol = utils::numeric(FLERR,arg[iarg+2],true,lmp);
+      if (freeze_size < 0 || freeze_tol < 0.0)
+        error->all(FLERR,"Illegal fix nufeb/diffusion_reaction command");
+      iarg += 3;
+    } else {
+      error->all(FLERR,"Illegal fix nufeb/diffusion_reaction command");
+    }
+  }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -61,6 +125,26 @@ FixDiffusionReaction::~FixDiffusionReaction()
   if (copymode) return;
   memory->destroy(prev);
   if (closed_system) memory->destroy(penult);
+
+  memory->destroy(dirichlet);
+  memory->destroy(neumann);
+  memory->destroy(neumann_src);
+
+  memory->destroy(frozen);
+  memory->destroy(block_res);
+  memory->destroy(piece_begin);
+  memory->destroy(piece_end);
+  memory->destroy(piece_block);
+
+  memory->destroy(mg_box);
+  memory->destroy(mg_idx2);
+  memory->destroy(mg_first);
+  memory->destroy(mg_nmirror);
+  memory->destroy(mg_type);
+  memory->destroy(mg_mirror);
+  memory->destroy(mg_u);
+  memory->destroy(mg_f);
+  memory->destroy(mg_r);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -101,6 +185,15 @@ void FixDiffusionReaction::init()
   }
   if (!fix) closed_system = 1;
 
+  if (solver == MULTIGRID && closed_system)
+    error->all(FLERR, "Fix nufeb/diffusion_reaction solver mg requires a Dirichlet boundary");
+  if (solver == MULTIGRID && grid->nghost > 1)
+    error->all(FLERR, "Fix nufeb/diffusion_reaction solver mg requires a ghost depth of 1");
+  if (freeze_size && solver != EXPLICIT)
+    error->all(FLERR, "Fix nufeb/diffusion_reaction freeze requires the explicit solver");
+  if (freeze_size && grid->nghost > 1)
+    error->all(FLERR, "Fix nufeb/diffusion_reaction freeze requires a ghost depth of 1");
+
   if (closed_system) {
     penult = memory->create(penult, ncells, "nufeb/diffusion_reaction:penult");
     for (int i = 0; i < ncells; i++)
@@ -114,10 +207,25 @@ void FixDiffusionReaction::init()
 
 double FixDiffusionReaction::compute_scalar()
 {
+  double result = local_residual();
+  MPI_Allreduce(MPI_IN_PLACE, &result, 1, MPI_DOUBLE, MPI_MAX, world);
+  return result;
+}
+
+/* ----------------------------------------------------------------------
+   maximum relative change of the last update on this proc
+------------------------------------------------------------------------- */
+
+double FixDiffusionReaction::local_residual()
+{
+  const double * _noalias const conc = grid->conc[isub];
   double result = 0.0;
-  for (int i = 0; i < grid->ncells; i++) {
-    if (grid->mask[i] & GRID_MASK) {
-      double res = fabs((grid->conc[isub][i] - prev[i]) / prev[i]);
+
+  grid->update_runs();
+  for (int r = 0; r < grid->nruns; r++) {
+    const int end = grid->run_end[r];
+    for (int i = grid->run_begin[r]; i < end; i++) {
+      double res = fabs((conc[i] - prev[i]) / prev[i]);
       if (closed_system) {
         double res2 = fabs((prev[i] - penult[i]) / penult[i]);
         res = fabs(res - res2);
@@ -125,7 +233,6 @@ double FixDiffusionReaction::compute_scalar()
       result = MAX(result, res);
     }
   }
-  MPI_Allreduce(MPI_IN_PLACE, &result, 1, MPI_DOUBLE, MPI_MAX, world);
   return result;
 }
 
@@ -145,78 +252,347 @@ void FixDiffusionReaction::compute_initial()
     prev = memory->grow(prev, ncells, "nufeb/diffusion_reaction:prev");
     if (closed_system) penult = memory->grow(penult, ncells, "nufeb/diffusion_reaction:penult");
   }
+  update_lists();
 
-  for (int i = 0; i < grid->ncells; i++) {
-    // Dirichlet boundary conditions
-    if (grid->mask[i] & X_NB_MASK && (boundary[0] == DIRICHLET)) {
-      grid->conc[isub][i] = grid->bulk[isub];
-    } else if (grid->mask[i] & X_PB_MASK && boundary[1] == DIRICHLET) {
-      grid->conc[isub][i] = grid->bulk[isub];
-    } else if (grid->mask[i] & Y_NB_MASK && boundary[2] == DIRICHLET) {
-      grid->conc[isub][i] = grid->bulk[isub];
-    } else if (grid->mask[i] & Y_PB_MASK && boundary[3] == DIRICHLET) {
-      grid->conc[isub][i] = grid->bulk[isub];
-    } else if (grid->mask[i] & Z_NB_MASK && boundary[4] == DIRICHLET) {
-      grid->conc[isub][i] = grid->bulk[isub];
-    } else if (grid->mask[i] & Z_PB_MASK && boundary[5] == DIRICHLET) {
-      grid->conc[isub][i] = grid->bulk[isub];
-    } else if (grid->mask[i] & BLAYER_MASK) {
-      grid->conc[isub][i] = grid->bulk[isub];
-    }
-    grid->reac[isub][i] = 0.0;
+  double * _noalias const conc = grid->conc[isub];
+  double * _noalias const reac = grid->reac[isub];
+  const double bulk = grid->bulk[isub];
+
+  // Dirichlet boundary conditions
+  for (int n = 0; n < ndirichlet; n++)
+    conc[dirichlet[n]] = bulk;
+
+  for (int i = 0; i < ncells; i++)
+    reac[i] = 0.0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixDiffusionReaction::compute_final()
+{
+  residual = 0.0;
+
+  // with deep ghost layers one sweep is performed per layer, each
+  // sweep updating one layer less than the previous one
+  for (int level = grid->nghost - 1; level >= 0; level--)
+    sweep(level);
+}
+
+/* ----------------------------------------------------------------------
+   one sweep over the cells of a ghost level, the residual is only
+   computed on the last sweep (level 0)
+------------------------------------------------------------------------- */
+
+void FixDiffusionReaction::sweep(int level)
+{
+  history();
+
+  if (solver == MULTIGRID) {
+    mg_solve();
+    if (check) residual = local_residual();
+    return;
   }
+
+  if (freeze_size) {
+    stencil_blocks(0, npieces, check);
+    if (check) update_frozen();
+    return;
+  }
+
+  grid->update_runs();
+  stencil(grid->run_level[level], grid->run_level[level+1],
+          check && level == 0);
 }
 
+/* ----------------------------------------------------------------------
+   same as compute_final() split in two parts, to be called while the
+   grid forward comm is in progress (interior) and after it has completed
+   (boundary). only the cells whose stencil does not reach the ghost
+   region are updated by the first part. requires a ghost depth of 1
+------------------------------------------------------------------------- */
 
+void FixDiffusionReaction::compute_interior()
+{
+  residual = 0.0;
+  if (solver == MULTIGRID) return;
+
+  history();
+  if (freeze_size) {
+    stencil_blocks(0, npieces_inner, check);
+    return;
+  }
+
+  grid->update_runs();
+  stencil(0, grid->ninner, check);
+}
 
 /* ---------------------------------------------------------------------- */
 
-void FixDiffusionReaction::compute_final()
+void FixDiffusionReaction::compute_boundary()
+{
+  if (solver == MULTIGRID) {
+    sweep(0);
+    return;
+  }
+
+  // ghost cells have been updated since history()
+  double *conc = grid->conc[isub];
+  for (int n = 0; n < grid->nframe; n++) {
+    int i = grid->frame[n];
+    prev[i] = conc[i];
+  }
+
+  if (freeze_size) {
+    stencil_blocks(npieces_inner, npieces, check);
+    if (check) update_frozen();
+    return;
+  }
+
+  stencil(grid->ninner, grid->nruns, check);
+}
+
+/* ----------------------------------------------------------------------
+   apply Neumann boundary conditions and store previous concentrations
+------------------------------------------------------------------------- */
+
+void FixDiffusionReaction::history()
+{
+  double * _noalias const conc = grid->conc[isub];
+
+  if (freeze_size) update_blocks();
+
+  // Neumann boundary conditions, in increasing cell order
+  update_lists();
+  for (int n = 0; n < nneumann; n++)
+    conc[neumann[n]] = conc[neumann_src[n]];
+
+  if (closed_system) {
+    for (int i = 0; i < ncells; i++)
+      penult[i] = prev[i];
+  }
+  for (int i = 0; i < ncells; i++)
+    prev[i] = conc[i];
+}
+
+/* ----------------------------------------------------------------------
+   explicit update of the cells of runs [rbegin,rend)
+   the residual is accumulated run by run if flag is set
+------------------------------------------------------------------------- */
+
+void FixDiffusionReaction::stencil(int rbegin, int rend, int flag)
+{
+  double * _noalias const conc = grid->conc[isub];
+  const double * _noalias const p = prev;
+  const double * _noalias const pp = penult;
+  const double * _noalias const reac = grid->reac[isub];
+  const double * _noalias const d = grid->diff_coeff[isub];
+  const int nx = grid->subbox[0];
+  const int nxy = grid->subbox[0] * grid->subbox[1];
+  const double dtidx2 = dt / (grid->cell_size * grid->cell_size);
+  double res = residual;
+
+  // cells are swept in contiguous x-runs without branches
+  for (int r = rbegin; r < rend; r++) {
+    const int begin = grid->run_begin[r];
+    const int end = grid->run_end[r];
+    for (int i = begin; i < end; i++) {
+      double lap = (p[i-1] + p[i+1]) + (p[i-nx] + p[i+nx]) +
+        (p[i-nxy] + p[i+nxy]) - 6.0 * p[i];
+      double c = p[i] + dtidx2 * d[i] * lap + dt * reac[i];
+      // prevent negative concentrations
+      conc[i] = c > THRESHOLD_CONC ? c : THRESHOLD_CONC;
+    }
+    if (!flag) continue;
+    if (closed_system) {
+      for (int i = begin; i < end; i++) {
+        double r1 = fabs((conc[i] - p[i]) / p[i]);
+        double r2 = fabs((p[i] - pp[i]) / pp[i]);
+        double ri = fabs(r1 - r2);
+        res = ri > res ? ri : res;
+      }
+    } else {
+      for (int i = begin; i < end; i++) {
+        double ri = fabs((conc[i] - p[i]) / p[i]);
+        res = ri > res ? ri : res;
+      }
+    }
+  }
+  residual = res;
+}
+
+/* ----------------------------------------------------------------------
+   same as stencil() over pieces [pbegin,pend), pieces of frozen blocks
+   are skipped unless the residual is computed (flag set), in which case
+   all blocks are updated and their residuals are stored
+------------------------------------------------------------------------- */
+
+void FixDiffusionReaction::stencil_blocks(int pbegin, int pend, int flag)
+{
+  double * _noalias const conc = grid->conc[isub];
+  const double * _noalias const p = prev;
+  const double * _noalias const pp = penult;
+  const double * _noalias const reac = grid->reac[isub];
+  const double * _noalias const d = grid->diff_coeff[isub];
+  const int nx = grid->subbox[0];
+  const int nxy = grid->subbox[0] * grid->subbox[1];
+  const double dtidx2 = dt / (grid->cell_size * grid->cell_size);
+  double res = residual;
+
+  for (int n = pbegin; n < pend; n++) {
+    const int b = piece_block[n];
+    if (!flag && frozen[b]) continue;
+    const int begin = piece_begin[n];
+    const int end = piece_end[n];
+    for (int i = begin; i < end; i++) {
+      double lap = (p[i-1] + p[i+1]) + (p[i-nx] + p[i+nx]) +
+        (p[i-nxy] + p[i+nxy]) - 6.0 * p[i];
+      double c = p[i] + dtidx2 * d[i] * lap + dt * reac[i];
+      // prevent negative concentrations
+      conc[i] = c > THRESHOLD_CONC ? c : THRESHOLD_CONC;
+    }
+    if (!flag) continue;
+    double bres = block_res[b];
+    for (int i = begin; i < end; i++) {
+      double ri = fabs((conc[i] - p[i]) / p[i]);
+      if (closed_system) ri = fabs(ri - fabs((p[i] - pp[i]) / pp[i]));
+      bres = ri > bres ? ri : bres;
+    }
+    block_res[b] = bres;
+    res = bres > res ? bres : res;
+  }
+  residual = res;
+}
+
+/* ----------------------------------------------------------------------
+   split the level 0 runs in pieces along block boundaries when the
+   grid mask has changed, reactivate all blocks at each new timestep
+   and reset block residuals before they are computed
+------------------------------------------------------------------------- */
+
+void FixDiffusionReaction::update_blocks()
+{
+  if (block_version != grid->mask_version) {
+    block_version = grid->mask_version;
+    block_step = -1;
+    grid->update_runs();
+
+    const int nx = grid->subbox[0];
+    const int ny = grid->subbox[1];
+    for (int d = 0; d < 3; d++)
+      bbox[d] = (grid->subbox[d] + freeze_size - 1) / freeze_size;
+    nblocks = bbox[0] * bbox[1] * bbox[2];
+    memory->destroy(frozen);
+    memory->destroy(block_res);
+    memory->create(frozen, nblocks, "nufeb/diffusion_reaction:frozen");
+    memory->create(block_res, nblocks, "nufeb/diffusion_reaction:block_res");
+
+    npieces = 0;
+    for (int r = 0; r < grid->nruns; r++) {
+      if (r == grid->ninner) npieces_inner = npieces;
+      int begin = grid->run_begin[r];
+      const int end = grid->run_end[r];
+      const int y = (begin / nx) % ny;
+      const int z = begin / (nx * ny);
+      const int row = (y / freeze_size + (z / freeze_size) * bbox[1]) * bbox[0];
+      while (begin < end) {
+        int x = begin % nx;
+        int bx = x / freeze_size;
+        int stop = MIN(end, begin + (bx + 1) * freeze_size - x);
+        if (npieces == maxpieces) {
+          maxpieces += grid->nruns;
+          memory->grow(piece_begin, maxpieces, "nufeb/diffusion_reaction:piece_begin");
+          memory->grow(piece_end, maxpieces, "nufeb/diffusion_reaction:piece_end");
+          memory->grow(piece_block, maxpieces, "nufeb/diffusion_reaction:piece_block");
+        }
+        piece_begin[npieces] = begin;
+        piece_end[npieces] = stop;
+        piece_block[npieces++] = bx + row;
+        begin = stop;
+      }
+    }
+    if (grid->ninner >= grid->nruns) npieces_inner = npieces;
+  }
+
+  if (block_step != update->ntimestep) {
+    block_step = update->ntimestep;
+    for (int b = 0; b < nblocks; b++)
+      frozen[b] = 0;
+  }
+
+  if (check) {
+    for (int b = 0; b < nblocks; b++)
+      block_res[b] = 0.0;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   freeze the blocks that are quiet and whose face neighbors on this
+   proc are quiet too, all other blocks are (re)activated
+------------------------------------------------------------------------- */
+
+void FixDiffusionReaction::update_frozen()
+{
+  const int stride[3] = {1, bbox[0], bbox[0] * bbox[1]};
+
+  for (int b = 0; b < nblocks; b++) {
+    int quiet = block_res[b] < freeze_tol;
+    int c[3] = {b % bbox[0], (b / bbox[0]) % bbox[1], b / stride[2]};
+    for (int d = 0; d < 3 && quiet; d++) {
+      if (c[d] > 0 && block_res[b-stride[d]] >= freeze_tol) quiet = 0;
+      if (c[d] < bbox[d] - 1 && block_res[b+stride[d]] >= freeze_tol) quiet = 0;
+    }
+    frozen[b] = quiet;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   build the lists of Dirichlet (including bulk) and Neumann cells
+   with the same precedence of boundary conditions as the mask tests
+   only rebuilt when the grid mask has changed
+------------------------------------------------------------------------- */
+
+void FixDiffusionReaction::update_lists()
 {
+  if (list_version == grid->mask_version) return;
+  list_version = grid->mask_version;
+
+  int *mask = grid->mask;
   int nx = grid->subbox[0];
   int nxy = grid->subbox[0] * grid->subbox[1];
-  for (int i = 0; i < grid->ncells; i++) {
-    // Neumann boundary conditions
-    if (grid->mask[i] & X_NB_MASK && boundary[0] == NEUMANN) {
-      grid->conc[isub][i] = grid->conc[isub][i+1];
-    } else if (grid->mask[i] & X_PB_MASK && boundary[1] == NEUMANN) {
-      grid->conc[isub][i] = grid->conc[isub][i-1];
-    } else if (grid->mask[i] & Y_NB_MASK && boundary[2] == NEUMANN) {
-      int py = i + nx;
-      grid->conc[isub][i] = grid->conc[isub][py];
-    } else if (grid->mask[i] & Y_PB_MASK && boundary[3] == NEUMANN) {
-      int py = i - nx;
-      grid->conc[isub][i] = grid->conc[isub][py];
-    } else if (grid->mask[i] & Z_NB_MASK && boundary[4] == NEUMANN) {
-      int pz = i + nxy;
-      grid->conc[isub][i] = grid->conc[isub][pz];
-    } else if (grid->mask[i] & Z_PB_MASK && boundary[5] == NEUMANN) {
-      int pz = i - nxy;
-      grid->conc[isub][i] = grid->conc[isub][pz];
-    }
-    if (closed_system) penult[i] = prev[i];
-    prev[i] = grid->conc[isub][i];
+  const int face[6] = {X_NB_MASK, X_PB_MASK, Y_NB_MASK, Y_PB_MASK, Z_NB_MASK, Z_PB_MASK};
+  const int offset[6] = {1, -1, nx, -nx, nxy, -nxy};
+
+  int dmask = BLAYER_MASK;
+  int nmask = 0;
+  for (int j = 0; j < 6; j++) {
+    if (boundary[j] == DIRICHLET) dmask |= face[j];
+    else if (boundary[j] == NEUMANN) nmask |= face[j];
+  }
+
+  int n = 0;
+  for (int i = 0; i < grid->ncells; i++)
+    if (mask[i] & (dmask | nmask)) n++;
+  if (n > maxlist) {
+    maxlist = n;
+    memory->destroy(dirichlet);
+    memory->destroy(neumann);
+    memory->destroy(neumann_src);
+    memory->create(dirichlet, maxlist, "nufeb/diffusion_reaction:dirichlet");
+    memory->create(neumann, maxlist, "nufeb/diffusion_reaction:neumann");
+    memory->create(neumann_src, maxlist, "nufeb/diffusion_reaction:neumann_src");
   }
 
+  ndirichlet = nneumann = 0;
   for (int i = 0; i < grid->ncells; i++) {
-    if (grid->mask[i] & GRID_MASK) {
-      int nx = i - 1;
-      int px = i + 1;
-      int ny = i - grid->subbox[0];
-      int py = i + grid->subbox[0];
-      int nz = i - nxy;
-      int pz = i + nxy;
-      double dnx = grid->diff_coeff[isub][i] * (prev[i] - prev[nx]) / grid->cell_size;
-      double dpx = grid->diff_coeff[isub][i] * (prev[px] - prev[i]) / grid->cell_size;
-      double ddx = (dpx - dnx) / grid->cell_size;
-      double dny = grid->diff_coeff[isub][i] * (prev[i] - prev[ny]) / grid->cell_size;
-      double dpy = grid->diff_coeff[isub][i] * (prev[py] - prev[i]) / grid->cell_size;
-      double ddy = (dpy - dny) / grid->cell_size;
-      double dnz = grid->diff_coeff[isub][i] * (prev[i] - prev[nz]) / grid->cell_size;
-      double dpz = grid->diff_coeff[isub][i] * (prev[pz] - prev[i]) / grid->cell_size;
-      double ddz = (dpz - dnz) / grid->cell_size;
-      // prevent negative concentrations
-      grid->conc[isub][i] = MAX(THRESHOLD_CONC, prev[i] + dt * (ddx + ddy + ddz + grid->reac[isub][i]));
+    if (mask[i] & dmask) dirichlet[ndirichlet++] = i;
+    if (mask[i] & nmask) {
+      for (int j = 0; j < 6; j++) {
+        if (mask[i] & nmask & face[j]) {
+          neumann[nneumann] = i;
+          neumann_src[nneumann++] = i + offset[j];
+          break;
+        }
+      }
     }
   }
 }
@@ -253,3 +629,339 @@ void FixDiffusionReaction::closed_system_scaleup(double biodt)
     grid->conc[isub][i] = MAX(0, grid->conc[isub][i]);
   }
 }
+
+/* ----------------------------------------------------------------------
+   build the multigrid hierarchy from the grid mask and the boundary
+   conditions. interior dimensions are coarsened by two as long as they
+   are even, the one cell wide ghost frame is kept on every level.
+   cells outside the local sub-domain are held fixed, therefore each proc
+   solves its own block and the coupling across procs and periodic
+   boundaries is resolved by the outer chemistry iteration.
+------------------------------------------------------------------------- */
+
+void FixDiffusionReaction::mg_setup()
+{
+  if (mg_box == nullptr) {
+    memory->create(mg_box, MAXLEVEL, 3, "nufeb/diffusion_reaction:mg_box");
+    memory->create(mg_idx2, MAXLEVEL, 3, "nufeb/diffusion_reaction:mg_idx2");
+    memory->create(mg_first, MAXLEVEL+1, "nufeb/diffusion_reaction:mg_first");
+    memory->create(mg_nmirror, MAXLEVEL, "nufeb/diffusion_reaction:mg_nmirror");
+  }
+
+  double idx2 = 1.0 / (grid->cell_size * grid->cell_size);
+  for (int d = 0; d < 3; d++) {
+    mg_box[0][d] = grid->subbox[d];
+    mg_idx2[0][d] = idx2;
+  }
+  mg_first[0] = 0;
+  mg_first[1] = grid->ncells;
+
+  nlevels = 1;
+  while (nlevels < MAXLEVEL) {
+    int l = nlevels;
+    int coarsen = 0;
+    for (int d = 0; d < 3; d++) {
+      int n = mg_box[l-1][d] - 2;
+      if (n % 2 == 0 && n >= 4) {
+        mg_box[l][d] = n / 2 + 2;
+        mg_idx2[l][d] = 0.25 * mg_idx2[l-1][d];
+        coarsen = 1;
+      } else {
+        mg_box[l][d] = mg_box[l-1][d];
+        mg_idx2[l][d] = mg_idx2[l-1][d];
+      }
+    }
+    if (!coarsen) break;
+    mg_first[l+1] = mg_first[l] + mg_box[l][0] * mg_box[l][1] * mg_box[l][2];
+    nlevels++;
+  }
+
+  int n = mg_first[nlevels];
+  if (n > mg_nmax) {
+    mg_nmax = n;
+    memory->destroy(mg_type);
+    memory->destroy(mg_mirror);
+    memory->destroy(mg_u);
+    memory->destroy(mg_f);
+    memory->destroy(mg_r);
+    memory->create(mg_type, mg_nmax, "nufeb/diffusion_reaction:mg_type");
+    memory->create(mg_mirror, mg_nmax, "nufeb/diffusion_reaction:mg_mirror");
+    memory->create(mg_u, mg_nmax, "nufeb/diffusion_reaction:mg_u");
+    memory->create(mg_f, mg_nmax, "nufeb/diffusion_reaction:mg_f");
+    memory->create(mg_r, mg_nmax, "nufeb/diffusion_reaction:mg_r");
+  }
+
+  // finest level follows the same precedence as the explicit solver
+
+  int nx = grid->subbox[0];
+  int nxy = grid->subbox[0] * grid->subbox[1];
+  int *mask = grid->mask;
+  int *type = mg_type;
+  int *mirror = mg_mirror;
+  mg_nmirror[0] = 0;
+  for (int i = 0; i < grid->ncells; i++) {
+    int j = MG_FIXED;
+    if (mask[i] & GRID_MASK) j = MG_ACTIVE;
+    else if (mask[i] & X_NB_MASK && boundary[0] == NEUMANN) j = i + 1;
+    else if (mask[i] & X_PB_MASK && boundary[1] == NEUMANN) j = i - 1;
+    else if (mask[i] & Y_NB_MASK && boundary[2] == NEUMANN) j = i + nx;
+    else if (mask[i] & Y_PB_MASK && boundary[3] == NEUMANN) j = i - nx;
+    else if (mask[i] & Z_NB_MASK && boundary[4] == NEUMANN) j = i + nxy;
+    else if (mask[i] & Z_PB_MASK && boundary[5] == NEUMANN) j = i - nxy;
+    type[i] = j;
+    if (j >= 0) mirror[mg_nmirror[0]++] = i;
+  }
+
+  // coarse levels: interior cells are active if any child is active,
+  // ghost cells inherit the boundary condition of the finer level
+
+  for (int l = 1; l < nlevels; l++) {
+    int *fbox = mg_box[l-1];
+    int *cbox = mg_box[l];
+    int *ftype = mg_type + mg_first[l-1];
+    int *ctype = mg_type + mg_first[l];
+    int *cmirror = mg_mirror + mg_first[l];
+    int cnx = cbox[0];
+    int cnxy = cbox[0] * cbox[1];
+    mg_nmirror[l] = 0;
+
+    for (int z = 0; z < cbox[2]; z++) {
+      for (int y = 0; y < cbox[1]; y++) {
+        for (int x = 0; x < cbox[0]; x++) {
+          int c[3] = {x, y, z};
+          int lo[3], nchild[3];
+          int nframe = 0;
+          int dframe = -1;
+          for (int d = 0; d < 3; d++) {
+            int frame = (c[d] == 0 || c[d] == cbox[d] - 1);
+            if (frame) {
+              nframe++;
+              dframe = d;
+            }
+            if (cbox[d] == fbox[d]) {
+              lo[d] = c[d];
+              nchild[d] = 1;
+            } else {
+              lo[d] = (c[d] == 0) ? 0 : 2 * c[d] - 1;
+              nchild[d] = frame ? 1 : 2;
+            }
+          }
+
+          int i = x + y * cnx + z * cnxy;
+          int j = MG_FIXED;
+          if (nframe == 0) {
+            for (int fz = lo[2]; fz < lo[2] + nchild[2]; fz++)
+              for (int fy = lo[1]; fy < lo[1] + nchild[1]; fy++)
+                for (int fx = lo[0]; fx < lo[0] + nchild[0]; fx++)
+                  if (ftype[fx + fy * fbox[0] + fz * fbox[0] * fbox[1]] == MG_ACTIVE)
+                    j = MG_ACTIVE;
+          } else if (nframe == 1) {
+            if (ftype[lo[0] + lo[1] * fbox[0] + lo[2] * fbox[0] * fbox[1]] >= 0) {
+              int stride = (dframe == 0) ? 1 : ((dframe == 1) ? cnx : cnxy);
+              j = (c[dframe] == 0) ? i + stride : i - stride;
+              cmirror[mg_nmirror[l]++] = i;
+            }
+          }
+          ctype[i] = j;
+        }
+      }
+    }
+  }
+
+  mg_version = grid->mask_version;
+}
+
+/* ----------------------------------------------------------------------
+   solve D * lap(c) = -R for the current reaction term using V-cycles
+   the explicit update uses the cell diffusion coefficient for all faces,
+   thus its steady state satisfies lap(c) = -R / D
+------------------------------------------------------------------------- */
+
+void FixDiffusionReaction::mg_solve()
+{
+  if (mg_version != grid->mask_version || mg_box == nullptr ||
+      mg_box[0][0] != grid->subbox[0] || mg_box[0][1] != grid->subbox[1] ||
+      mg_box[0][2] != grid->subbox[2])
+    mg_setup();
+
+  double *conc = grid->conc[isub];
+  double *reac = grid->reac[isub];
+  double *coeff = grid->diff_coeff[isub];
+
+  for (int i = 0; i < grid->ncells; i++) {
+    if (mg_type[i] == MG_ACTIVE && coeff[i] > 0.0) mg_f[i] = -reac[i] / coeff[i];
+    else mg_f[i] = 0.0;
+  }
+
+  for (int n = 0; n < ncycles; n++)
+    mg_vcycle(0, conc);
+
+  // prevent negative concentrations
+  for (int i = 0; i < grid->ncells; i++)
+    if (mg_type[i] == MG_ACTIVE)
+      conc[i] = MAX(THRESHOLD_CONC, conc[i]);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixDiffusionReaction::mg_vcycle(int l, double *u)
+{
+  if (l == nlevels - 1) {
+    mg_smooth(l, u, NCOARSE);
+    return;
+  }
+
+  mg_smooth(l, u, NSMOOTH);
+  mg_residual(l, u);
+  mg_restrict(l);
+
+  double *uc = mg_u + mg_first[l+1];
+  int nc = mg_first[l+2] - mg_first[l+1];
+  for (int i = 0; i < nc; i++) uc[i] = 0.0;
+
+  mg_vcycle(l+1, uc);
+  mg_prolong(l, u);
+  mg_smooth(l, u, NSMOOTH);
+}
+
+/* ----------------------------------------------------------------------
+   copy values into Neumann ghost cells
+------------------------------------------------------------------------- */
+
+void FixDiffusionReaction::mg_neumann(int l, double *u)
+{
+  int *type = mg_type + mg_first[l];
+  int *mirror = mg_mirror + mg_first[l];
+  for (int k = 0; k < mg_nmirror[l]; k++) {
+    int i = mirror[k];
+    u[i] = u[type[i]];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   red-black Gauss-Seidel sweeps
+------------------------------------------------------------------------- */
+
+void FixDiffusionReaction::mg_smooth(int l, double *u, int nsweeps)
+{
+  int *type = mg_type + mg_first[l];
+  double *f = mg_f + mg_first[l];
+  int nx = mg_box[l][0];
+  int nxy = mg_box[l][0] * mg_box[l][1];
+  double cx = mg_idx2[l][0];
+  double cy = mg_idx2[l][1];
+  double cz = mg_idx2[l][2];
+  double idiag = 1.0 / (2.0 * (cx + cy + cz));
+
+  for (int n = 0; n < nsweeps; n++) {
+    for (int color = 0; color < 2; color++) {
+      mg_neumann(l, u);
+      for (int z = 1; z < mg_box[l][2] - 1; z++) {
+        for (int y = 1; y < mg_box[l][1] - 1; y++) {
+          int x0 = 1 + ((1 + y + z + color) & 1);
+          for (int x = x0; x < mg_box[l][0] - 1; x += 2) {
+            int i = x + y * nx + z * nxy;
+            if (type[i] != MG_ACTIVE) continue;
+            u[i] = (cx * (u[i-1] + u[i+1]) + cy * (u[i-nx] + u[i+nx]) +
+                    cz * (u[i-nxy] + u[i+nxy]) - f[i]) * idiag;
+          }
+        }
+      }
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixDiffusionReaction::mg_residual(int l, double *u)
+{
+  int *type = mg_type + mg_first[l];
+  double *f = mg_f + mg_first[l];
+  double *r = mg_r + mg_first[l];
+  int nx = mg_box[l][0];
+  int nxy = mg_box[l][0] * mg_box[l][1];
+  double cx = mg_idx2[l][0];
+  double cy = mg_idx2[l][1];
+  double cz = mg_idx2[l][2];
+  int n = mg_first[l+1] - mg_first[l];
+
+  mg_neumann(l, u);
+  for (int i = 0; i < n; i++) {
+    if (type[i] != MG_ACTIVE) {
+      r[i] = 0.0;
+      continue;
+    }
+    double lap = cx * (u[i-1] - 2.0 * u[i] + u[i+1]) +
+      cy * (u[i-nx] - 2.0 * u[i] + u[i+nx]) +
+      cz * (u[i-nxy] - 2.0 * u[i] + u[i+nxy]);
+    r[i] = f[i] - lap;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   average fine residual into the right-hand side of level l+1
+------------------------------------------------------------------------- */
+
+void FixDiffusionReaction::mg_restrict(int l)
+{
+  int *fbox = mg_box[l];
+  int *cbox = mg_box[l+1];
+  int *ctype = mg_type + mg_first[l+1];
+  double *r = mg_r + mg_first[l];
+  double *fc = mg_f + mg_first[l+1];
+  int s[3];
+  for (int d = 0; d < 3; d++) s[d] = (cbox[d] == fbox[d]) ? 1 : 2;
+  double inv = 1.0 / (s[0] * s[1] * s[2]);
+
+  int nc = mg_first[l+2] - mg_first[l+1];
+  for (int i = 0; i < nc; i++) fc[i] = 0.0;
+
+  for (int z = 1; z < cbox[2] - 1; z++) {
+    for (int y = 1; y < cbox[1] - 1; y++) {
+      for (int x = 1; x < cbox[0] - 1; x++) {
+        int i = x + y * cbox[0] + z * cbox[0] * cbox[1];
+        if (ctype[i] != MG_ACTIVE) continue;
+        int lo[3] = {(s[0] == 2) ? 2 * x - 1 : x,
+                     (s[1] == 2) ? 2 * y - 1 : y,
+                     (s[2] == 2) ? 2 * z - 1 : z};
+        double sum = 0.0;
+        for (int fz = lo[2]; fz < lo[2] + s[2]; fz++)
+          for (int fy = lo[1]; fy < lo[1] + s[1]; fy++)
+            for (int fx = lo[0]; fx < lo[0] + s[0]; fx++)
+              sum += r[fx + fy * fbox[0] + fz * fbox[0] * fbox[1]];
+        fc[i] = sum * inv;
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   add piecewise constant correction from level l+1 to level l
+------------------------------------------------------------------------- */
+
+void FixDiffusionReaction::mg_prolong(int l, double *u)
+{
+  int *fbox = mg_box[l];
+  int *cbox = mg_box[l+1];
+  int *ftype = mg_type + mg_first[l];
+  double *uc = mg_u + mg_first[l+1];
+  int s[3];
+  for (int d = 0; d < 3; d++) s[d] = (cbox[d] == fbox[d]) ? 1 : 2;
+
+  for (int z = 1; z < cbox[2] - 1; z++) {
+    for (int y = 1; y < cbox[1] - 1; y++) {
+      for (int x = 1; x < cbox[0] - 1; x++) {
+        double e = uc[x + y * cbox[0] + z * cbox[0] * cbox[1]];
+        int lo[3] = {(s[0] == 2) ? 2 * x - 1 : x,
+                     (s[1] == 2) ? 2 * y - 1 : y,
+                     (s[2] == 2) ? 2 * z - 1 : z};
+        for (int fz = lo[2]; fz < lo[2] + s[2]; fz++)
+          for (int fy = lo[1]; fy < lo[1] + s[1]; fy++)
+            for (int fx = lo[0]; fx < lo[0] + s[0]; fx++) {
+              int j = fx + fy * fbox[0] + fz * fbox[0] * fbox[1];
+              if (ftype[j] == MG_ACTIVE) u[j] += e;
+            }
+      }
+    }
+  }
+}
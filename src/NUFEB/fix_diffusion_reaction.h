@@ -26,8 +26,15 @@ namespace LAMMPS_NS {
 
 class FixDiffusionReaction : public Fix {
  public:
+  enum {EXPLICIT, MULTIGRID};
+
   int isub;
   double diff_coeff;
+  int solver;                  // EXPLICIT or MULTIGRID
+  int freeze_size;             // edge of the freezing blocks (cells), 0 if off
+  int check;                   // 1 if the next update computes the residual
+  double residual;             // residual of the last checked update on this proc
+  int closed_system;           // 1 if no boundary is Dirichlet
 
   FixDiffusionReaction(class LAMMPS *, int, char **);
   virtual ~FixDiffusionReaction();
@@ -39,6 +46,8 @@ class FixDiffusionReaction : public Fix {
   virtual double compute_scalar();
   virtual void compute_initial();
   virtual void compute_final();
+  void compute_interior();
+  void compute_boundary();
   virtual void closed_system_initial();
   virtual void closed_system_scaleup(double);
 
@@ -49,8 +58,63 @@ class FixDiffusionReaction : public Fix {
   int *boundary;
 
   double *penult;	       // substrate concentration at n-2 step
-  int closed_system;
 
+  // boundary cells, rebuilt when the grid mask changes
+  int list_version;            // grid mask version the lists were built for
+  int maxlist;                 // allocated size of the lists
+  int ndirichlet;              // # of Dirichlet and bulk cells
+  int *dirichlet;              // Dirichlet and bulk cells
+  int nneumann;                // # of Neumann cells
+  int *neumann;                // Neumann cells
+  int *neumann_src;            // interior cell mirrored by each Neumann cell
+
+  void update_lists();
+  void sweep(int);
+  void history();
+  void stencil(int, int, int);
+  double local_residual();
+
+  // blocks of the sub-domain frozen once converged, runs are split
+  // in pieces so that each piece belongs to a single block
+  double freeze_tol;           // residual below which a block is quiet
+  int block_version;           // grid mask version the pieces were built for
+  bigint block_step;           // timestep blocks were last reactivated
+  int nblocks;                 // # of blocks on this proc
+  int bbox[3];                 // # of blocks in each dimension
+  int *frozen;                 // 1 if block is frozen
+  double *block_res;           // residual of each block
+  int npieces;                 // # of pieces of the level 0 runs
+  int npieces_inner;           // pieces of runs [0,grid->ninner)
+  int maxpieces;
+  int *piece_begin, *piece_end, *piece_block;
+
+  void update_blocks();
+  void update_frozen();
+  void stencil_blocks(int, int, int);
+
+  // multigrid hierarchy, all levels are stored contiguously
+  int ncycles;                 // # of V-cycles per chemistry iteration
+  int nlevels;                 // # of multigrid levels
+  int mg_version;              // grid mask version the hierarchy was built for
+  int mg_nmax;                 // allocated size of multigrid arrays
+  int **mg_box;                // # of cells in each dimension per level
+  double **mg_idx2;            // 1/h^2 in each dimension per level
+  int *mg_first;               // index of the first cell of each level
+  int *mg_nmirror;             // # of Neumann cells per level
+  int *mg_type;                // MG_ACTIVE, MG_FIXED or cell mirrored (Neumann)
+  int *mg_mirror;              // Neumann cells per level
+  double *mg_u;                // correction
+  double *mg_f;                // right-hand side
+  double *mg_r;                // residual
+
+  void mg_setup();
+  void mg_solve();
+  void mg_vcycle(int, double *);
+  void mg_neumann(int, double *);
+  void mg_smooth(int, double *, int);
+  void mg_residual(int, double *);
+  void mg_restrict(int);
+  void mg_prolong(int, double *);
 };
 
 }
@@ -59,4 +123,28 @@ class FixDiffusionReaction : public Fix {
 #endif
 
 /* ERROR/WARNING messages:
+
+E: Illegal fix nufeb/diffusion_reaction command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.
+
+E: Fix nufeb/diffusion_reaction solver mg requires a Dirichlet boundary
+
+The steady-state problem is singular in a closed system.  Use the
+explicit solver instead.
+
+E: Fix nufeb/diffusion_reaction solver mg requires a ghost depth of 1
+
+The multigrid hierarchy is built on a single layer of ghost cells.
+Remove the grid_modify ghost command or use the explicit solver.
+
+E: Fix nufeb/diffusion_reaction freeze requires the explicit solver
+
+Blocks can only be frozen with the explicit solver.
+
+E: Fix nufeb/diffusion_reaction freeze requires a ghost depth of 1
+
+Remove the grid_modify ghost command or the freeze keyword.
+
 */
@@ -16,6 +16,7 @@
 #include <string.h>
 #include "error.h"
 #include "update.h"
+#include "grid.h"
 
 using namespace LAMMPS_NS;
 using namespace FixConst;
@@ -63,6 +64,8 @@ void FixDivide::biology_nufeb()
 {
   if (update->ntimestep % nevery) return;
   compute();
+  // atoms have been moved or created
+  grid->reset_atom_cells();
   // trigger immediate reneighboring
   next_reneighbor = update->ntimestep;
 }
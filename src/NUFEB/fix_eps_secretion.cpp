@@ -22,6 +22,7 @@
 #include "random_park.h"
 #include "modify.h"
 #include "update.h"
+#include "grid.h"
 #include "domain.h"
 #include "group.h"
 #include "atom_masks.h"
@@ -94,6 +95,8 @@ void FixEPSSecretion::biology_nufeb()
 {
   if (update->ntimestep % nevery) return;
   compute();
+  // atoms have been moved or created
+  grid->reset_atom_cells();
   // trigger immediate reneighboring
   next_reneighbor = update->ntimestep;
 }
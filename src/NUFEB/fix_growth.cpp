@@ -35,7 +35,10 @@ FixGrowth::FixGrowth(LAMMPS *lmp, int narg, char **arg) :
   Fix(lmp, narg, arg)
 {
   dt = 1.0;
+  exp_flag = 0;
   dynamic_group_allow = 1;
+
+  grid->add_group(igroup);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -98,7 +101,6 @@ void FixGrowth::chemistry_nufeb()
 
 void FixGrowth::update_atoms_coccus()
 {
-  double **x = atom->x;
   double *radius = atom->radius;
   double *rmass = atom->rmass;
   double *outer_radius = atom->outer_radius;
@@ -108,15 +110,16 @@ void FixGrowth::update_atoms_coccus()
   const double four_thirds_pi = 4.0 * MY_PI / 3.0;
   const double third = 1.0 / 3.0;
   int mass_flag = 0;
+  int *cells = grid->atom_cells();
 
   for (int i = 0; i < atom->nlocal; i++) {
     if (atom->mask[i] & groupbit) {
-      const int cell = grid->cell(x[i]);
+      const int cell = cells[i];
 
       const double density = rmass[i] / (four_thirds_pi * radius[i] * radius[i] * radius[i]);
-      double growth = grid->growth[igroup][cell][0];
-      // forward Euler to update rmass
-      rmass[i] = rmass[i] * (1 + growth * dt);
+      double growth = grid->growth[igroup][cell];
+      // forward Euler or exponential update of rmass
+      rmass[i] = rmass[i] * (exp_flag ? exp(growth * dt) : 1 + growth * dt);
       if (rmass[i] <= 0) {
         rmass[i] = MIN_MASS;
         mass_flag = 1;
@@ -136,11 +139,11 @@ void FixGrowth::update_atoms_coccus()
 
 void FixGrowth::update_atoms_bacillus(AtomVecBacillus *&avec)
 {
-  double **x = atom->x;
   double *rmass = atom->rmass;
 
   const double four_thirds_pi = 4.0 * MY_PI / 3.0;
   int mass_flag = 0;
+  int *cells = grid->atom_cells();
 
   for (int i = 0; i < atom->nlocal; i++) {
     if (atom->mask[i] & groupbit) {
@@ -152,12 +155,12 @@ void FixGrowth::update_atoms_bacillus(AtomVecBacillus *&avec)
       double length = bonus->length;
 
       double new_length;
-      const int cell = grid->cell(x[i]);
+      const int cell = cells[i];
 
       const double density = rmass[i] /	(vsphere + acircle * bonus->length);
-      double growth = grid->growth[igroup][cell][0];
-      // forward Eular to update rmass
-      rmass[i] = rmass[i] * (1 + growth * dt);
+      double growth = grid->growth[igroup][cell];
+      // forward Euler or exponential update of rmass
+      rmass[i] = rmass[i] * (exp_flag ? exp(growth * dt) : 1 + growth * dt);
       if (rmass[i] <= 0) {
         rmass[i] = MIN_MASS;
         mass_flag = 1;
@@ -33,7 +33,9 @@ class FixGrowth : public Fix {
   virtual void reset_dt();
   virtual void update_atoms() = 0;
   virtual void update_cells() = 0;
-  
+
+  int exp_flag;                 // 1 to integrate biomass with an exponential update
+
  protected:
   double dt;
 
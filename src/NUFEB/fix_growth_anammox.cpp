@@ -100,20 +100,24 @@ FixGrowthAnammox::FixGrowthAnammox(LAMMPS *lmp, int narg, char **arg) :
 
 void FixGrowthAnammox::update_cells()
 {
-  double **conc = grid->conc;
   double **reac = grid->reac;
   double **dens = grid->dens;
 
-  for (int i = 0; i < grid->ncells; i++) {
-    if (grid->mask[i] & GRID_MASK) {
-      double tmp1 = growth * conc[inh4][i] / (nh4_affinity + conc[inh4][i]) * conc[ino2][i] / (no2_affinity + conc[ino2][i]) *
-      o2_affinity / (o2_affinity + conc[io2][i]);
-
-      reac[inh4][i] -= 1 / yield * tmp1 * dens[igroup][i];
-      reac[ino2][i] -= ( 1 / yield + 1 / 1.14) * tmp1 * dens[igroup][i];
-      reac[ino3][i] += ( 1 / 1.14 ) * tmp1 * dens[igroup][i];
-      reac[in2][i] += ( 2 / yield ) * tmp1 * dens[igroup][i];
-    }
+  const double *monod_nh4 = grid->monod(inh4, nh4_affinity, 1);
+  const double *monod_no2 = grid->monod(ino2, no2_affinity, 1);
+  const double *inhib_o2 = grid->inhibition(io2, o2_affinity, 1);
+
+  int nocc;
+  const int *occ = grid->occupied(igroup, nocc);
+
+  for (int n = 0; n < nocc; n++) {
+    const int i = occ[n];
+    double tmp1 = growth * monod_nh4[i] * monod_no2[i] * inhib_o2[i];
+
+    reac[inh4][i] -= 1 / yield * tmp1 * dens[igroup][i];
+    reac[ino2][i] -= ( 1 / yield + 1 / 1.14) * tmp1 * dens[igroup][i];
+    reac[ino3][i] += ( 1 / 1.14 ) * tmp1 * dens[igroup][i];
+    reac[in2][i] += ( 2 / yield ) * tmp1 * dens[igroup][i];
   }
 }
 
@@ -121,14 +125,16 @@ void FixGrowthAnammox::update_cells()
 
 void FixGrowthAnammox::update_atoms()
 {
-  double **conc = grid->conc;
+  const double *monod_nh4 = grid->monod(inh4, nh4_affinity);
+  const double *monod_no2 = grid->monod(ino2, no2_affinity);
+  const double *monod_o2 = grid->monod(io2, o2_affinity);
+  const double *inhib_o2 = grid->inhibition(io2, o2_affinity);
 
   for (int i = 0; i < grid->ncells; i++) {
-    double tmp1 = growth * conc[inh4][i] / (nh4_affinity + conc[inh4][i]) * conc[ino2][i] / (no2_affinity + conc[ino2][i]) *
-	o2_affinity / (o2_affinity + conc[io2][i]);
-    double tmp2 = maintain * conc[io2][i] / (o2_affinity + conc[io2][i]);
+    double tmp1 = growth * monod_nh4[i] * monod_no2[i] * inhib_o2[i];
+    double tmp2 = maintain * monod_o2[i];
 
-    grid->growth[igroup][i][0] = tmp1 - tmp2 - decay;
+    grid->growth[igroup][i] = tmp1 - tmp2 - decay;
   }
 
   update_atoms_coccus();
@@ -88,19 +88,23 @@ FixGrowthAOB::FixGrowthAOB(LAMMPS *lmp, int narg, char **arg) :
 
 void FixGrowthAOB::update_cells()
 {
-  double **conc = grid->conc;
   double **reac = grid->reac;
   double **dens = grid->dens;
 
-  for (int i = 0; i < grid->ncells; i++) {
-    if (grid->mask[i] & GRID_MASK) {
-      double tmp1 = growth * conc[inh4][i] / (nh4_affinity + conc[inh4][i]) * conc[io2][i] / (o2_affinity + conc[io2][i]);
-      double tmp2 = maintain * conc[io2][i] / (o2_affinity + conc[io2][i]);
+  const double *monod_nh4 = grid->monod(inh4, nh4_affinity, 1);
+  const double *monod_o2 = grid->monod(io2, o2_affinity, 1);
 
-      reac[inh4][i] -= 1 / yield * tmp1 * dens[igroup][i];
-      reac[io2][i] -= (3.42 - yield) / yield * tmp1 * dens[igroup][i] + tmp2 * dens[igroup][i];
-      reac[ino2][i] += 1 / yield * tmp1 * dens[igroup][i];
-    }
+  int nocc;
+  const int *occ = grid->occupied(igroup, nocc);
+
+  for (int n = 0; n < nocc; n++) {
+    const int i = occ[n];
+    double tmp1 = growth * monod_nh4[i] * monod_o2[i];
+    double tmp2 = maintain * monod_o2[i];
+
+    reac[inh4][i] -= 1 / yield * tmp1 * dens[igroup][i];
+    reac[io2][i] -= (3.42 - yield) / yield * tmp1 * dens[igroup][i] + tmp2 * dens[igroup][i];
+    reac[ino2][i] += 1 / yield * tmp1 * dens[igroup][i];
   }
 }
 
@@ -108,13 +112,14 @@ void FixGrowthAOB::update_cells()
 
 void FixGrowthAOB::update_atoms()
 {
-  double **conc = grid->conc;
+  const double *monod_nh4 = grid->monod(inh4, nh4_affinity);
+  const double *monod_o2 = grid->monod(io2, o2_affinity);
 
   for (int i = 0; i < grid->ncells; i++) {
-    double tmp1 = growth * conc[inh4][i] / (nh4_affinity + conc[inh4][i]) * conc[io2][i] / (o2_affinity + conc[io2][i]);
-    double tmp2 = maintain * conc[io2][i] / (o2_affinity + conc[io2][i]);
+    double tmp1 = growth * monod_nh4[i] * monod_o2[i];
+    double tmp2 = maintain * monod_o2[i];
 
-    grid->growth[igroup][i][0] = tmp1 - tmp2 - decay;
+    grid->growth[igroup][i] = tmp1 - tmp2 - decay;
   }
 
   update_atoms_coccus();
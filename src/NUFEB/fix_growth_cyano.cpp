@@ -110,26 +110,30 @@ FixGrowthCyano::FixGrowthCyano(LAMMPS *lmp, int narg, char **arg) :
 
 void FixGrowthCyano::update_cells()
 {
-  double **conc = grid->conc;
   double **reac = grid->reac;
   double **dens = grid->dens;
 
-  for (int i = 0; i < grid->ncells; i++) {
-    if (grid->mask[i] & GRID_MASK) {
-      // cyanobacterial growth rate based on light(sub) and co2
-      double tmp1 = growth * conc[ilight][i] / (light_affinity + conc[ilight][i]) * conc[ico2][i] / (co2_affinity + conc[ico2][i]);
-      // sucrose export-induced growth reduction
-      double tmp3 = tmp1 * (-3.4897 * exp(-suc_exp/0.048) + 3.4092);
-
-      // nutrient utilization
-      reac[ilight][i] -= 1 / yield * (tmp1 + tmp3) * dens[igroup][i];
-      reac[ico2][i] -= 1 / yield * (tmp1 + tmp3) * dens[igroup][i];
-      reac[io2][i] -= 0.1 * maintain * dens[igroup][i];
-      // oxygen evolution
-      reac[io2][i] +=  (0.727 / yield) * (tmp1 + tmp3) * dens[igroup][i];
-      // sucrose export
-      reac[isuc][i] += 0.65 / yield * tmp3 * dens[igroup][i];
-    }
+  const double *monod_light = grid->monod(ilight, light_affinity, 1);
+  const double *monod_co2 = grid->monod(ico2, co2_affinity, 1);
+
+  int nocc;
+  const int *occ = grid->occupied(igroup, nocc);
+
+  for (int n = 0; n < nocc; n++) {
+    const int i = occ[n];
+    // cyanobacterial growth rate based on light(sub) and co2
+    double tmp1 = growth * monod_light[i] * monod_co2[i];
+    // sucrose export-induced growth reduction
+    double tmp3 = tmp1 * (-3.4897 * exp(-suc_exp/0.048) + 3.4092);
+
+    // nutrient utilization
+    reac[ilight][i] -= 1 / yield * (tmp1 + tmp3) * dens[igroup][i];
+    reac[ico2][i] -= 1 / yield * (tmp1 + tmp3) * dens[igroup][i];
+    reac[io2][i] -= 0.1 * maintain * dens[igroup][i];
+    // oxygen evolution
+    reac[io2][i] +=  (0.727 / yield) * (tmp1 + tmp3) * dens[igroup][i];
+    // sucrose export
+    reac[isuc][i] += 0.65 / yield * tmp3 * dens[igroup][i];
   }
 }
 
@@ -137,17 +141,18 @@ void FixGrowthCyano::update_cells()
 
 void FixGrowthCyano::update_atoms()
 {
-  double **conc = grid->conc;
+  const double *monod_light = grid->monod(ilight, light_affinity);
+  const double *monod_co2 = grid->monod(ico2, co2_affinity);
 
   for (int i = 0; i < grid->ncells; i++) {
     // cyanobacterial growth rate based on light(sub) and co2
-    double tmp1 = growth * conc[ilight][i] / (light_affinity + conc[ilight][i]) * conc[ico2][i] / (co2_affinity + conc[ico2][i]);
+    double tmp1 = growth * monod_light[i] * monod_co2[i];
     // sucrose export-induced growth reduction
     double tmp2 = tmp1 * (0.141 * exp(-suc_exp/0.063) + 0.9);
 
     // double tmp3 = 4 * tmp1 * suc_exp;
 
-    grid->growth[igroup][i][0] = tmp2 - decay - maintain;
+    grid->growth[igroup][i] = tmp2 - decay - maintain;
   }
 
   if (atom->coccus_flag) {
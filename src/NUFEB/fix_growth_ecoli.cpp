@@ -98,22 +98,26 @@ FixGrowthEcoli::FixGrowthEcoli(LAMMPS *lmp, int narg, char **arg) :
 
 void FixGrowthEcoli::update_cells()
 {
-  double **conc = grid->conc;
   double **reac = grid->reac;
   double **dens = grid->dens;
 
-  for (int i = 0; i < grid->ncells; i++) {
-    if (grid->mask[i] & GRID_MASK) {
-      // cyanobacterial growth rate based on light(sub) and co2
-      double tmp1 = growth * conc[isuc][i] / (suc_affinity + conc[isuc][i]) * conc[io2][i] / (o2_affinity + conc[io2][i]);
-      // sucrose export-induced growth reduction
-      double tmp2 = maintain * conc[io2][i] / (o2_affinity + conc[io2][i]);
-
-      // nutrient utilization
-      reac[isuc][i] -= 1 / yield * tmp1 * dens[igroup][i];
-      reac[io2][i] -= 0.399 * (tmp1 + tmp2) * dens[igroup][i];
-      reac[ico2][i] += 0.2 * (tmp1 + tmp2) * dens[igroup][i];
-    }
+  const double *monod_suc = grid->monod(isuc, suc_affinity, 1);
+  const double *monod_o2 = grid->monod(io2, o2_affinity, 1);
+
+  int nocc;
+  const int *occ = grid->occupied(igroup, nocc);
+
+  for (int n = 0; n < nocc; n++) {
+    const int i = occ[n];
+    // cyanobacterial growth rate based on light(sub) and co2
+    double tmp1 = growth * monod_suc[i] * monod_o2[i];
+    // sucrose export-induced growth reduction
+    double tmp2 = maintain * monod_o2[i];
+
+    // nutrient utilization
+    reac[isuc][i] -= 1 / yield * tmp1 * dens[igroup][i];
+    reac[io2][i] -= 0.399 * (tmp1 + tmp2) * dens[igroup][i];
+    reac[ico2][i] += 0.2 * (tmp1 + tmp2) * dens[igroup][i];
   }
 }
 
@@ -121,15 +125,16 @@ void FixGrowthEcoli::update_cells()
 
 void FixGrowthEcoli::update_atoms()
 {
-  double **conc = grid->conc;
+  const double *monod_suc = grid->monod(isuc, suc_affinity);
+  const double *monod_o2 = grid->monod(io2, o2_affinity);
 
   for (int i = 0; i < grid->ncells; i++) {
     // cyanobacterial growth rate based on light(sub) and co2
-    double tmp1 = growth * conc[isuc][i] / (suc_affinity + conc[isuc][i]) * conc[io2][i] / (o2_affinity + conc[io2][i]);
+    double tmp1 = growth * monod_suc[i] * monod_o2[i];
     // sucrose export-induced growth reduction
-    double tmp2 = maintain * conc[io2][i] / (o2_affinity + conc[io2][i]);
+    double tmp2 = maintain * monod_o2[i];
 
-    grid->growth[igroup][i][0] = tmp1 - tmp2 - decay;
+    grid->growth[igroup][i] = tmp1 - tmp2 - decay;
   }
 
   if (atom->coccus_flag) {
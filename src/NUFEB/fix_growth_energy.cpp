@@ -55,6 +55,10 @@ FixGrowthEnergy::FixGrowthEnergy(LAMMPS *lmp, int narg, char **arg) :
   gibbs_cata = nullptr;
   gibbs_anab = nullptr;
   yield = nullptr;
+  qcat = nullptr;
+  logc = nullptr;
+  active = nullptr;
+  nactive = nmax = 0;
 
   sub_gibbs = nullptr;
   ks_coeff = nullptr;
@@ -103,6 +107,13 @@ FixGrowthEnergy::FixGrowthEnergy(LAMMPS *lmp, int narg, char **arg) :
   if (alfa < beta)
     error->all(FLERR, "Illegal alfa and beta values in fix nufeb/growth/energy command");
 
+  // substrates that appear in the uptake rate or in one of the reactions
+  memory->create(active, grid->nsubs, "growth/energy:active");
+  for (int i = 0; i < grid->nsubs; i++) {
+    if (ks_coeff[i] > 0 || cata_coeff[i] != 0 || anab_coeff[i] != 0)
+      active[nactive++] = i;
+  }
+
   avec = (AtomVecBacillus *) atom->style_match("bacillus");
 }
 
@@ -112,6 +123,9 @@ FixGrowthEnergy::~FixGrowthEnergy() {
   memory->destroy(gibbs_cata);
   memory->destroy(gibbs_anab);
   memory->destroy(yield);
+  memory->destroy(qcat);
+  memory->destroy(logc);
+  memory->destroy(active);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -123,28 +137,30 @@ void FixGrowthEnergy::init()
 
   dt = update->dt;
 
-  gibbs_cata = memory->create(gibbs_cata, grid->ncells, "growth/energy:gibbs_cata");
-  gibbs_anab = memory->create(gibbs_anab, grid->ncells, "growth/energy:gibbs_anab");
-  yield = memory->create(yield, grid->ncells, "growth/energy:yield");
+  grow(grid->ncells);
 
+  dgo_cata = dgo_anab = 0.0;
   compute_dgo();
 }
 
-/* ---------------------------------------------------------------------- */
-
-void FixGrowthEnergy::biology_nufeb()
-{
-  if (update->ntimestep % nevery) return;
-    compute_dgr();
-    update_atoms();
-}
-
-/* ---------------------------------------------------------------------- */
+/* ----------------------------------------------------------------------
+   grow per-cell arrays to hold at least n cells
+------------------------------------------------------------------------- */
 
-void FixGrowthEnergy::chemistry_nufeb()
+void FixGrowthEnergy::grow(int n)
 {
-  compute_dgr();
-  update_cells();
+  if (n <= nmax) return;
+  nmax = n;
+  memory->destroy(gibbs_cata);
+  memory->destroy(gibbs_anab);
+  memory->destroy(yield);
+  memory->destroy(qcat);
+  memory->destroy(logc);
+  memory->create(gibbs_cata, nmax, "growth/energy:gibbs_cata");
+  memory->create(gibbs_anab, nmax, "growth/energy:gibbs_anab");
+  memory->create(yield, nmax, "growth/energy:yield");
+  memory->create(qcat, nmax, "growth/energy:qcat");
+  memory->create(logc, MAX(nactive,1), nmax, "growth/energy:logc");
 }
 
 /* ---------------------------------------------------------------------- */
@@ -159,9 +175,15 @@ void FixGrowthEnergy::compute_dgo()
   dgo_anab += biomass_gibbs;
 }
 
-/* ---------------------------------------------------------------------- */
+/* ----------------------------------------------------------------------
+   compute Gibbs free energies and catabolic uptake rates of n cells,
+   given by list or cells 0 to n-1 if list is null. results are stored
+   at the position of each cell in the list. reaction quotients are
+   evaluated in log space, log Q = sum coeff * log(c/mw), with log(c/mw)
+   computed once per substrate and shared by both reactions
+------------------------------------------------------------------------- */
 
-void FixGrowthEnergy::compute_dgr()
+void FixGrowthEnergy::compute_dgr(int n, const int *list)
 {
   double *mw = grid->mw;
   double rt = temp * GAS_CONST;
@@ -172,51 +194,51 @@ void FixGrowthEnergy::compute_dgr()
   else
     conc = grid->act;
 
-  for (int i = 0; i < grid->ncells; i++) {
-    if (grid->mask[i] & BLAYER_MASK) continue;
-    // standard Gibbs free energy
-    gibbs_cata[i] = dgo_cata;
-    gibbs_anab[i] = dgo_anab;
-
-    double q_cata = 1.0;
-    double q_anab = 1.0;
-
-    // compute catabolic and anabolic reaction quotient Q
-    for (int j = 0; j < grid->nsubs; j++) {
-      if (conc[j][i] <= 0) continue;
-
-      // convert concentrations from kg/m3 to mol/L
-      if (cata_coeff[j] > 0) {
-        q_cata *= pow(conc[j][i]/mw[j], cata_coeff[j]);
-      } else if (cata_coeff[j] < 0) {
-        q_cata /= pow(conc[j][i]/mw[j], -cata_coeff[j]);
-      }
+  grow(n);
 
-      if (anab_coeff[j] > 0) {
-        q_anab *= pow(conc[j][i]/mw[j], anab_coeff[j]);
-      } else if (anab_coeff[j] < 0) {
-        q_anab /= pow(conc[j][i]/mw[j], -anab_coeff[j]);
-      }
+  // gather concentrations of the active substrates
+  for (int k = 0; k < nactive; k++) {
+    const double *c = conc[active[k]];
+    double * _noalias const lc = logc[k];
+    if (list) {
+      for (int m = 0; m < n; m++) lc[m] = c[list[m]];
+    } else {
+      for (int m = 0; m < n; m++) lc[m] = c[m];
     }
-
-    // Gibbs free energy
-    gibbs_cata[i] += rt * log(q_cata);
-    gibbs_anab[i] += rt * log(q_anab);
   }
-}
-
-/* ---------------------------------------------------------------------- */
 
-double FixGrowthEnergy::compute_monod(int cell, double **conc)
-{
-  double monod = 1.0;
+  // specific substrate uptake rate for catabolism
+  // unit mol-eD/mol-X·s
+  for (int m = 0; m < n; m++) qcat[m] = uptake;
+  for (int k = 0; k < nactive; k++) {
+    const double ks = ks_coeff[active[k]];
+    if (ks <= 0) continue;
+    const double * _noalias const c = logc[k];
+    for (int m = 0; m < n; m++) qcat[m] *= c[m] / (ks + c[m]);
+  }
 
-  for (int i = 0; i < grid->nsubs; i++) {
-    if (ks_coeff[i] > 0)
-      monod *= conc[i][cell] / (ks_coeff[i] + conc[i][cell]);
+  // standard Gibbs free energy
+  for (int m = 0; m < n; m++) {
+    gibbs_cata[m] = dgo_cata;
+    gibbs_anab[m] = dgo_anab;
   }
 
-  return monod;
+  // Gibbs free energy from catabolic and anabolic reaction quotient Q
+  for (int k = 0; k < nactive; k++) {
+    const int j = active[k];
+    const double rt_cata = rt * cata_coeff[j];
+    const double rt_anab = rt * anab_coeff[j];
+    if (rt_cata == 0.0 && rt_anab == 0.0) continue;
+
+    // convert concentrations from kg/m3 to mol/L
+    const double log_mw = log(mw[j]);
+    double * _noalias const lc = logc[k];
+    for (int m = 0; m < n; m++) {
+      lc[m] = lc[m] > 0 ? log(lc[m]) - log_mw : 0.0;
+      gibbs_cata[m] += rt_cata * lc[m];
+      gibbs_anab[m] += rt_anab * lc[m];
+    }
+  }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -226,15 +248,15 @@ void FixGrowthEnergy::update_cells()
   double **reac = grid->reac;
   double **dens = grid->dens;
   double *mw = grid->mw;
-  double **conc;
+  const int nsubs = grid->nsubs;
 
-  if (grid->act == nullptr)
-    conc = grid->conc;
-  else
-    conc = grid->act;
+  int nocc;
+  const int *occ = grid->occupied(igroup, nocc);
 
-  for (int i = 0; i < grid->ncells; i++) {
-    if (!(grid->mask[i] & GRID_MASK)) continue;
+  compute_dgr(nocc, occ);
+
+  for (int n = 0; n < nocc; n++) {
+    const int i = occ[n];
 
     double inv_yield;
     double spec_growth;
@@ -242,38 +264,34 @@ void FixGrowthEnergy::update_cells()
     double meta_coeff;
 
     // yield unit = mol-X/mol-eD
-    yield[i] = -gibbs_cata[i] / (gibbs_anab[i] + dissipation);
+    yield[n] = -gibbs_cata[n] / (gibbs_anab[n] + dissipation);
 
     // inverse yield
-    if (yield[i] != 0.0)
-      inv_yield = 1 / yield[i];
+    if (yield[n] != 0.0)
+      inv_yield = 1 / yield[n];
     else
       inv_yield = 0.0;
 
-    // Specific substrate uptake rate for catabolism
-    // unit mol-eD/mol-X·s
-    q_cat = uptake * compute_monod(i, conc);
+    q_cat = qcat[n];
     // specific substrate consumption required for maintenance
     // unit = mol-eD / mol-X·s
-    m_req = -MAINT_ENERGY / gibbs_cata[i];
-    spec_growth = (q_cat - m_req) * yield[i];
+    m_req = -MAINT_ENERGY / gibbs_cata[n];
+    spec_growth = (q_cat - m_req) * yield[n];
 
     // update substrate reaction term
-    for (int j = 0; j < grid->nsubs; j++) {
-      // unit conversion mol/L to kg/m3
-      double mol2kg = mw[j] / mw_biomass;
-
-      if (q_cat > alfa * m_req) {
-        meta_coeff = inv_yield * cata_coeff[j]  + anab_coeff[j];
-        reac[j][i] += spec_growth * meta_coeff * dens[igroup][i] * mol2kg;
-
-      } else if (q_cat <= alfa * m_req && q_cat >= beta * m_req) {
-        reac[j][i] += spec_growth * cata_coeff[j]  * dens[igroup][i] * mol2kg;
-
-      } else if (q_cat < beta * m_req) {
-        reac[j][i] -= spec_growth * decay_coeff[j] * dens[igroup][i] * mol2kg;
-
+    // unit conversion mol/L to kg/m3
+    const double x = spec_growth * dens[igroup][i] / mw_biomass;
+    if (q_cat > alfa * m_req) {
+      for (int j = 0; j < nsubs; j++) {
+        meta_coeff = inv_yield * cata_coeff[j] + anab_coeff[j];
+        reac[j][i] += x * meta_coeff * mw[j];
       }
+    } else if (q_cat <= alfa * m_req && q_cat >= beta * m_req) {
+      for (int j = 0; j < nsubs; j++)
+        reac[j][i] += x * cata_coeff[j] * mw[j];
+    } else if (q_cat < beta * m_req) {
+      for (int j = 0; j < nsubs; j++)
+        reac[j][i] -= x * decay_coeff[j] * mw[j];
     }
   }
 }
@@ -282,12 +300,7 @@ void FixGrowthEnergy::update_cells()
 
 void FixGrowthEnergy::update_atoms()
 {
-  double **conc;
-
-  if (grid->act == nullptr)
-    conc = grid->conc;
-  else
-    conc = grid->act;
+  compute_dgr(grid->ncells, nullptr);
 
   for (int i = 0; i < grid->ncells; i++) {
     double spec_growth;
@@ -295,22 +308,20 @@ void FixGrowthEnergy::update_atoms()
     // yield unit = mol-X/mol-eD
     yield[i] = -gibbs_cata[i] / (gibbs_anab[i] + dissipation);
 
-    // specific substrate uptake rate for catabolism
-    // unit mole-eD/mol-x·s
-    q_cat = uptake * compute_monod(i, conc);
+    q_cat = qcat[i];
     // specific substrate consumption required for maintenance
     // unit = mol-eD / mol-X·s
     m_req = -MAINT_ENERGY / gibbs_cata[i];
     spec_growth = (q_cat - m_req) * yield[i];
 
     if (q_cat > alfa * m_req) {
-      grid->growth[igroup][i][0] = spec_growth;
+      grid->growth[igroup][i] = spec_growth;
 
     } else if (q_cat <= alfa * m_req && q_cat >= beta * m_req) {
-      grid->growth[igroup][i][0] = 0.0;
+      grid->growth[igroup][i] = 0.0;
 
     } else if (q_cat < beta * m_req) {
-      grid->growth[igroup][i][0] = -decay * (m_req - q_cat) / m_req;
+      grid->growth[igroup][i] = -decay * (m_req - q_cat) / m_req;
     }
   }
 
@@ -320,4 +331,3 @@ void FixGrowthEnergy::update_atoms()
     update_atoms_bacillus(avec);
   }
 }
-
@@ -29,8 +29,6 @@ class FixGrowthEnergy: public FixGrowth {
   FixGrowthEnergy(class LAMMPS *, int, char **);
   virtual ~FixGrowthEnergy();
 
-  void biology_nufeb();
-  void chemistry_nufeb();
   virtual void update_atoms();
   virtual void update_cells();
 
@@ -56,13 +54,19 @@ class FixGrowthEnergy: public FixGrowth {
   double *gibbs_cata;            // Gibbs free energy for catabolic reaction
   double *gibbs_anab;            // Gibbs free energy for anabolic reaction
   double *yield;
+  double *qcat;                  // specific catabolic uptake rate
   double alfa, beta;
 
+  int nactive;                   // # of substrates in the reactions
+  int *active;                   // index of each substrate in the reactions
+  double **logc;                 // log(c/mw) of each active substrate
+  int nmax;
+
   class AtomVecBacillus *avec;
 
   void compute_dgo();
-  void compute_dgr();
-  double compute_monod(int, double **);
+  void compute_dgr(int, const int *);
+  void grow(int);
 };
 
 }
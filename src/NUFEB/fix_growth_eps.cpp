@@ -63,10 +63,12 @@ void FixGrowthEPS::update_cells()
   double **reac = grid->reac;
   double **dens = grid->dens;
 
-  for (int i = 0; i < grid->ncells; i++) {
-    if (grid->mask[i] & GRID_MASK) {
-      reac[isub][i] += decay * dens[igroup][i];
-    }
+  int nocc;
+  const int *occ = grid->occupied(igroup, nocc);
+
+  for (int n = 0; n < nocc; n++) {
+    const int i = occ[n];
+    reac[isub][i] += decay * dens[igroup][i];
   }
 }
 
@@ -75,7 +77,7 @@ void FixGrowthEPS::update_cells()
 void FixGrowthEPS::update_atoms()
 {
   for (int i = 0; i < grid->ncells; i++) {
-    grid->growth[igroup][i][0] = -decay;
+    grid->growth[igroup][i] = -decay;
   }
 
   update_atoms_coccus();
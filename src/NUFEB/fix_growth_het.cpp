@@ -115,24 +115,31 @@ FixGrowthHET::FixGrowthHET(LAMMPS *lmp, int narg, char **arg) :
 
 void FixGrowthHET::update_cells()
 {
-  double **conc = grid->conc;
   double **reac = grid->reac;
   double **dens = grid->dens;
 
-  for (int i = 0; i < grid->ncells; i++) {
-    if (grid->mask[i] & GRID_MASK) {
-      double tmp1 = growth * conc[isub][i] / (sub_affinity + conc[isub][i]) * conc[io2][i] / (o2_affinity + conc[io2][i]);
-      double tmp2 = anoxic * growth * conc[isub][i] / (sub_affinity + conc[isub][i]) * conc[ino3][i] / (no3_affinity + conc[ino3][i]) * o2_affinity / (o2_affinity + conc[io2][i]);
-      double tmp3 = anoxic * growth * conc[isub][i] / (sub_affinity + conc[isub][i]) * conc[ino2][i] / (no2_affinity + conc[ino2][i]) * o2_affinity / (o2_affinity + conc[io2][i]);
-      double tmp4 = maintain * conc[io2][i] / (o2_affinity + conc[io2][i]);
-      double tmp5 = 1 / 2.86 * maintain * anoxic * conc[ino3][i] / (no3_affinity + conc[ino3][i]) * o2_affinity / (o2_affinity + conc[io2][i]);
-      double tmp6 = 1 / 1.17 * maintain * anoxic * conc[ino2][i] / (no2_affinity + conc[ino2][i]) * o2_affinity / (o2_affinity + conc[io2][i]);
-
-      reac[isub][i] -= 1 / yield * (tmp1 + tmp2 + tmp3) * dens[igroup][i];
-      reac[io2][i] -= (1 - yield - eps_yield) / yield * tmp1 * dens[igroup][i] + tmp4 * dens[igroup][i];
-      reac[ino2][i] -= (1 - yield - eps_yield) / (1.17 * yield) * tmp3 * dens[igroup][i] + tmp6 * dens[igroup][i];
-      reac[ino3][i] -= (1 - yield - eps_yield) / (2.86 * yield) * tmp2 * dens[igroup][i] + tmp5 * dens[igroup][i];
-    }
+  const double *monod_sub = grid->monod(isub, sub_affinity, 1);
+  const double *monod_o2 = grid->monod(io2, o2_affinity, 1);
+  const double *monod_no3 = grid->monod(ino3, no3_affinity, 1);
+  const double *monod_no2 = grid->monod(ino2, no2_affinity, 1);
+  const double *inhib_o2 = grid->inhibition(io2, o2_affinity, 1);
+
+  int nocc;
+  const int *occ = grid->occupied(igroup, nocc);
+
+  for (int n = 0; n < nocc; n++) {
+    const int i = occ[n];
+    double tmp1 = growth * monod_sub[i] * monod_o2[i];
+    double tmp2 = anoxic * growth * monod_sub[i] * monod_no3[i] * inhib_o2[i];
+    double tmp3 = anoxic * growth * monod_sub[i] * monod_no2[i] * inhib_o2[i];
+    double tmp4 = maintain * monod_o2[i];
+    double tmp5 = 1 / 2.86 * maintain * anoxic * monod_no3[i] * inhib_o2[i];
+    double tmp6 = 1 / 1.17 * maintain * anoxic * monod_no2[i] * inhib_o2[i];
+
+    reac[isub][i] -= 1 / yield * (tmp1 + tmp2 + tmp3) * dens[igroup][i];
+    reac[io2][i] -= (1 - yield - eps_yield) / yield * tmp1 * dens[igroup][i] + tmp4 * dens[igroup][i];
+    reac[ino2][i] -= (1 - yield - eps_yield) / (1.17 * yield) * tmp3 * dens[igroup][i] + tmp6 * dens[igroup][i];
+    reac[ino3][i] -= (1 - yield - eps_yield) / (2.86 * yield) * tmp2 * dens[igroup][i] + tmp5 * dens[igroup][i];
   }
 }
 
@@ -140,41 +147,47 @@ void FixGrowthHET::update_cells()
 
 void FixGrowthHET::update_atoms()
 {
-  double **x = atom->x;
   double *radius = atom->radius;
   double *rmass = atom->rmass;
   double *biomass = atom->biomass;
   double *outer_radius = atom->outer_radius;
   double *outer_mass = atom->outer_mass;
-  double **conc = grid->conc;
 
   const double three_quarters_pi = (3.0 / (4.0 * MY_PI));
   const double four_thirds_pi = 4.0 * MY_PI / 3.0;
   const double third = 1.0 / 3.0;
 
+  const double *monod_sub = grid->monod(isub, sub_affinity);
+  const double *monod_o2 = grid->monod(io2, o2_affinity);
+  const double *monod_no3 = grid->monod(ino3, no3_affinity);
+  const double *monod_no2 = grid->monod(ino2, no2_affinity);
+  const double *inhib_o2 = grid->inhibition(io2, o2_affinity);
+
   for (int i = 0; i < grid->ncells; i++) {
-    double tmp1 = growth * conc[isub][i] / (sub_affinity + conc[isub][i]) * conc[io2][i] / (o2_affinity + conc[io2][i]);
-    double tmp2 = anoxic * growth * conc[isub][i] / (sub_affinity + conc[isub][i]) * conc[ino3][i] / (no3_affinity + conc[ino3][i]) * o2_affinity / (o2_affinity + conc[io2][i]);
-    double tmp3 = anoxic * growth * conc[isub][i] / (sub_affinity + conc[isub][i]) * conc[ino2][i] / (no2_affinity + conc[ino2][i]) * o2_affinity / (o2_affinity + conc[io2][i]);
-    double tmp4 = maintain * conc[io2][i] / (o2_affinity + conc[io2][i]);
-    double tmp5 = 1 / 2.86 * maintain * anoxic * conc[ino3][i] / (no3_affinity + conc[ino3][i]) * o2_affinity / (o2_affinity + conc[io2][i]);
-    double tmp6 = 1 / 1.17 * maintain * anoxic * conc[ino2][i] / (no2_affinity + conc[ino2][i]) * o2_affinity / (o2_affinity + conc[io2][i]);
-
-    grid->growth[igroup][i][0] = tmp1 + tmp2 + tmp3 - tmp4 - tmp5 - tmp6 - decay;
-    grid->growth[igroup][i][1] = (eps_yield / yield) * (tmp1 + tmp2 + tmp3);
+    double tmp1 = growth * monod_sub[i] * monod_o2[i];
+    double tmp2 = anoxic * growth * monod_sub[i] * monod_no3[i] * inhib_o2[i];
+    double tmp3 = anoxic * growth * monod_sub[i] * monod_no2[i] * inhib_o2[i];
+    double tmp4 = maintain * monod_o2[i];
+    double tmp5 = 1 / 2.86 * maintain * anoxic * monod_no3[i] * inhib_o2[i];
+    double tmp6 = 1 / 1.17 * maintain * anoxic * monod_no2[i] * inhib_o2[i];
+
+    grid->growth[igroup][i] = tmp1 + tmp2 + tmp3 - tmp4 - tmp5 - tmp6 - decay;
+    grid->eps_rate[igroup][i] = (eps_yield / yield) * (tmp1 + tmp2 + tmp3);
   }
 
+  int *cells = grid->atom_cells();
   for (int i = 0; i < atom->nlocal; i++) {
     if (atom->mask[i] & groupbit) {
-      const int cell = grid->cell(x[i]);
+      const int cell = cells[i];
       const double density = rmass[i] /
           (four_thirds_pi * radius[i] * radius[i] * radius[i]);
-      // forward Euler to update biomass and rmass
-      rmass[i] = rmass[i] * (1 + grid->growth[igroup][cell][0] * dt);
+      // forward Euler or exponential update of biomass and rmass
+      const double growth_dt = grid->growth[igroup][cell] * dt;
+      rmass[i] = rmass[i] * (exp_flag ? exp(growth_dt) : 1 + growth_dt);
 
       if (eps_flag) {
         outer_mass[i] = four_thirds_pi * (outer_radius[i] * outer_radius[i] * outer_radius[i] -
-            radius[i] * radius[i] * radius[i]) * eps_dens + grid->growth[igroup][cell][1] * rmass[i] * dt;
+            radius[i] * radius[i] * radius[i]) * eps_dens + grid->eps_rate[igroup][cell] * rmass[i] * dt;
 
         outer_radius[i] = pow(three_quarters_pi * (rmass[i] / density + outer_mass[i] / eps_dens), third);
       }
@@ -85,17 +85,20 @@ FixGrowthMonod::FixGrowthMonod(LAMMPS *lmp, int narg, char **arg) :
 
 void FixGrowthMonod::update_cells()
 {
-  double **conc = grid->conc;
   double **reac = grid->reac;
   double **dens = grid->dens;
 
-  for (int i = 0; i < grid->ncells; i++) {
-    if (grid->mask[i] & GRID_MASK) {
-      double tmp1 = growth * conc[isub][i] / (sub_affinity + conc[isub][i]);
+  const double *monod_sub = grid->monod(isub, sub_affinity, 1);
 
-      // nutrient utilization
-      reac[isub][i] -= 1 / yield * tmp1 * dens[igroup][i];
-    }
+  int nocc;
+  const int *occ = grid->occupied(igroup, nocc);
+
+  for (int n = 0; n < nocc; n++) {
+    const int i = occ[n];
+    double tmp1 = growth * monod_sub[i];
+
+    // nutrient utilization
+    reac[isub][i] -= 1 / yield * tmp1 * dens[igroup][i];
   }
 }
 
@@ -103,12 +106,12 @@ void FixGrowthMonod::update_cells()
 
 void FixGrowthMonod::update_atoms()
 {
-  double **conc = grid->conc;
+  const double *monod_sub = grid->monod(isub, sub_affinity);
 
   for (int i = 0; i < grid->ncells; i++) {
-    double tmp1 = growth * conc[isub][i] / (sub_affinity + conc[isub][i]);
+    double tmp1 = growth * monod_sub[i];
 
-    grid->growth[igroup][i][0] = tmp1 - decay;
+    grid->growth[igroup][i] = tmp1 - decay;
   }
 
   if (atom->coccus_flag) {
@@ -0,0 +1,289 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "fix_growth_network.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "atom.h"
+#include "comm.h"
+#include "error.h"
+#include "grid.h"
+#include "group.h"
+#include "memory.h"
+#include "atom_vec_bacillus.h"
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+/* ---------------------------------------------------------------------- */
+
+FixGrowthNetwork::FixGrowthNetwork(LAMMPS *lmp, int narg, char **arg) :
+  FixGrowth(lmp, narg, arg)
+{
+  if (narg != 4)
+    error->all(FLERR, "Illegal fix nufeb/growth/network command");
+
+  if (!grid->chemostat_flag)
+    error->all(FLERR, "fix nufeb/growth/network requires grid_style nufeb/chemostat");
+
+  nprocess = nfactor = nstoich = ngroups = 0;
+  proc_group = nullptr;
+  proc_rate = nullptr;
+  proc_biomass = nullptr;
+  fac_first = nullptr;
+  fac_sub = nullptr;
+  fac_k = nullptr;
+  fac_kind = nullptr;
+  fac = nullptr;
+  sto_first = nullptr;
+  sto_sub = nullptr;
+  sto_coeff = nullptr;
+  groups = nullptr;
+
+  read_file(arg[3]);
+
+  avec = (AtomVecBacillus *) atom->style_match("bacillus");
+}
+
+/* ---------------------------------------------------------------------- */
+
+FixGrowthNetwork::~FixGrowthNetwork()
+{
+  memory->destroy(proc_group);
+  memory->destroy(proc_rate);
+  memory->destroy(proc_biomass);
+  memory->destroy(fac_first);
+  memory->destroy(fac_sub);
+  memory->destroy(fac_k);
+  memory->destroy(fac_kind);
+  memory->sfree(fac);
+  memory->destroy(sto_first);
+  memory->destroy(sto_sub);
+  memory->destroy(sto_coeff);
+  memory->destroy(groups);
+}
+
+/* ----------------------------------------------------------------------
+   read the network file on proc 0, broadcast it and compile the
+   processes into flat arrays of rate factors and stoichiometric terms
+------------------------------------------------------------------------- */
+
+void FixGrowthNetwork::read_file(const char *file)
+{
+  std::string text;
+  int n = 0;
+  if (comm->me == 0) {
+    FILE *fp = fopen(file, "r");
+    if (fp == nullptr)
+      error->one(FLERR, fmt::format("Cannot open network file {}", file));
+    char buf[BUFSIZ];
+    size_t len;
+    while ((len = fread(buf, 1, BUFSIZ, fp)) > 0) text.append(buf, len);
+    fclose(fp);
+    n = text.size();
+  }
+  MPI_Bcast(&n, 1, MPI_INT, 0, world);
+  text.resize(n);
+  MPI_Bcast(&text[0], n, MPI_CHAR, 0, world);
+
+  std::vector<int> pgroup, fsub, fkind, ffirst, ssub, sfirst;
+  std::vector<double> prate, pbio, fk, scoeff;
+  int inside = 0;
+
+  for (auto &line : utils::split_lines(text)) {
+    std::vector<std::string> words = utils::split_words(utils::trim_comment(line));
+    if (words.empty()) continue;
+    const std::string &key = words[0];
+    const int nwords = words.size();
+
+    if (key == "process") {
+      if (inside || nwords != 4)
+        error->all(FLERR, "Invalid network file: " + line);
+      int ig = group->find(words[2]);
+      if (ig < 0)
+        error->all(FLERR, "Can't find group " + words[2] + " in network file");
+      pgroup.push_back(ig);
+      prate.push_back(utils::numeric(FLERR,words[3],true,lmp));
+      pbio.push_back(0.0);
+      ffirst.push_back(fsub.size());
+      sfirst.push_back(ssub.size());
+      inside = 1;
+    } else if (key == "end") {
+      if (!inside || nwords != 1)
+        error->all(FLERR, "Invalid network file: " + line);
+      inside = 0;
+    } else if (!inside) {
+      error->all(FLERR, "Invalid network file: " + line);
+    } else if (key == "monod" || key == "inhibit") {
+      if (nwords != 3)
+        error->all(FLERR, "Invalid network file: " + line);
+      int isub = grid->find(words[1].c_str());
+      if (isub < 0)
+        error->all(FLERR, "Can't find substrate name " + words[1] + " in network file");
+      double k = utils::numeric(FLERR,words[2],true,lmp);
+      if (k <= 0.0)
+        error->all(FLERR, "Invalid network file: " + line);
+      fsub.push_back(isub);
+      fk.push_back(k);
+      fkind.push_back(key == "inhibit");
+    } else if (key == "biomass") {
+      if (nwords != 2)
+        error->all(FLERR, "Invalid network file: " + line);
+      pbio.back() = utils::numeric(FLERR,words[1],true,lmp);
+    } else if (key == "stoich") {
+      if (nwords < 3 || nwords % 2 == 0)
+        error->all(FLERR, "Invalid network file: " + line);
+      for (int w = 1; w < nwords; w += 2) {
+        int isub = grid->find(words[w].c_str());
+        if (isub < 0)
+          error->all(FLERR, "Can't find substrate name " + words[w] + " in network file");
+        ssub.push_back(isub);
+        scoeff.push_back(utils::numeric(FLERR,words[w+1],true,lmp));
+      }
+    } else {
+      error->all(FLERR, "Invalid network file: " + line);
+    }
+  }
+  if (inside || pgroup.empty())
+    error->all(FLERR, "Invalid network file: missing process or end");
+
+  nprocess = pgroup.size();
+  nfactor = fsub.size();
+  nstoich = ssub.size();
+
+  memory->create(proc_group, nprocess, "nufeb/growth/network:proc_group");
+  memory->create(proc_rate, nprocess, "nufeb/growth/network:proc_rate");
+  memory->create(proc_biomass, nprocess, "nufeb/growth/network:proc_biomass");
+  memory->create(fac_first, nprocess+1, "nufeb/growth/network:fac_first");
+  memory->create(sto_first, nprocess+1, "nufeb/growth/network:sto_first");
+  memory->create(fac_sub, MAX(nfactor,1), "nufeb/growth/network:fac_sub");
+  memory->create(fac_k, MAX(nfactor,1), "nufeb/growth/network:fac_k");
+  memory->create(fac_kind, MAX(nfactor,1), "nufeb/growth/network:fac_kind");
+  memory->create(sto_sub, MAX(nstoich,1), "nufeb/growth/network:sto_sub");
+  memory->create(sto_coeff, MAX(nstoich,1), "nufeb/growth/network:sto_coeff");
+  fac = (const double **)
+    memory->smalloc(MAX(nfactor,1)*sizeof(double *), "nufeb/growth/network:fac");
+  memory->create(groups, nprocess, "nufeb/growth/network:groups");
+
+  for (int p = 0; p < nprocess; p++) {
+    proc_group[p] = pgroup[p];
+    proc_rate[p] = prate[p];
+    proc_biomass[p] = pbio[p];
+    fac_first[p] = ffirst[p];
+    sto_first[p] = sfirst[p];
+
+    int g;
+    for (g = 0; g < ngroups; g++)
+      if (groups[g] == pgroup[p]) break;
+    if (g == ngroups) {
+      groups[ngroups++] = pgroup[p];
+      grid->add_group(pgroup[p]);
+    }
+  }
+  fac_first[nprocess] = nfactor;
+  sto_first[nprocess] = nstoich;
+
+  for (int f = 0; f < nfactor; f++) {
+    fac_sub[f] = fsub[f];
+    fac_k[f] = fk[f];
+    fac_kind[f] = fkind[f];
+  }
+  for (int s = 0; s < nstoich; s++) {
+    sto_sub[s] = ssub[s];
+    sto_coeff[s] = scoeff[s];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   fetch the rate factors from the grid, in the occupied cells only
+   if flag is set
+------------------------------------------------------------------------- */
+
+void FixGrowthNetwork::factors(int flag)
+{
+  for (int f = 0; f < nfactor; f++) {
+    if (fac_kind[f]) fac[f] = grid->inhibition(fac_sub[f], fac_k[f], flag);
+    else fac[f] = grid->monod(fac_sub[f], fac_k[f], flag);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   single pass over the occupied cells for all processes. the rate of
+   process p in cell i is rate_p * dens_p * product of its factors
+------------------------------------------------------------------------- */
+
+void FixGrowthNetwork::update_cells()
+{
+  double **reac = grid->reac;
+  double **dens = grid->dens;
+
+  factors(1);
+
+  int nocc;
+  const int *occ = grid->occupied(0, nocc);
+
+  for (int n = 0; n < nocc; n++) {
+    const int i = occ[n];
+    for (int p = 0; p < nprocess; p++) {
+      const double d = dens[proc_group[p]][i];
+      if (d == 0.0) continue;
+      double r = proc_rate[p] * d;
+      for (int f = fac_first[p]; f < fac_first[p+1]; f++)
+        r *= fac[f][i];
+      for (int s = sto_first[p]; s < sto_first[p+1]; s++)
+        reac[sto_sub[s]][i] += sto_coeff[s] * r;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   specific growth rate of each group is the sum of the biomass
+   terms of its processes
+------------------------------------------------------------------------- */
+
+void FixGrowthNetwork::update_atoms()
+{
+  double **growth = grid->growth;
+
+  factors(0);
+
+  for (int i = 0; i < grid->ncells; i++) {
+    for (int g = 0; g < ngroups; g++)
+      growth[groups[g]][i] = 0.0;
+    for (int p = 0; p < nprocess; p++) {
+      double r = proc_biomass[p] * proc_rate[p];
+      for (int f = fac_first[p]; f < fac_first[p+1]; f++)
+        r *= fac[f][i];
+      growth[proc_group[p]][i] += r;
+    }
+  }
+
+  // update the atoms of each group with the helpers of FixGrowth
+
+  const int igroup_saved = igroup;
+  const int groupbit_saved = groupbit;
+  for (int g = 0; g < ngroups; g++) {
+    igroup = groups[g];
+    groupbit = group->bitmask[igroup];
+    if (atom->coccus_flag) {
+      update_atoms_coccus();
+    } else {
+      update_atoms_bacillus(avec);
+    }
+  }
+  igroup = igroup_saved;
+  groupbit = groupbit_saved;
+}
@@ -0,0 +1,87 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+
+FixStyle(nufeb/growth/network,FixGrowthNetwork)
+
+#else
+
+#ifndef LMP_FIX_GROWTH_NETWORK_H
+#define LMP_FIX_GROWTH_NETWORK_H
+
+#include "fix_growth.h"
+
+namespace LAMMPS_NS {
+
+class FixGrowthNetwork: public FixGrowth {
+ public:
+  FixGrowthNetwork(class LAMMPS *, int, char **);
+  virtual ~FixGrowthNetwork();
+
+  virtual void update_atoms();
+  virtual void update_cells();
+
+ protected:
+  int nprocess;                 // # of processes
+  int *proc_group;              // group of each process
+  double *proc_rate;            // maximum rate of each process
+  double *proc_biomass;         // biomass coefficient of each process
+
+  int nfactor;                  // # of rate factors of all processes
+  int *fac_first;               // first factor of each process
+  int *fac_sub;                 // substrate of each factor
+  double *fac_k;                // affinity of each factor
+  int *fac_kind;                // 0 = Monod, 1 = inhibition
+  const double **fac;           // values of each factor in all cells
+
+  int nstoich;                  // # of stoichiometric terms of all processes
+  int *sto_first;               // first term of each process
+  int *sto_sub;                 // substrate of each term
+  double *sto_coeff;            // coefficient of each term
+
+  int ngroups;                  // # of groups with at least one process
+  int *groups;
+
+  class AtomVecBacillus *avec;
+
+  void read_file(const char *);
+  void factors(int);
+};
+
+}
+
+#endif
+#endif
+
+/* ERROR/WARNING messages:
+
+E: Illegal fix nufeb/growth/network command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.
+
+E: Cannot open network file
+
+The file specified by fix nufeb/growth/network cannot be opened.
+
+E: Invalid network file
+
+A line of the network file is not valid. Check the file syntax
+and compare to the documentation for the command.
+
+E: Can't find substrate name %s in network file
+
+The substrate used in the network file is not defined by grid_style.
+
+*/
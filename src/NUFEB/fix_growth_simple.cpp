@@ -57,7 +57,7 @@ FixGrowthSimple::FixGrowthSimple(LAMMPS *lmp, int narg, char **arg) :
 void FixGrowthSimple::update_atoms()
 {
   for (int i = 0; i < grid->ncells; i++) {
-    grid->growth[igroup][i][0] = growth;
+    grid->growth[igroup][i] = growth;
   }
 
   if (atom->coccus_flag) {
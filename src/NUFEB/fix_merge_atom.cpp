@@ -22,6 +22,7 @@
 #include "neighbor.h"
 #include "pair.h"
 #include "update.h"
+#include "grid.h"
 #include "memory.h"
 #include "force.h"
 #include "math_const.h"
@@ -98,6 +99,8 @@ void FixMergeAtom::biology_nufeb()
 {
   if (update->ntimestep % nevery) return;
   compute();
+  // atoms have been moved or created
+  grid->reset_atom_cells();
   // trigger immediate reneighboring
   next_reneighbor = update->ntimestep;
 }
@@ -31,7 +31,7 @@ class FixNVEBacillus : public FixNVE {
   virtual void initial_integrate(int);
   virtual void final_integrate();
 
- private:
+ protected:
   double dtq;
   class AtomVecBacillus *avec;
 };
@@ -23,6 +23,7 @@
 #include "modify.h"
 #include "grid_masks.h"
 #include "comm.h"
+#include "update.h"
 
 using namespace LAMMPS_NS;
 using namespace FixConst;
@@ -46,6 +47,25 @@ FixPH::FixPH(LAMMPS *lmp, int narg, char **arg) :
 
   keq = nullptr;
   act_all = nullptr;
+  sh = nullptr;
+
+  nmax = 0;
+  active = nullptr;
+  f = df = nullptr;
+  gsh = nullptr;
+
+  ntable = 0;
+  ttol = 1e-2;
+  tlog = nullptr;
+  tabled = nullptr;
+  fscale = nullptr;
+
+  phevery = -1;
+  phcount = 0;
+  phstep = -1;
+  conctol = 0.0;
+  conc_last = nullptr;
+  nmax_last = 0;
 
   buff_flag = 0;
   ina = -1;
@@ -92,10 +112,43 @@ FixPH::FixPH(LAMMPS *lmp, int narg, char **arg) :
       if (phlo < 0 || phhi > 14 || phlo > phhi)
         error->all(FLERR, "Illegal fix nufeb/ph command: phlo, phhi");
       iarg += 5;
+    } else if (strcmp(arg[iarg], "table") == 0) {
+      if (iarg + 5 > narg) error->all(FLERR, "Illegal fix nufeb/ph command");
+      if (ntable == 2)
+        error->all(FLERR, "Illegal fix nufeb/ph command: at most two table keywords");
+      tsub[ntable] = grid->find(arg[iarg + 1]);
+      if (tsub[ntable] < 0)
+        error->all(FLERR, "Can't find substrate name: table");
+      tlo[ntable] = utils::numeric(FLERR, arg[iarg + 2], true, lmp);
+      thi[ntable] = utils::numeric(FLERR, arg[iarg + 3], true, lmp);
+      tn[ntable] = utils::inumeric(FLERR, arg[iarg + 4], true, lmp);
+      if (tlo[ntable] < 0 || thi[ntable] <= tlo[ntable] || tn[ntable] < 2)
+        error->all(FLERR, "Illegal fix nufeb/ph command: table");
+      ntable++;
+      iarg += 5;
+    } else if (strcmp(arg[iarg], "tabletol") == 0) {
+      if (iarg + 2 > narg) error->all(FLERR, "Illegal fix nufeb/ph command");
+      ttol = utils::numeric(FLERR, arg[iarg + 1], true, lmp);
+      if (ttol < 0) error->all(FLERR, "Illegal fix nufeb/ph command: tabletol");
+      iarg += 2;
+    } else if (strcmp(arg[iarg], "every") == 0) {
+      if (iarg + 2 > narg) error->all(FLERR, "Illegal fix nufeb/ph command");
+      phevery = utils::inumeric(FLERR, arg[iarg + 1], true, lmp);
+      if (phevery < 0) error->all(FLERR, "Illegal fix nufeb/ph command: every");
+      iarg += 2;
+    } else if (strcmp(arg[iarg], "conctol") == 0) {
+      if (iarg + 2 > narg) error->all(FLERR, "Illegal fix nufeb/ph command");
+      conctol = utils::numeric(FLERR, arg[iarg + 1], true, lmp);
+      if (conctol <= 0) error->all(FLERR, "Illegal fix nufeb/ph command: conctol");
+      iarg += 2;
     } else {
       error->all(FLERR, "Illegal fix nufeb/ph command");
     }
   }
+
+  // with conctol the speciation is only periodically recomputed if
+  // every is also given
+  if (phevery < 0) phevery = conctol > 0 ? 0 : 1;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -105,6 +158,14 @@ FixPH::~FixPH()
   memory->destroy(keq);
   memory->destroy(act_all);
   memory->destroy(sh);
+  memory->destroy(active);
+  memory->destroy(f);
+  memory->destroy(df);
+  memory->destroy(gsh);
+  memory->destroy(tlog);
+  memory->destroy(tabled);
+  memory->destroy(fscale);
+  memory->destroy(conc_last);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -135,15 +196,65 @@ void FixPH::init()
 
   init_keq();
   compute_activity(0, ncells, iph);
+  if (ntable) build_table();
 }
 
 /* ---------------------------------------------------------------------- */
 
 void FixPH::chemistry_nufeb()
 {
+  if (!solve_needed()) return;
   compute();
 }
 
+/* ----------------------------------------------------------------------
+ decide whether the speciation is recomputed in this diffusion
+ iteration. it is always recomputed in the first iteration of a
+ timestep, otherwise every phevery iterations or if a concentration
+ changed by more than conctol since the last solve. grid->act and
+ grid->ph are reused in between
+ ------------------------------------------------------------------------- */
+
+int FixPH::solve_needed()
+{
+  if (phevery == 1 && conctol <= 0) return 1;
+
+  int ncells = grid->ncells;
+  int nsubs = grid->nsubs;
+  double **conc = grid->conc;
+
+  int flag = 0;
+  phcount++;
+  if (phstep != update->ntimestep) flag = 1;
+  else if (phevery > 0 && phcount >= phevery) flag = 1;
+  else if (conctol > 0) {
+    double dmax = 0.0;
+    for (int i = 0; i < nsubs; i++) {
+      for (int j = 0; j < ncells; j++) {
+        if (grid->mask[j] & BLAYER_MASK) continue;
+        dmax = MAX(dmax, fabs(conc[i][j] - conc_last[i][j]));
+      }
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &dmax, 1, MPI_DOUBLE, MPI_MAX, world);
+    if (dmax > conctol) flag = 1;
+  }
+  if (!flag) return 0;
+
+  phstep = update->ntimestep;
+  phcount = 0;
+  if (conctol > 0) {
+    if (ncells > nmax_last) {
+      nmax_last = ncells;
+      memory->destroy(conc_last);
+      memory->create(conc_last, nsubs, nmax_last, "nufeb/ph:conc_last");
+    }
+    for (int i = 0; i < nsubs; i++)
+      for (int j = 0; j < ncells; j++)
+        conc_last[i][j] = conc[i][j];
+  }
+  return 1;
+}
+
 /* ---------------------------------------------------------------------- */
 
 void FixPH::reactor_nufeb()
@@ -241,150 +352,129 @@ void FixPH::compute_activity(int first, int last, double iph) {
   memory->destroy(theta);
 }
 
-/* ---------------------------------------------------------------------- */
-
-inline double sum_activity(double ***act_all, double **keq, double **conc, int **ncharges,
-                           double theta, double *gsh, int i, int j) {
-  // not hydrated form acitivity
-  act_all[i][0][j] = keq[i][0] * conc[i][j] * gsh[2] / theta;
-  // fully protonated form activity
-  act_all[i][1][j] = conc[i][j] * gsh[2] / theta;
-  // 1st deprotonated form activity
-  act_all[i][2][j] = conc[i][j] * gsh[1] * keq[i][1] / theta;
-  // 2nd deprotonated form activity
-  act_all[i][3][j] = conc[i][j] * gsh[0] * keq[i][1] * keq[i][2] / theta;
-  // 3rd deprotonated form activity
-  act_all[i][4][j] = conc[i][j] * keq[i][1] * keq[i][2] * keq[i][3] / theta;
-
-  double tmp[5];
-  tmp[0] = ncharges[i][0] * act_all[i][0][j];
-  tmp[1] = ncharges[i][1] * act_all[i][1][j];
-  tmp[2] = ncharges[i][2] * act_all[i][2][j];
-  tmp[3] = ncharges[i][3] * act_all[i][3][j];
-  tmp[4] = ncharges[i][4] * act_all[i][4][j];
-  return tmp[0] + tmp[1] + tmp[2] + tmp[3] + tmp[4];
-}
-
-
-/* ---------------------------------------------------------------------- */
-
-inline void set_gsh(double *gsh, double value) {
-  gsh[0] = value;
-  gsh[1] = gsh[0] * gsh[0];
-  gsh[2] = gsh[1] * gsh[0];
-}
-
-/* ---------------------------------------------------------------------- */
+/* ----------------------------------------------------------------------
+ solve the charge balance for the H+ activity of each cell with the
+ Newton-Raphson method, starting from the previous sh. only the cells
+ that did not converge yet are evaluated in the next iteration
+ ------------------------------------------------------------------------- */
 
 void FixPH::compute_ph(int first, int last) {
   double tol = 5e-15;
   int max_iter = 100;
 
   int nsubs = grid->nsubs;
-  int ncells = grid->ncells;
   double **conc = grid->conc;
 
-  double *fa = memory->create(fa, ncells, "nufeb/ph:fa");
-  double *fb = memory->create(fb, ncells, "nufeb/ph:fb");
-  double *f = memory->create(f, ncells, "nufeb/ph:f");
-  double *df = memory->create(df, ncells, "nufeb/ph:df");
-
-  double a = 1e-14;
-  double b = 1;
+  if (grid->ncells > nmax) {
+    nmax = grid->ncells;
+    memory->destroy(active);
+    memory->destroy(f);
+    memory->destroy(df);
+    memory->destroy(gsh);
+    memory->destroy(tabled);
+    memory->destroy(fscale);
+    memory->create(active, nmax, "nufeb/ph:active");
+    memory->create(f, nmax, "nufeb/ph:f");
+    memory->create(df, nmax, "nufeb/ph:df");
+    memory->create(gsh, 3, nmax, "nufeb/ph:gsh");
+    memory->create(tabled, nmax, "nufeb/ph:tabled");
+    memory->create(fscale, nmax, "nufeb/ph:fscale");
+  }
 
+  int nactive = 0;
   for (int j = first; j < last; j++) {
     if (grid->mask[j] & BLAYER_MASK) continue;
-    fa[j] = a;
-    fb[j] = b;
+    active[nactive++] = j;
   }
 
-  double gsh[3];
-  set_gsh(gsh, a);
-  for (int i = 0; i < nsubs; i++) {
-    double theta = (1 + keq[i][0]) * gsh[2] + keq[i][1] * gsh[1] + keq[i][2] * keq[i][1] * gsh[0]
-                   + keq[i][3] * keq[i][2] * keq[i][1];
-    if (theta <= 0) {
-      lmp->error->all(FLERR, "theta returns a zero value");
-    }
-    for (int j = first; j < last; j++) {
-      if (grid->mask[j] & BLAYER_MASK) continue;
-      fa[j] += sum_activity(act_all, keq, conc, ncharges, theta, gsh, i, j);
+  // cells inside the table start from the tabulated sh, which is accepted
+  // after the first evaluation if the charge balance is within ttol
+  if (ntable) {
+    for (int n = 0; n < nactive; n++) {
+      double value;
+      tabled[n] = lookup(active[n], value);
+      if (tabled[n]) sh[active[n]] = value;
     }
   }
 
-  set_gsh (gsh, b);
-  for (int i = 0; i < nsubs; i++) {
-    double theta = (1 + keq[i][0]) * gsh[2] + keq[i][1] * gsh[1] + keq[i][2] * keq[i][1] * gsh[0]
-                   + keq[i][3] * keq[i][2] * keq[i][1];
-    if (theta <= 0) {
-      lmp->error->all(FLERR, "theta returns a zero value");
-    }
-    for (int j = first; j < last; j++) {
-      if (grid->mask[j] & BLAYER_MASK) continue;
-      fb[j] += sum_activity(act_all, keq, conc, ncharges, theta, gsh, i, j);
-    }
-  }
-
-  bool wrong = false;
-  for (int j = first; j < last; j++) {
-    if (grid->mask[j] & BLAYER_MASK) continue;
-    if (fa[j] * fb[j] > 0)
-      wrong = true;
-  }
-  if (wrong)
-    lmp->error->all(FLERR, "The sum of charges returns a wrong value");
+  double *g1 = gsh[0];
+  double *g2 = gsh[1];
+  double *g3 = gsh[2];
 
   // Newton-Raphson method
   int iter = 1;
-  while (iter <= max_iter) {
-    for (int j = first; j < last; j++) {
-      if (grid->mask[j] & BLAYER_MASK) continue;
-      f[j] = sh[j];
-      df[j] = 1;
+  while (iter <= max_iter && nactive > 0) {
+    const int check = ntable && iter == 1;
+    for (int n = 0; n < nactive; n++) {
+      const int j = active[n];
+      f[n] = sh[j];
+      df[n] = 1;
+      fscale[n] = sh[j];
+      g1[n] = sh[j];
+      g2[n] = g1[n] * g1[n];
+      g3[n] = g2[n] * g1[n];
     }
 
     for (int i = 0; i < nsubs; i++) {
-      for (int j = first; j < last; j++) {
-        if (grid->mask[j] & BLAYER_MASK) continue;
-        set_gsh (gsh, sh[j]);
-        double theta = (1 + keq[i][0]) * gsh[2] + keq[i][1] * gsh[1] + keq[i][2] * keq[i][1] * gsh[0]
-                       + keq[i][3] * keq[i][2] * keq[i][1];
-        f[j] += sum_activity(act_all, keq, conc, ncharges, theta, gsh, i, j);
-
-        double dtheta = theta * theta;
-        double aux = 3 * gsh[1] * (keq[i][0] + 1) + 2 * gsh[0] * keq[i][1] + keq[i][1] * keq[i][2];
-        double tmp[5];
-        tmp[0] = ncharges[i][0] * ((3 * gsh[1] * keq[i][0] * conc[i][j]) / theta - (keq[i][0] * conc[i][j] * gsh[2] * aux) / dtheta);
-        tmp[1] = ncharges[i][1] * ((3 * gsh[1] * conc[i][j]) / theta - (conc[i][j] * gsh[2] * aux) / dtheta);
-        tmp[2] = ncharges[i][2] * ((2 * gsh[0] * keq[i][1] * conc[i][j]) / theta - (keq[i][1] * conc[i][j] * gsh[1] * aux) / dtheta);
-        tmp[3] = ncharges[i][3] * ((keq[i][1] * keq[i][2] * conc[i][j]) / theta - (keq[i][1] * keq[i][2] * conc[i][j] * gsh[0] * aux) / dtheta);
-        tmp[4] = ncharges[i][4] * (-(keq[i][1] * keq[i][2] * keq[i][3] * conc[i][j] * aux) / dtheta);
-        df[j] += tmp[0] + tmp[1] + tmp[2] + tmp[3] + tmp[4];
+      const double k0 = keq[i][0];
+      const double k1 = keq[i][1];
+      const double k2 = keq[i][2];
+      const double k3 = keq[i][3];
+      const double k21 = k2 * k1;
+      const double k321 = k3 * k2 * k1;
+      const double z0 = ncharges[i][0];
+      const double z1 = ncharges[i][1];
+      const double z2 = ncharges[i][2];
+      const double z3 = ncharges[i][3];
+      const double z4 = ncharges[i][4];
+      const double *c = conc[i];
+      double *a0 = act_all[i][0];
+      double *a1 = act_all[i][1];
+      double *a2 = act_all[i][2];
+      double *a3 = act_all[i][3];
+      double *a4 = act_all[i][4];
+
+      for (int n = 0; n < nactive; n++) {
+        const int j = active[n];
+        const double cj = c[j];
+        const double theta = (1 + k0) * g3[n] + k1 * g2[n] + k21 * g1[n] + k321;
+
+        a0[j] = k0 * cj * g3[n] / theta;
+        a1[j] = cj * g3[n] / theta;
+        a2[j] = cj * g2[n] * k1 / theta;
+        a3[j] = cj * g1[n] * k1 * k2 / theta;
+        a4[j] = cj * k1 * k2 * k3 / theta;
+        f[n] += z0 * a0[j] + z1 * a1[j] + z2 * a2[j] + z3 * a3[j] + z4 * a4[j];
+        if (check)
+          fscale[n] += fabs(z0 * a0[j]) + fabs(z1 * a1[j]) + fabs(z2 * a2[j]) +
+            fabs(z3 * a3[j]) + fabs(z4 * a4[j]);
+
+        const double dtheta = theta * theta;
+        const double aux = 3 * g2[n] * (k0 + 1) + 2 * g1[n] * k1 + k1 * k2;
+        df[n] += z0 * ((3 * g2[n] * k0 * cj) / theta - (k0 * cj * g3[n] * aux) / dtheta)
+          + z1 * ((3 * g2[n] * cj) / theta - (cj * g3[n] * aux) / dtheta)
+          + z2 * ((2 * g1[n] * k1 * cj) / theta - (k1 * cj * g2[n] * aux) / dtheta)
+          + z3 * ((k1 * k2 * cj) / theta - (k1 * k2 * cj * g1[n] * aux) / dtheta)
+          + z4 * (-(k1 * k2 * k3 * cj * aux) / dtheta);
       }
     }
 
-    // Check for convergence
-    bool flag = true;
-    for (int j = first; j < last; j++) {
-      if (grid->mask[j] & BLAYER_MASK) continue;
-      if (fabs(f[j]) >= tol)
-        flag = false;
-    }
-    if (flag) break;
-
-    // Compute next value
-    for (int j = first; j < last; j++) {
-      if (grid->mask[j] & BLAYER_MASK) continue;
-      if (fabs(f[j]) >= tol) {
-        double d = f[j] / df[j];
-        // Prevent sh below 1e-14. That can happen because sometimes the Newton
-        // method overshoots to a negative gsh value, due to a small derivative
-        // value.
-        if (d >= sh[j] - 1e-14)
-          d = sh[j] / 2;
-        sh[j] -= d;
-      }
+    // update the cells that did not converge and keep them active
+    int nnext = 0;
+    for (int n = 0; n < nactive; n++) {
+      if (fabs(f[n]) < tol) continue;
+      if (check && tabled[n] && fabs(f[n]) <= ttol * fscale[n]) continue;
+      const int j = active[n];
+      double d = f[n] / df[n];
+      // Prevent sh below 1e-14. That can happen because sometimes the Newton
+      // method overshoots to a negative gsh value, due to a small derivative
+      // value.
+      if (d >= sh[j] - 1e-14)
+        d = sh[j] / 2;
+      sh[j] -= d;
+      active[nnext++] = j;
     }
+    nactive = nnext;
     iter++;
   }
 
@@ -401,11 +491,127 @@ void FixPH::compute_ph(int first, int last) {
     }
     grid->ph[j] = -log10(sh[j]);
   }
+}
 
-  memory->destroy(fa);
-  memory->destroy(fb);
-  memory->destroy(f);
-  memory->destroy(df);
+/* ----------------------------------------------------------------------
+ charge balance and its derivative for the concentrations c (mol/L)
+ at H+ activity h, same expressions as compute_ph()
+ ------------------------------------------------------------------------- */
+
+double FixPH::charge_balance(const double *c, double h, double &dfdh)
+{
+  double h2 = h * h;
+  double h3 = h2 * h;
+  double fh = h;
+  dfdh = 1;
+
+  for (int i = 0; i < grid->nsubs; i++) {
+    const double k0 = keq[i][0];
+    const double k1 = keq[i][1];
+    const double k2 = keq[i][2];
+    const double k3 = keq[i][3];
+    const int *z = ncharges[i];
+    const double theta = (1 + k0) * h3 + k1 * h2 + k2 * k1 * h + k3 * k2 * k1;
+    const double dtheta = theta * theta;
+    const double aux = 3 * h2 * (k0 + 1) + 2 * h * k1 + k1 * k2;
+
+    fh += (z[0] * k0 * h3 + z[1] * h3 + z[2] * h2 * k1 + z[3] * h * k1 * k2 +
+           z[4] * k1 * k2 * k3) * c[i] / theta;
+    dfdh += z[0] * ((3 * h2 * k0 * c[i]) / theta - (k0 * c[i] * h3 * aux) / dtheta)
+      + z[1] * ((3 * h2 * c[i]) / theta - (c[i] * h3 * aux) / dtheta)
+      + z[2] * ((2 * h * k1 * c[i]) / theta - (k1 * c[i] * h2 * aux) / dtheta)
+      + z[3] * ((k1 * k2 * c[i]) / theta - (k1 * k2 * c[i] * h * aux) / dtheta)
+      + z[4] * (-(k1 * k2 * k3 * c[i] * aux) / dtheta);
+  }
+  return fh;
+}
+
+/* ----------------------------------------------------------------------
+ tabulate log(sh) over the concentrations of the table substrates, the
+ other substrates are set to their average concentration in the grid.
+ each entry is solved by Newton's method safeguarded with bisection
+ ------------------------------------------------------------------------- */
+
+void FixPH::build_table()
+{
+  int nsubs = grid->nsubs;
+  double *mw = grid->mw;
+  double **conc = grid->conc;
+
+  double *c = new double[nsubs+1];
+  for (int i = 0; i <= nsubs; i++) c[i] = 0.0;
+  for (int j = 0; j < grid->ncells; j++) {
+    if (!(grid->mask[j] & GRID_MASK)) continue;
+    for (int i = 0; i < nsubs; i++) c[i] += conc[i][j] / mw[i];
+    c[nsubs] += 1.0;
+  }
+  MPI_Allreduce(MPI_IN_PLACE, c, nsubs+1, MPI_DOUBLE, MPI_SUM, world);
+  for (int i = 0; i < nsubs; i++)
+    if (c[nsubs] > 0) c[i] /= c[nsubs];
+
+  for (int d = 0; d < ntable; d++) {
+    tmin[d] = tlo[d] / mw[tsub[d]];
+    tdelta[d] = (thi[d] - tlo[d]) / mw[tsub[d]] / (tn[d] - 1);
+  }
+  if (ntable == 1) tn[1] = 1;
+
+  memory->destroy(tlog);
+  memory->create(tlog, tn[0] * tn[1], "nufeb/ph:tlog");
+
+  for (int t1 = 0; t1 < tn[1]; t1++) {
+    for (int t0 = 0; t0 < tn[0]; t0++) {
+      c[tsub[0]] = tmin[0] + t0 * tdelta[0];
+      if (ntable == 2) c[tsub[1]] = tmin[1] + t1 * tdelta[1];
+
+      double lo = 1e-14;
+      double hi = 1;
+      double dfdh;
+      double flo = charge_balance(c, lo, dfdh);
+      double fhi = charge_balance(c, hi, dfdh);
+      if (flo * fhi > 0)
+        error->all(FLERR, "The sum of charges returns a wrong value in pH table");
+
+      double h = sqrt(lo * hi);
+      for (int iter = 0; iter < 200; iter++) {
+        double fh = charge_balance(c, h, dfdh);
+        if (fabs(fh) < 5e-15) break;
+        if ((fh < 0) == (flo < 0)) lo = h;
+        else hi = h;
+        double next = h - fh / dfdh;
+        // bisect in log space if the Newton step leaves the bracket
+        if (!(next > lo && next < hi)) next = sqrt(lo * hi);
+        h = next;
+      }
+      tlog[t1 * tn[0] + t0] = log(h);
+    }
+  }
+  delete [] c;
+}
+
+/* ----------------------------------------------------------------------
+ interpolate sh of cell j from the table
+ return 0 if the cell is outside the table
+ ------------------------------------------------------------------------- */
+
+int FixPH::lookup(int j, double &value)
+{
+  double **conc = grid->conc;
+  int k[2] = {0, 0};
+  double w[2] = {0.0, 0.0};
+
+  for (int d = 0; d < ntable; d++) {
+    double u = (conc[tsub[d]][j] - tmin[d]) / tdelta[d];
+    if (u < 0 || u > tn[d] - 1) return 0;
+    k[d] = MIN(static_cast<int>(u), tn[d] - 2);
+    w[d] = u - k[d];
+  }
+
+  const double *t = tlog + k[1] * tn[0] + k[0];
+  double v = (1 - w[0]) * t[0] + w[0] * t[1];
+  if (ntable == 2)
+    v = (1 - w[1]) * v + w[1] * ((1 - w[0]) * t[tn[0]] + w[0] * t[tn[0]+1]);
+  value = exp(v);
+  return 1;
 }
 
 /* ----------------------------------------------------------------------
@@ -57,8 +57,34 @@ class FixPH : public Fix {
   double **act;             // activities of chemical forms for microbe uptaking
   double ***act_all;        // activities of 5 substrate forms
 
+  int nmax;                  // size of the Newton workspace
+  int *active;               // cells that did not converge yet
+  double *f, *df;            // charge balance and derivative of active cells
+  double **gsh;              // powers 1-3 of sh of active cells
+
+  int ntable;                // # of table dimensions, 0 = no table
+  int tsub[2];               // substrate of each table dimension
+  double tlo[2], thi[2];     // concentration range of each dimension (kg/m3)
+  int tn[2];                 // # of points in each dimension
+  double tmin[2], tdelta[2]; // first point and spacing (mol/L)
+  double ttol;               // relative charge balance accepted for the table
+  double *tlog;              // log(sh) at each table point
+  int *tabled;               // 1 if an active cell started from the table
+  double *fscale;            // magnitude of the charge balance terms
+
+  int phevery;               // solve every this many iterations, 0 = off
+  int phcount;               // # of iterations since the last solve
+  bigint phstep;             // timestep of the last solve
+  double conctol;            // solve if a concentration changed by more than this
+  double **conc_last;        // concentrations at the last solve
+  int nmax_last;
+
   void init_keq();
   void compute_ph(int, int);
+  int solve_needed();
+  void build_table();
+  int lookup(int, double &);
+  double charge_balance(const double *, double, double &);
   void compute_activity(int, int, double);
   void buffer_ph();
   void to_mol();
@@ -71,4 +97,19 @@ class FixPH : public Fix {
 #endif
 
 /* ERROR/WARNING messages:
+
+E: Illegal fix nufeb/ph command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.
+
+E: Can't find substrate name: table
+
+The substrate of the table keyword is not defined by grid_style.
+
+E: The sum of charges returns a wrong value in pH table
+
+The charge balance has no root between pH 0 and 14 for one of the
+table points. Check the table range and the energy file.
+
 */
@@ -13,6 +13,7 @@
 
 #include "grid_vec_chemostat.h"
 
+#include <cstring>
 #include "grid.h"
 #include "force.h"
 #include "error.h"
@@ -33,6 +34,7 @@ GridVecChemostat::GridVecChemostat(LAMMPS *lmp) : GridVec(lmp)
   reac = nullptr;
   dens = nullptr;
   growth = nullptr;
+  eps_rate = nullptr;
   bulk = nullptr;
   mw = nullptr;
   boundary = nullptr;
@@ -48,14 +50,18 @@ void GridVecChemostat::init()
 {
   GridVec::init();
 
+  // deep ghost layers are also updated by the diffusion stencil, which
+  // requires the reaction rates and diffusion coefficients of the owner
   size_forward = grid->nsubs;
+  if (grid->nghost > 1) size_forward *= 3;
   size_exchange = grid->nsubs;
 
-  for (int i = 0; i < grid->ncells; i++) {
-    for (int igroup = 0; igroup < group->ngroup; igroup++) {
-      grid->dens[igroup][i] = 0.0;
-      grid->growth[igroup][i][0] = 0.0;
-      grid->growth[igroup][i][1] = 0.0;
+  for (int igroup = 0; igroup < group->ngroup; igroup++) {
+    if (grid->group_field[igroup] < 0) continue;
+    for (int i = 0; i < grid->ncells; i++) {
+      dens[igroup][i] = 0.0;
+      growth[igroup][i] = 0.0;
+      eps_rate[igroup][i] = 0.0;
     }
   }
 }
@@ -67,32 +73,117 @@ void GridVecChemostat::grow(int n)
   if (n < 0 || n > MAXSMALLINT)
     error->one(FLERR,"Per-processor system is too big");
 
+  // per-substrate arrays do not depend on the # of cells
+  if (bulk == nullptr) {
+    memory->create(bulk, grid->nsubs, "nufeb/chemostat:bulk");
+    memory->create(mw, grid->nsubs, "nufeb/chemostat:mw");
+    memory->create(boundary, grid->nsubs, 6, "nufeb/chemostat:boundary");
+    grid->bulk = bulk;
+    grid->mw = mw;
+    grid->boundary = boundary;
+  }
+
   if (n > nmax) {
-    mask = memory->grow(grid->mask, n, "nufeb/chemostat:mask");
-    conc = memory->grow(grid->conc, grid->nsubs, n, "nufeb/chemostat:conc");
-    reac = memory->grow(grid->reac, grid->nsubs, n, "nufeb/chemostat:reac");
-    dens = memory->grow(grid->dens, group->ngroup, n, "nufeb/chemostat:dens");
-    growth = memory->grow(grid->growth, group->ngroup, n, 2, "nufeb/chemostat:grow");
-    boundary = memory->grow(grid->boundary, grid->nsubs, 6, "nufeb/chemostat:boundary");
-    diff_coeff = memory->grow(grid->diff_coeff, grid->nsubs, n, "nufeb/chemostat:diff_coeff");
-    bulk = memory->grow(grid->bulk, grid->nsubs, "nufeb/chemostat:bulk");
-    mw = memory->grow(grid->mw, grid->nsubs, "nufeb/chemostat:mw");
-
-    nmax = n;
+    // leave some headroom after the first allocation so that small changes
+    // of the sub-domain (e.g. load balancing) do not reallocate the fields
+    // rows are padded to a multiple of GRID_PAD for aligned vector access
+    bigint nnew = n;
+    if (nmax > 0) nnew += n/8;
+    nnew = (nnew + Grid::GRID_PAD - 1) / Grid::GRID_PAD * Grid::GRID_PAD;
+    if (nnew > MAXSMALLINT) nnew = n;
+    int npitch = nnew;
+
+    mask = memory->grow(grid->mask, npitch, "nufeb/chemostat:mask");
+    conc = grow_field(conc, grid->nsubs, npitch, "nufeb/chemostat:conc");
+    reac = grow_field(reac, grid->nsubs, npitch, "nufeb/chemostat:reac");
+    diff_coeff = grow_field(diff_coeff, grid->nsubs, npitch, "nufeb/chemostat:diff_coeff");
+    dens = grow_group_field(dens, npitch, "nufeb/chemostat:dens");
+    growth = grow_group_field(growth, npitch, "nufeb/chemostat:growth");
+    eps_rate = grow_group_field(eps_rate, npitch, "nufeb/chemostat:eps_rate");
+
+    nmax = npitch;
     grid->nmax = nmax;
+    grid->pitch = npitch;
 
     grid->mask = mask;
     grid->conc = conc;
     grid->reac = reac;
     grid->dens = dens;
     grid->growth = growth;
-    grid->bulk = bulk;
-    grid->mw = mw;
-    grid->boundary = boundary;
+    grid->eps_rate = eps_rate;
     grid->diff_coeff = diff_coeff;
   }
 }
 
+/* ----------------------------------------------------------------------
+   add rows to the per-group fields after Grid::add_group()
+------------------------------------------------------------------------- */
+
+void GridVecChemostat::grow_groups()
+{
+  if (nmax == 0) return;
+
+  dens = grow_group_field(dens, nmax, "nufeb/chemostat:dens");
+  growth = grow_group_field(growth, nmax, "nufeb/chemostat:growth");
+  eps_rate = grow_group_field(eps_rate, nmax, "nufeb/chemostat:eps_rate");
+
+  grid->dens = dens;
+  grid->growth = growth;
+  grid->eps_rate = eps_rate;
+}
+
+/* ----------------------------------------------------------------------
+   reallocate a per-substrate field as one contiguous block of nrows
+   rows of length npitch, keeping the values of the old field
+------------------------------------------------------------------------- */
+
+double **GridVecChemostat::grow_field(double **old, int nrows, int npitch,
+                                      const char *name)
+{
+  double **array;
+  memory->create(array, nrows, npitch, name);
+  if (array == nullptr) return old;
+
+  memset(array[0], 0, sizeof(double) * nrows * npitch);
+  if (old) {
+    for (int r = 0; r < nrows; r++)
+      memcpy(array[r], old[r], sizeof(double) * MIN(nmax, npitch));
+    memory->destroy(old);
+  }
+  return array;
+}
+
+/* ----------------------------------------------------------------------
+   reallocate a per-group field as one contiguous block with a row for
+   each group requested by Grid::add_group() followed by a zero row that
+   is shared by all other groups, so that field[igroup] is valid for any
+   group. group all has the first row, therefore memory->destroy() can
+   free the field
+------------------------------------------------------------------------- */
+
+double **GridVecChemostat::grow_group_field(double **old, int npitch,
+                                            const char *name)
+{
+  const int nrows = grid->ngroup_field + 1;
+  const int *row = grid->group_field;
+
+  const bigint nbytes = sizeof(double) * nrows * npitch;
+  double *data = (double *) memory->smalloc(nbytes, name);
+  memset(data, 0, nbytes);
+  double **array = (double **)
+    memory->smalloc(sizeof(double *) * Grid::MAXGROUP, name);
+  for (int g = 0; g < Grid::MAXGROUP; g++)
+    array[g] = data + (bigint) (row[g] >= 0 ? row[g] : nrows - 1) * npitch;
+
+  if (old) {
+    for (int g = 0; g < Grid::MAXGROUP; g++)
+      if (row[g] >= 0)
+        memcpy(array[g], old[g], sizeof(double) * MIN(nmax, npitch));
+    memory->destroy(old);
+  }
+  return array;
+}
+
 /* ---------------------------------------------------------------------- */
 
 int GridVecChemostat::pack_comm(int n, int *cells, double *buf)
@@ -103,6 +194,14 @@ int GridVecChemostat::pack_comm(int n, int *cells, double *buf)
       buf[m++] = conc[s][cells[c]];
     }
   }
+  if (grid->nghost > 1) {
+    for (int s = 0; s < grid->nsubs; s++) {
+      for (int c = 0; c < n; c++) {
+        buf[m++] = reac[s][cells[c]];
+        buf[m++] = diff_coeff[s][cells[c]];
+      }
+    }
+  }
   return m;
 }
 
@@ -116,6 +215,14 @@ void GridVecChemostat::unpack_comm(int n, int *cells, double *buf)
       conc[s][cells[c]] = buf[m++];
     }
   }
+  if (grid->nghost > 1) {
+    for (int s = 0; s < grid->nsubs; s++) {
+      for (int c = 0; c < n; c++) {
+        reac[s][cells[c]] = buf[m++];
+        diff_coeff[s][cells[c]] = buf[m++];
+      }
+    }
+  }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -30,6 +30,7 @@ class GridVecChemostat : public GridVec {
   ~GridVecChemostat() {}
   void init();
   void grow(int);
+  void grow_groups();
 
   int pack_comm(int, int *, double *);
   void unpack_comm(int, int *, double *);
@@ -44,13 +45,17 @@ class GridVecChemostat : public GridVec {
   double **conc;    // concentration
   double **reac;    // reaction rate
   double **dens;    // density
-  double ***growth; // growth rate
+  double **growth;  // specific growth rate
+  double **eps_rate; // specific EPS production rate
   double *bulk;     // bulk concentration
   double *mw;       // molecular weight g/mol
   int **boundary;   // boundary conditions (-x, +x, -y, +y, -z, +z)
   double **diff_coeff;
   double *ph;
   double *act;      // activity of substrate form for microbe uptake
+
+  double **grow_field(double **, int, int, const char *);
+  double **grow_group_field(double **, int, const char *);
 };
 
 }
@@ -19,7 +19,9 @@
 #include <sys/resource.h>
 #endif
 
+#include <cmath>
 #include <cstring>
+#include <algorithm>
 #include "nufeb_run.h"
 #include "neighbor.h"
 #include "domain.h"
@@ -28,6 +30,7 @@
 #include "atom_vec.h"
 #include "force.h"
 #include "pair.h"
+#include "neigh_list.h"
 #include "bond.h"
 #include "angle.h"
 #include "dihedral.h"
@@ -36,6 +39,7 @@
 #include "output.h"
 #include "update.h"
 #include "modify.h"
+#include "group.h"
 #include "compute.h"
 #include "fix.h"
 #include "timer.h"
@@ -49,12 +53,30 @@
 // NUFEB specific
 
 #include "grid.h"
+#include "grid_masks.h"
 #include "comm_grid.h"
 #include "fix_density.h"
 #include "fix_diffusion_reaction.h"
+#include "fix_growth.h"
+#include "diffusion_anderson.h"
 #include "compute_volume.h"
 
 using namespace LAMMPS_NS;
+using namespace FixConst;
+
+// FIRE parameters, Bitzek et al., Phys Rev Lett 97, 170201 (2006)
+
+#define FIRE_DELAY 5          // # of downhill steps before dt grows
+#define FIRE_DTGROW 1.1
+#define FIRE_DTSHRINK 0.5
+#define FIRE_DTMAX 10.0       // largest step as a multiple of the first one
+#define FIRE_DTMIN 0.02       // smallest step as a multiple of the first one
+#define FIRE_ALPHA0 0.1
+#define FIRE_ALPHASHRINK 0.99
+
+#define ACTIVE_EVERY 10       // # of relaxation steps between updates of the frozen pairs
+
+enum{ACTIVE,FROZEN,FREEZING,PUSHING};   // states of the atoms with pairactive
 
 /* ---------------------------------------------------------------------- */
 
@@ -68,16 +90,49 @@ NufebRun::NufebRun(LAMMPS *lmp, int narg, char **arg) :
 
   biodt = 1.0;
   diffdt = 1.0;
+  diffdt_auto = 0;
+  diffsafety = 0.9;
   difftol = 1.0;
   diffmax = -1;
+  diffcheck = 1;
   pairdt = 1.0;
   pairtol = 1.0;
   pairmax = -1;
+  paircheck = 1;
+  pairconv = PRESSURE;
+  vflag_step = 0;
 
   nfix_diffusion = 0;
+  anderson_depth = 0;
+  warm_order = 0;
+  biodt_flag = 0;
+  biotol = 1e-3;
+  biodt_min = biodt_max = 0.0;
+  growth_prev = nullptr;
+  nprev = 0;
+  prev_flag = 0;
+  relax_flag = 0;
+  fire_dmax = 0.0;
+  fire_dt = fire_dt0 = fire_alpha = 0.0;
+  fire_npos = 0;
+  relax_groupbit = 0;
+  fire_v = nullptr;
+  fire_nmax = 0;
+  active_flag = 0;
+  active_ftol = active_dtol = 0.0;
+  active_nmax = 0;
+  active_dirty = 0;
+  frozen = nullptr;
+  xprev = nullptr;
+  foff = nullptr;
+  toff = nullptr;
+  ilist_kept = nullptr;
+  ilist_dropped = nullptr;
+  inum_kept = inum_dropped = 0;
 
   fix_density = nullptr;
   fix_diffusion = nullptr;
+  anderson = nullptr;
   comp_pressure = nullptr;
   comp_ke = nullptr;
   comp_volume = nullptr;
@@ -87,7 +142,16 @@ NufebRun::NufebRun(LAMMPS *lmp, int narg, char **arg) :
   int iarg = 0;
   while (iarg < narg) {
     if (strcmp(arg[iarg], "diffdt") == 0) {
-      diffdt = utils::numeric(FLERR,arg[iarg+1],true,lmp);
+      if (strcmp(arg[iarg+1], "auto") == 0) diffdt_auto = 1;
+      else {
+        diffdt_auto = 0;
+        diffdt = utils::numeric(FLERR,arg[iarg+1],true,lmp);
+      }
+      iarg += 2;
+    } else if (strcmp(arg[iarg], "diffsafety") == 0) {
+      diffsafety = utils::numeric(FLERR,arg[iarg+1],true,lmp);
+      if (diffsafety <= 0.0 || diffsafety > 1.0)
+	error->all(FLERR, "Illegal run_style nufeb command");
       iarg += 2;
     } else if (strcmp(arg[iarg], "difftol") == 0) {
       difftol = utils::numeric(FLERR,arg[iarg+1],true,lmp);
@@ -95,6 +159,11 @@ NufebRun::NufebRun(LAMMPS *lmp, int narg, char **arg) :
     } else if (strcmp(arg[iarg], "diffmax") == 0) {
       diffmax = utils::numeric(FLERR,arg[iarg+1],true,lmp);
       iarg += 2;
+    } else if (strcmp(arg[iarg], "diffcheck") == 0) {
+      diffcheck = utils::inumeric(FLERR,arg[iarg+1],true,lmp);
+      if (diffcheck < 1)
+	error->all(FLERR, "Illegal run_style nufeb command");
+      iarg += 2;
     } else if (strcmp(arg[iarg], "pairdt") == 0) {
       pairdt = utils::numeric(FLERR,arg[iarg+1],true,lmp);
       iarg += 2;
@@ -116,6 +185,81 @@ NufebRun::NufebRun(LAMMPS *lmp, int narg, char **arg) :
 	error->all(FLERR, "Illegal run_style nufeb command");
       }
       iarg += 2;
+    } else if (strcmp(arg[iarg], "diffaccel") == 0) {
+      if (iarg+2 > narg) error->all(FLERR, "Illegal run_style nufeb command");
+      if (strcmp(arg[iarg+1], "none") == 0) {
+        anderson_depth = 0;
+        iarg += 2;
+      } else if (strcmp(arg[iarg+1], "anderson") == 0) {
+        if (iarg+3 > narg) error->all(FLERR, "Illegal run_style nufeb command");
+        anderson_depth = utils::inumeric(FLERR,arg[iarg+2],true,lmp);
+        if (anderson_depth < 1)
+          error->all(FLERR, "Illegal run_style nufeb command");
+        iarg += 3;
+      } else {
+	error->all(FLERR, "Illegal run_style nufeb command");
+      }
+    } else if (strcmp(arg[iarg], "warmstart") == 0) {
+      if (iarg+2 > narg) error->all(FLERR, "Illegal run_style nufeb command");
+      if (strcmp(arg[iarg+1], "none") == 0) warm_order = 0;
+      else if (strcmp(arg[iarg+1], "linear") == 0) warm_order = 1;
+      else if (strcmp(arg[iarg+1], "quadratic") == 0) warm_order = 2;
+      else error->all(FLERR, "Illegal run_style nufeb command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg], "biodt") == 0) {
+      if (iarg+2 > narg) error->all(FLERR, "Illegal run_style nufeb command");
+      if (strcmp(arg[iarg+1], "fixed") == 0) {
+        biodt_flag = 0;
+        iarg += 2;
+      } else if (strcmp(arg[iarg+1], "adaptive") == 0) {
+        if (iarg+5 > narg) error->all(FLERR, "Illegal run_style nufeb command");
+        biodt_flag = 1;
+        biotol = utils::numeric(FLERR,arg[iarg+2],true,lmp);
+        biodt_min = utils::numeric(FLERR,arg[iarg+3],true,lmp);
+        biodt_max = utils::numeric(FLERR,arg[iarg+4],true,lmp);
+        if (biotol <= 0.0)
+          error->all(FLERR, "Illegal run_style nufeb command");
+        if (biodt_min <= 0.0 || biodt_min > biodt_max)
+          error->all(FLERR, "Run_style nufeb biodt adaptive requires 0 < dtmin <= dtmax");
+        iarg += 5;
+      } else {
+	error->all(FLERR, "Illegal run_style nufeb command");
+      }
+    } else if (strcmp(arg[iarg], "relax") == 0) {
+      if (iarg+2 > narg) error->all(FLERR, "Illegal run_style nufeb command");
+      if (strcmp(arg[iarg+1], "dem") == 0) {
+        relax_flag = 0;
+        iarg += 2;
+      } else if (strcmp(arg[iarg+1], "fire") == 0) {
+        if (iarg+3 > narg) error->all(FLERR, "Illegal run_style nufeb command");
+        relax_flag = 1;
+        fire_dmax = utils::numeric(FLERR,arg[iarg+2],true,lmp);
+        if (fire_dmax <= 0.0)
+          error->all(FLERR, "Illegal run_style nufeb command");
+        iarg += 3;
+      } else {
+	error->all(FLERR, "Illegal run_style nufeb command");
+      }
+    } else if (strcmp(arg[iarg], "paircheck") == 0) {
+      if (iarg+2 > narg) error->all(FLERR, "Illegal run_style nufeb command");
+      paircheck = utils::inumeric(FLERR,arg[iarg+1],true,lmp);
+      if (paircheck <= 0)
+        error->all(FLERR, "Illegal run_style nufeb command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg], "pairconv") == 0) {
+      if (iarg+2 > narg) error->all(FLERR, "Illegal run_style nufeb command");
+      if (strcmp(arg[iarg+1], "pressure") == 0) pairconv = PRESSURE;
+      else if (strcmp(arg[iarg+1], "force") == 0) pairconv = FORCE;
+      else error->all(FLERR, "Illegal run_style nufeb command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg], "pairactive") == 0) {
+      if (iarg+3 > narg) error->all(FLERR, "Illegal run_style nufeb command");
+      active_flag = 1;
+      active_ftol = utils::numeric(FLERR,arg[iarg+1],true,lmp);
+      active_dtol = utils::numeric(FLERR,arg[iarg+2],true,lmp);
+      if (active_ftol <= 0.0 || active_dtol <= 0.0)
+        error->all(FLERR, "Illegal run_style nufeb command");
+      iarg += 3;
     } else if (strcmp(arg[iarg], "initdiff") == 0) {
       if (strcmp(arg[iarg+1], "yes") == 0) init_diff_flag = true;
       else if (strcmp(arg[iarg+1], "no") == 0) init_diff_flag = false;
@@ -136,7 +280,16 @@ NufebRun::~NufebRun()
   if (profile)
     fclose(profile);
   
+  delete anderson;
   delete [] fix_diffusion;
+  memory->destroy(growth_prev);
+  memory->destroy(fire_v);
+  memory->destroy(frozen);
+  memory->destroy(xprev);
+  memory->destroy(foff);
+  memory->destroy(toff);
+  memory->destroy(ilist_kept);
+  memory->destroy(ilist_dropped);
 }
 
 /* ----------------------------------------------------------------------
@@ -151,15 +304,40 @@ void NufebRun::init()
   strcpy(update->integrate_style, "verlet/nufeb\0");
 
   // allocate space for storing fix diffusion
+  delete anderson;
+  anderson = nullptr;
+  delete [] fix_diffusion;
   fix_diffusion = new FixDiffusionReaction*[modify->nfix];
+  nfix_diffusion = 0;
+
+  // converged fields kept on the grid for warm starts
+  grid->nwarm = warm_order ? warm_order + 1 : 0;
 
   for (int i = 0; i < modify->nfix; i++) {
     // find nufeb fixes
     if (strstr(modify->fix[i]->style, "nufeb/diffusion_reaction")) {
       fix_diffusion[nfix_diffusion++] = (FixDiffusionReaction *)modify->fix[i];
     }
+    // growth is integrated exactly for constant rates with adaptive steps
+    FixGrowth *fix_growth = dynamic_cast<FixGrowth *>(modify->fix[i]);
+    if (fix_growth) fix_growth->exp_flag = biodt_flag;
   }
 
+  // the minimizer moves the atoms of the time integration fixes
+  // in place of the fixes themselves, only these atoms can be frozen
+  relax_groupbit = 0;
+  for (int i = 0; i < modify->nfix; i++)
+    if (modify->fix[i]->time_integrate)
+      relax_groupbit |= modify->fix[i]->groupbit;
+  if (relax_flag && !relax_groupbit)
+    error->all(FLERR, "Run_style nufeb relax fire requires a time integration fix");
+  // the minimizer only moves positions, rod orientations would be frozen
+  if (relax_flag && atom->angmom_flag)
+    error->all(FLERR, "Run_style nufeb relax fire does not support "
+               "rotational degrees of freedom (e.g. atom_style bacillus)");
+  if (active_flag && !force->pair)
+    error->all(FLERR, "Run_style nufeb pairactive requires a pair style");
+
   // create fix nufeb/density
   char **fixarg = new char*[3];
   fixarg[0] = (char *)"nufeb_density";
@@ -246,7 +424,10 @@ void NufebRun::setup(int flag)
       fprintf(screen,"  Unit style           : %s\n",update->unit_style);
       fprintf(screen,"  Current step         : " BIGINT_FORMAT "\n",update->ntimestep);
       fprintf(screen,"  Biological time step : %g\n",update->dt);
-      fprintf(screen,"  Chemical time step   : %g\n",diffdt);
+      if (diffdt_auto)
+        fprintf(screen,"  Chemical time step   : auto\n");
+      else
+        fprintf(screen,"  Chemical time step   : %g\n",diffdt);
       fprintf(screen,"  Physical time step   : %g\n",pairdt);
       fprintf(screen,"  Grid mesh            : %i x %i x %i \n",
               grid->box[0], grid->box[1], grid->box[2]);
@@ -318,8 +499,22 @@ void NufebRun::setup(int flag)
 
   // set timestep to biological dt
 
+  if (biodt_flag) {
+    update->update_time();
+    update->dt = MAX(biodt_min, MIN(update->dt, biodt_max));
+    prev_flag = 0;
+  }
   biodt = update->dt;
 
+  if (anderson_depth) {
+    for (int i = 0; i < nfix_diffusion; i++)
+      if (fix_diffusion[i]->freeze_size)
+        error->all(FLERR, "Run_style nufeb diffaccel is incompatible with fix "
+                   "nufeb/diffusion_reaction freeze");
+    delete anderson;
+    anderson = new DiffusionAnderson(lmp, fix_diffusion, nfix_diffusion, anderson_depth);
+  }
+
   // compute density
   fix_density->compute();
 
@@ -431,7 +626,11 @@ void NufebRun::run(int n)
     press = module_physics();
     if (profile)
       fprintf(profile, "%d %e ", npair, get_time()-t);
-    if (info && comm->me == 0) fprintf(screen, "pair interaction: %d steps (pressure %e N/m2)\n", npair, press);
+    if (info && comm->me == 0) {
+      if (pairconv == FORCE)
+        fprintf(screen, "pair interaction: %d steps (max force %e N)\n", npair, press);
+      else fprintf(screen, "pair interaction: %d steps (pressure %e N/m2)\n", npair, press);
+    }
 
       // run post-physics module
     t = get_time();
@@ -548,9 +747,70 @@ void NufebRun::module_biology()
 
   if (modify->n_biology_nufeb) {
     timer->stamp();
+    // saturation terms are shared by growth fixes, see Grid::monod()
+    grid->cache_saturation(1);
     modify->biology_nufeb();
+    grid->cache_saturation(0);
     timer->stamp(Timer::MODIFY);
   }
+
+  if (biodt_flag) adapt_biodt();
+}
+
+/* ----------------------------------------------------------------------
+   choose the biological timestep of the next step. with the exponential
+   update the biomass is exact for constant growth rates, the local error
+   in log(mass) is 0.5 * dmu/dt * dt^2 where dmu/dt is estimated from the
+   change of the growth rates since the previous step
+------------------------------------------------------------------------- */
+
+void NufebRun::adapt_biodt()
+{
+  double **growth = grid->growth;
+  const int ncells = grid->ncells;
+  const int ngroup = group->ngroup;
+
+  if (ncells * ngroup != nprev) {
+    nprev = ncells * ngroup;
+    memory->destroy(growth_prev);
+    memory->create(growth_prev, nprev, "nufeb/run:growth_prev");
+    prev_flag = 0;
+  }
+
+  int nocc;
+  const int *occ = grid->occupied(0, nocc);
+  double dmu = 0.0;
+  for (int g = 0; g < ngroup; g++) {
+    double *prev = &growth_prev[g*ncells];
+    if (prev_flag) {
+      for (int n = 0; n < nocc; n++) {
+        const int i = occ[n];
+        const double d = fabs(growth[g][i] - prev[i]);
+        if (d > dmu) dmu = d;
+      }
+    }
+    for (int i = 0; i < ncells; i++)
+      prev[i] = growth[g][i];
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &dmu, 1, MPI_DOUBLE, MPI_MAX, world);
+
+  if (!prev_flag) {
+    prev_flag = 1;
+    return;
+  }
+
+  // grow by at most a factor of 2 per step
+  double dt = 2.0 * biodt;
+  if (dmu > 0.0) dt = MIN(dt, 0.9 * sqrt(2.0 * biotol * biodt / dmu));
+  dt = MAX(biodt_min, MIN(dt, biodt_max));
+  if (dt == biodt) return;
+
+  // simulation time is accumulated with the old timestep
+  update->dt = biodt;
+  update->update_time();
+  biodt = dt;
+  update->dt = biodt;
+  reset_dt();
 }
 
 /* ---------------------------------------------------------------------- */
@@ -582,11 +842,23 @@ double NufebRun::module_physics()
 
   npair = 0;
   double press = 0.0;
+  bigint nactive = 1;
+  int check;
+  vflag_step = vflag;
+  if (relax_flag) fire_start();
+  if (active_flag) active_start();
   do {
+    // convergence is checked every paircheck iterations and on the last one,
+    // the virial is only tallied when it is needed
+
+    check = ((npair + 1) % paircheck == 0) || (pairmax > 0 && npair + 1 >= pairmax);
+    vflag = (check && pairconv == PRESSURE) ? vflag_step : 0;
+
     // initial time integration
 
     timer->stamp();
-    modify->initial_integrate(vflag);
+    if (relax_flag) fire_move();
+    else modify->initial_integrate(vflag);
     if (n_post_integrate) modify->post_integrate();
     timer->stamp(Timer::MODIFY);
 
@@ -599,6 +871,7 @@ double NufebRun::module_physics()
   	comm->forward_comm();
   	timer->stamp(Timer::COMM);
     } else {
+  	if (active_flag) active_save();
   	if (n_pre_exchange) {
   	  timer->stamp();
   	  modify->pre_exchange();
@@ -627,8 +900,14 @@ double NufebRun::module_physics()
   	  modify->post_neighbor();
   	  timer->stamp(Timer::MODIFY);
   	}
+  	// atoms have been exchanged or sorted
+  	if (active_flag) active_restore();
     }
 
+    if (relax_flag) fire_hide();
+    if (active_flag && (active_dirty > 1 || (active_dirty && npair % ACTIVE_EVERY == 0)))
+      active_split();
+
     // force computations
     // important for pair to come before bonded contributions
     // since some bonded potentials tally pairwise energy/virial
@@ -644,7 +923,8 @@ double NufebRun::module_physics()
     }
 
     if (pair_compute_flag) {
-  	force->pair->compute(eflag,vflag);
+  	if (active_flag) active_pair();
+  	else force->pair->compute(eflag,vflag);
   	timer->stamp(Timer::PAIR);
     }
 
@@ -676,23 +956,563 @@ double NufebRun::module_physics()
     // force modifications, final time integration, diagnostics
 
     if (n_post_force_any) modify->post_force(vflag);
-    modify->final_integrate();
+    if (active_flag) nactive = active_update();
+    if (relax_flag) fire_update();
+    else modify->final_integrate();
     if (n_end_of_step) modify->end_of_step();
     timer->stamp(Timer::MODIFY);
 
     ++npair;
 
-    press = comp_pressure->compute_scalar() * domain->xprd * domain->yprd * domain->zprd;
-    press += comp_ke->compute_scalar();
-    press /= 3.0 * vol;
+    if (check) {
+      press = pair_residual(vol);
+      timer->stamp(Timer::MODIFY);
+    }
+
+  } while((!check || fabs(press) > pairtol) && nactive > 0 &&
+          ((pairmax > 0) ? npair < pairmax : true));
+
+  // all atoms were frozen on an iteration without convergence check,
+  // the residual of the last check is stale. the virial was not tallied
+  // so the forces are evaluated once more for the pressure
 
+  if (!check) {
+    if (pairconv == PRESSURE) {
+      vflag = vflag_step;
+      force_clear();
+      timer->stamp();
+      if (n_pre_force) modify->pre_force(vflag);
+      if (pair_compute_flag) force->pair->compute(eflag,vflag);
+      if (n_pre_reverse) modify->pre_reverse(eflag,vflag);
+      if (force->newton) comm->reverse_comm();
+      if (n_post_force_any) modify->post_force(vflag);
+      timer->stamp(Timer::PAIR);
+    }
+    press = pair_residual(vol);
     timer->stamp(Timer::MODIFY);
+  }
+
+  vflag = vflag_step;
+  if (relax_flag) fire_start();
+  if (active_flag) active_reset();
 
-  } while(fabs(press) > pairtol && ((pairmax > 0) ? npair < pairmax : true));
+  // atoms have moved, been exchanged or sorted
+  grid->reset_atom_cells();
 
   return press;
 }
 
+/* ----------------------------------------------------------------------
+   convergence measure of the mechanical relaxation, either the pressure
+   (N/m2) from the virial of the pair style and fixes and the kinetic
+   energy, or the largest force (N) on the atoms moved by the relaxation.
+   the contributions are summed locally and reduced at once
+------------------------------------------------------------------------- */
+
+double NufebRun::pair_residual(double vol)
+{
+  int nlocal = atom->nlocal;
+  int *mask = atom->mask;
+
+  if (pairconv == FORCE) {
+    double **f = atom->f;
+    double fmax = 0.0;
+    for (int i = 0; i < nlocal; i++) {
+      if (!(mask[i] & relax_groupbit)) continue;
+      fmax = MAX(fmax, f[i][0]*f[i][0] + f[i][1]*f[i][1] + f[i][2]*f[i][2]);
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &fmax, 1, MPI_DOUBLE, MPI_MAX, world);
+    return sqrt(fmax);
+  }
+
+  // same contributions as compute pressure with the pair and fix keywords
+
+  double sum[4] = {0.0, 0.0, 0.0, 0.0};
+  if (force->pair)
+    for (int k = 0; k < 3; k++) sum[k] += force->pair->virial[k];
+  for (int i = 0; i < modify->nfix; i++) {
+    Fix *fix = modify->fix[i];
+    if (fix->virial_global_flag && fix->thermo_virial)
+      for (int k = 0; k < 3; k++) sum[k] += fix->virial[k];
+  }
+
+  // the velocities of the minimizer do not contribute to the pressure
+
+  if (!relax_flag) {
+    double **v = atom->v;
+    double *rmass = atom->rmass;
+    double *mass = atom->mass;
+    int *type = atom->type;
+    for (int i = 0; i < nlocal; i++) {
+      double m = rmass ? rmass[i] : mass[type[i]];
+      sum[3] += m * (v[i][0] * v[i][0] + v[i][1] * v[i][1] + v[i][2] * v[i][2]);
+    }
+  }
+
+  double all[4];
+  MPI_Allreduce(sum, all, 4, MPI_DOUBLE, MPI_SUM, world);
+
+  double press = (all[0] + all[1] + all[2]) / 3.0 * force->nktv2p;
+  press += 0.5 * force->mvv2e * all[3];
+  return press / (3.0 * vol);
+}
+
+/* ----------------------------------------------------------------------
+   reset the FIRE minimizer, the relaxation starts at rest and the first
+   step is chosen from the forces by fire_update()
+------------------------------------------------------------------------- */
+
+void NufebRun::fire_start()
+{
+  double **v = atom->v;
+  int *mask = atom->mask;
+
+  for (int i = 0; i < atom->nlocal; i++) {
+    if (mask[i] & relax_groupbit) v[i][0] = v[i][1] = v[i][2] = 0.0;
+  }
+  fire_dt = fire_dt0 = 0.0;
+  fire_alpha = FIRE_ALPHA0;
+  fire_npos = 0;
+}
+
+/* ----------------------------------------------------------------------
+   move the atoms with the FIRE velocities. fixes that are not time
+   integrators still get their initial_integrate() call
+------------------------------------------------------------------------- */
+
+void NufebRun::fire_move()
+{
+  double **x = atom->x;
+  double **v = atom->v;
+  int *mask = atom->mask;
+  int nlocal = atom->nlocal;
+
+  // no atom moves farther than fire_dmax in one step
+
+  double vmax = 0.0;
+  for (int i = 0; i < nlocal; i++) {
+    if (!(mask[i] & relax_groupbit)) continue;
+    vmax = MAX(vmax, v[i][0]*v[i][0] + v[i][1]*v[i][1] + v[i][2]*v[i][2]);
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &vmax, 1, MPI_DOUBLE, MPI_MAX, world);
+  vmax = sqrt(vmax);
+  if (vmax * fire_dt > fire_dmax) fire_dt = fire_dmax / vmax;
+
+  for (int i = 0; i < nlocal; i++) {
+    if (!(mask[i] & relax_groupbit)) continue;
+    x[i][0] += fire_dt * v[i][0];
+    x[i][1] += fire_dt * v[i][1];
+    x[i][2] += fire_dt * v[i][2];
+  }
+
+  for (int i = 0; i < modify->nfix; i++)
+    if ((modify->fmask[i] & INITIAL_INTEGRATE) && !modify->fix[i]->time_integrate)
+      modify->fix[i]->initial_integrate(vflag);
+}
+
+/* ----------------------------------------------------------------------
+   the FIRE velocities are not physical, they are stored aside while the
+   forces are computed so that damping terms of pair styles and fixes
+   only see atoms at rest. called after atoms are exchanged
+------------------------------------------------------------------------- */
+
+void NufebRun::fire_hide()
+{
+  double **v = atom->v;
+  int nlocal = atom->nlocal;
+  int nall = nlocal + atom->nghost;
+
+  if (nlocal > fire_nmax) {
+    fire_nmax = atom->nmax;
+    memory->destroy(fire_v);
+    memory->create(fire_v, fire_nmax, 3, "nufeb/run:fire_v");
+  }
+  for (int i = 0; i < nlocal; i++) {
+    fire_v[i][0] = v[i][0];
+    fire_v[i][1] = v[i][1];
+    fire_v[i][2] = v[i][2];
+  }
+  for (int i = 0; i < nall; i++) v[i][0] = v[i][1] = v[i][2] = 0.0;
+}
+
+/* ----------------------------------------------------------------------
+   FIRE velocity update from the new forces (semi-implicit Euler), the
+   step grows while the atoms move downhill, the minimizer stops and
+   restarts with a smaller step when the power F.v turns negative.
+   the first step moves the atom with the largest acceleration by
+   fire_dmax, and the step is kept within [FIRE_DTMIN,FIRE_DTMAX] of it
+------------------------------------------------------------------------- */
+
+void NufebRun::fire_update()
+{
+  double **v = atom->v;
+  double **f = atom->f;
+  double *rmass = atom->rmass;
+  double *mass = atom->mass;
+  int *type = atom->type;
+  int *mask = atom->mask;
+  int nlocal = atom->nlocal;
+
+  for (int i = 0; i < nlocal; i++) {
+    v[i][0] = fire_v[i][0];
+    v[i][1] = fire_v[i][1];
+    v[i][2] = fire_v[i][2];
+  }
+
+  if (fire_dt0 == 0.0) {
+    double amax = 0.0;
+    for (int i = 0; i < nlocal; i++) {
+      if (!(mask[i] & relax_groupbit)) continue;
+      double m = rmass ? rmass[i] : mass[type[i]];
+      double f2 = f[i][0]*f[i][0] + f[i][1]*f[i][1] + f[i][2]*f[i][2];
+      amax = MAX(amax, sqrt(f2) / m);
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &amax, 1, MPI_DOUBLE, MPI_MAX, world);
+    if (amax == 0.0) return;
+    fire_dt = fire_dt0 = sqrt(fire_dmax / amax);
+  }
+
+  double power = 0.0;
+  for (int i = 0; i < nlocal; i++) {
+    if (!(mask[i] & relax_groupbit)) continue;
+    power += v[i][0]*f[i][0] + v[i][1]*f[i][1] + v[i][2]*f[i][2];
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &power, 1, MPI_DOUBLE, MPI_SUM, world);
+
+  if (power > 0.0) {
+    if (++fire_npos > FIRE_DELAY) {
+      fire_dt = MIN(fire_dt * FIRE_DTGROW, FIRE_DTMAX * fire_dt0);
+      fire_alpha *= FIRE_ALPHASHRINK;
+    }
+  } else {
+    fire_npos = 0;
+    fire_dt = MAX(fire_dt * FIRE_DTSHRINK, FIRE_DTMIN * fire_dt0);
+    fire_alpha = FIRE_ALPHA0;
+    for (int i = 0; i < nlocal; i++) {
+      if (mask[i] & relax_groupbit) v[i][0] = v[i][1] = v[i][2] = 0.0;
+    }
+  }
+
+  double norms[2] = {0.0, 0.0};
+  for (int i = 0; i < nlocal; i++) {
+    if (!(mask[i] & relax_groupbit)) continue;
+    double dtm = fire_dt / (rmass ? rmass[i] : mass[type[i]]);
+    v[i][0] += dtm * f[i][0];
+    v[i][1] += dtm * f[i][1];
+    v[i][2] += dtm * f[i][2];
+    norms[0] += v[i][0]*v[i][0] + v[i][1]*v[i][1] + v[i][2]*v[i][2];
+    norms[1] += f[i][0]*f[i][0] + f[i][1]*f[i][1] + f[i][2]*f[i][2];
+  }
+  if (power <= 0.0) return;
+
+  // mix the velocities towards the direction of the forces
+  MPI_Allreduce(MPI_IN_PLACE, norms, 2, MPI_DOUBLE, MPI_SUM, world);
+  if (norms[1] == 0.0) return;
+  double scale1 = 1.0 - fire_alpha;
+  double scale2 = fire_alpha * sqrt(norms[0] / norms[1]);
+  for (int i = 0; i < nlocal; i++) {
+    if (!(mask[i] & relax_groupbit)) continue;
+    v[i][0] = scale1 * v[i][0] + scale2 * f[i][0];
+    v[i][1] = scale1 * v[i][1] + scale2 * f[i][1];
+    v[i][2] = scale1 * v[i][2] + scale2 * f[i][2];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   grow the per-atom arrays of the active set
+------------------------------------------------------------------------- */
+
+void NufebRun::active_grow()
+{
+  active_nmax = atom->nmax;
+  memory->destroy(frozen);
+  memory->destroy(xprev);
+  memory->destroy(foff);
+  memory->destroy(toff);
+  memory->destroy(ilist_kept);
+  memory->destroy(ilist_dropped);
+  memory->create(frozen, active_nmax, "nufeb/run:frozen");
+  memory->create(xprev, active_nmax, 3, "nufeb/run:xprev");
+  memory->create(foff, active_nmax, 3, "nufeb/run:foff");
+  memory->create(toff, active_nmax, 3, "nufeb/run:toff");
+  memory->create(ilist_kept, active_nmax, "nufeb/run:ilist_kept");
+  memory->create(ilist_dropped, active_nmax, "nufeb/run:ilist_dropped");
+}
+
+/* ----------------------------------------------------------------------
+   all atoms active, called at the start of the relaxation and whenever
+   atoms are exchanged since the frozen flags are not migrated
+------------------------------------------------------------------------- */
+
+void NufebRun::active_start()
+{
+  double **x = atom->x;
+  int nlocal = atom->nlocal;
+
+  if (atom->nmax > active_nmax) active_grow();
+
+  for (int i = 0; i < nlocal; i++) {
+    frozen[i] = ACTIVE;
+    xprev[i][0] = x[i][0];
+    xprev[i][1] = x[i][1];
+    xprev[i][2] = x[i][2];
+  }
+  inum_kept = inum_dropped = 0;
+  active_dirty = 0;
+}
+
+/* ----------------------------------------------------------------------
+   store the tags of the frozen atoms before atoms are exchanged
+------------------------------------------------------------------------- */
+
+void NufebRun::active_save()
+{
+  tagint *tag = atom->tag;
+
+  frozen_tags.clear();
+  for (int i = 0; i < atom->nlocal; i++)
+    if (frozen[i] == FROZEN) frozen_tags.push_back(tag[i]);
+  std::sort(frozen_tags.begin(), frozen_tags.end());
+}
+
+/* ----------------------------------------------------------------------
+   frozen atoms that stay on this proc remain frozen after the exchange,
+   the others start active again
+------------------------------------------------------------------------- */
+
+void NufebRun::active_restore()
+{
+  active_start();
+  if (frozen_tags.empty()) return;
+
+  tagint *tag = atom->tag;
+  for (int i = 0; i < atom->nlocal; i++)
+    if (std::binary_search(frozen_tags.begin(), frozen_tags.end(), tag[i]))
+      frozen[i] = FROZEN;
+  active_dirty = 2;
+}
+
+/* ----------------------------------------------------------------------
+   the pair list is used as is at the end of the relaxation
+------------------------------------------------------------------------- */
+
+void NufebRun::active_reset()
+{
+  inum_kept = inum_dropped = 0;
+  active_dirty = 0;
+}
+
+/* ----------------------------------------------------------------------
+   split the pair list into the atoms whose interactions change and the
+   frozen atoms whose neighbors are all frozen local atoms, the forces
+   of the latter are constant and computed once here. ghost atoms are
+   always considered active
+------------------------------------------------------------------------- */
+
+void NufebRun::active_split()
+{
+  Pair *pair = force->pair;
+  NeighList *list = pair->list;
+  int nlocal = atom->nlocal;
+
+  inum_kept = inum_dropped = 0;
+  for (int ii = 0; ii < list->inum; ii++) {
+    int i = list->ilist[ii];
+    int drop = (i < nlocal) && frozen[i] == FROZEN;
+    if (drop) {
+      int *jlist = list->firstneigh[i];
+      int jnum = list->numneigh[i];
+      for (int jj = 0; jj < jnum; jj++) {
+        int j = jlist[jj] & NEIGHMASK;
+        if (j >= nlocal || frozen[j] != FROZEN) {
+          drop = 0;
+          break;
+        }
+      }
+    }
+    if (drop) ilist_dropped[inum_dropped++] = i;
+    else ilist_kept[inum_kept++] = i;
+  }
+  active_dirty = 0;
+
+  // forces and virial of the dropped atoms
+
+  force_clear();
+  for (int k = 0; k < 6; k++) voff[k] = 0.0;
+  if (inum_dropped) {
+    int inum = list->inum;
+    int *ilist = list->ilist;
+    list->inum = inum_dropped;
+    list->ilist = ilist_dropped;
+    pair->compute(eflag,vflag_step);
+    list->inum = inum;
+    list->ilist = ilist;
+    if (pair->vflag_global)
+      for (int k = 0; k < 6; k++) voff[k] = pair->virial[k];
+  }
+
+  double **f = atom->f;
+  double **torque = atom->torque;
+  for (int i = 0; i < nlocal; i++) {
+    foff[i][0] = f[i][0];
+    foff[i][1] = f[i][1];
+    foff[i][2] = f[i][2];
+    if (torqueflag) {
+      toff[i][0] = torque[i][0];
+      toff[i][1] = torque[i][1];
+      toff[i][2] = torque[i][2];
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   pair forces of the active atoms plus the stored forces of the
+   frozen ones
+------------------------------------------------------------------------- */
+
+void NufebRun::active_pair()
+{
+  Pair *pair = force->pair;
+
+  if (!inum_dropped) {
+    pair->compute(eflag,vflag);
+    return;
+  }
+
+  NeighList *list = pair->list;
+  int inum = list->inum;
+  int *ilist = list->ilist;
+  list->inum = inum_kept;
+  list->ilist = ilist_kept;
+  pair->compute(eflag,vflag);
+  list->inum = inum;
+  list->ilist = ilist;
+
+  if (pair->vflag_global)
+    for (int k = 0; k < 6; k++) pair->virial[k] += voff[k];
+
+  double **f = atom->f;
+  double **torque = atom->torque;
+  int nlocal = atom->nlocal;
+  for (int i = 0; i < nlocal; i++) {
+    if (frozen[i] != FROZEN) continue;
+    f[i][0] += foff[i][0];
+    f[i][1] += foff[i][1];
+    f[i][2] += foff[i][2];
+    if (torqueflag) {
+      torque[i][0] += toff[i][0];
+      torque[i][1] += toff[i][1];
+      torque[i][2] += toff[i][2];
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   wake a frozen atom in contact with a pushing atom
+------------------------------------------------------------------------- */
+
+void NufebRun::active_wake(int i)
+{
+  if (frozen[i] == FROZEN) {
+    frozen[i] = ACTIVE;
+    active_dirty = 2;
+  } else if (frozen[i] == FREEZING) {
+    frozen[i] = ACTIVE;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   freeze the atoms with small force and displacement, wake the frozen
+   atoms with a large force or in contact with an active atom with a
+   large force. frozen atoms are held in place by clearing their forces
+   and velocities before the time integration
+   return the # of active atoms
+------------------------------------------------------------------------- */
+
+bigint NufebRun::active_update()
+{
+  double **x = atom->x;
+  double **v = atom->v;
+  double **f = atom->f;
+  double **omega = atom->omega;
+  double **angmom = atom->angmom;
+  double **torque = atom->torque;
+  int *mask = atom->mask;
+  int nlocal = atom->nlocal;
+  double ftol2 = active_ftol * active_ftol;
+  double dtol2 = active_dtol * active_dtol;
+
+  int npush = 0;
+  for (int i = 0; i < nlocal; i++) {
+    if (!(mask[i] & relax_groupbit)) continue;
+    double f2 = f[i][0]*f[i][0] + f[i][1]*f[i][1] + f[i][2]*f[i][2];
+    if (f2 > ftol2) {
+      // the forces cached for the neighbors become invalid
+      if (frozen[i] == FROZEN) active_dirty = 2;
+      frozen[i] = PUSHING;
+      npush++;
+    } else if (frozen[i] == ACTIVE) {
+      double dx = x[i][0] - xprev[i][0];
+      double dy = x[i][1] - xprev[i][1];
+      double dz = x[i][2] - xprev[i][2];
+      if (dx*dx + dy*dy + dz*dz < dtol2) frozen[i] = FREEZING;
+    }
+    xprev[i][0] = x[i][0];
+    xprev[i][1] = x[i][1];
+    xprev[i][2] = x[i][2];
+  }
+
+  // the neighbors of a dropped atom were all frozen, only
+  // a dropped atom that pushes can wake them
+
+  if (npush) {
+    NeighList *list = force->pair->list;
+    int inum = inum_dropped ? inum_kept : list->inum;
+    int *ilist = inum_dropped ? ilist_kept : list->ilist;
+    for (int ii = 0; ii < inum; ii++) {
+      int i = ilist[ii];
+      int *jlist = list->firstneigh[i];
+      int jnum = list->numneigh[i];
+      for (int jj = 0; jj < jnum; jj++) {
+        int j = jlist[jj] & NEIGHMASK;
+        if (j >= nlocal) continue;
+        if (frozen[i] == PUSHING) active_wake(j);
+        else if (frozen[j] == PUSHING) active_wake(i);
+      }
+    }
+    for (int ii = 0; ii < inum_dropped; ii++) {
+      int i = ilist_dropped[ii];
+      if (frozen[i] != PUSHING) continue;
+      int *jlist = list->firstneigh[i];
+      int jnum = list->numneigh[i];
+      for (int jj = 0; jj < jnum; jj++)
+        active_wake(jlist[jj] & NEIGHMASK);
+    }
+  }
+
+  bigint nactive = 0;
+  for (int i = 0; i < nlocal; i++) {
+    if (!(mask[i] & relax_groupbit)) continue;
+    if (frozen[i] == FREEZING) {
+      frozen[i] = FROZEN;
+      if (!active_dirty) active_dirty = 1;
+    } else if (frozen[i] != FROZEN) {
+      frozen[i] = ACTIVE;
+      nactive++;
+      continue;
+    }
+    f[i][0] = f[i][1] = f[i][2] = 0.0;
+    v[i][0] = v[i][1] = v[i][2] = 0.0;
+    if (relax_flag) fire_v[i][0] = fire_v[i][1] = fire_v[i][2] = 0.0;
+    if (torqueflag) torque[i][0] = torque[i][1] = torque[i][2] = 0.0;
+    if (atom->omega_flag) omega[i][0] = omega[i][1] = omega[i][2] = 0.0;
+    if (atom->angmom_flag) angmom[i][0] = angmom[i][1] = angmom[i][2] = 0.0;
+  }
+
+  MPI_Allreduce(MPI_IN_PLACE, &nactive, 1, MPI_LMP_BIGINT, MPI_SUM, world);
+  return nactive;
+}
+
 /* ---------------------------------------------------------------------- */
 
 void NufebRun::module_post_physics ()
@@ -716,9 +1536,23 @@ int NufebRun::module_chemistry()
 {
   // reset to diffusion timestep
 
+  if (diffdt_auto) diffdt = stable_diffdt();
   update->dt = diffdt;
   reset_dt();
 
+  // initial guess extrapolated from the last converged fields
+  // closed systems are advanced in time by closed_system_scaleup() and
+  // substrates without diffusion fix are not iterated, both keep their
+  // current concentrations
+  double biotime = update->atime + (update->ntimestep - update->atimestep) * biodt;
+  if (warm_order) {
+    int warm_flag[grid->nsubs];
+    for (int s = 0; s < grid->nsubs; s++) warm_flag[s] = 0;
+    for (int i = 0; i < nfix_diffusion; i++)
+      if (!fix_diffusion[i]->closed_system) warm_flag[fix_diffusion[i]->isub] = 1;
+    grid->warm_start(biotime, warm_flag);
+  }
+
 //  for (int i = 0; i < nfix_diffusion; i++) {
 //    fix_diffusion[i]->closed_system_initial();
 //  }
@@ -726,43 +1560,98 @@ int NufebRun::module_chemistry()
   int niter = 0;
   bool conv_flag;
   bool converge[nfix_diffusion];
+  double result[nfix_diffusion];
   for (int i = 0; i < nfix_diffusion; i++) {
       converge[i] = false;
+      result[i] = 0.0;
     }
 
+  if (anderson) anderson->reset();
+
+  // with a single ghost layer, the halo exchange is overlapped with the
+  // chemistry and the update of the cells that do not depend on ghost
+  // cells. with a deep halo, reaction terms and diffusion coefficients
+  // are exchanged together with concentrations once per iteration,
+  // and each fix performs grid->nghost sweeps on the enlarged sub-domain
+
+  int deep = grid->nghost > 1;
+
   do {
-      timer->stamp();
-      comm_grid->forward_comm();
-      timer->stamp(Timer::COMM);
+      // the residuals are only computed every diffcheck iterations
+      int check = (niter + 1) % diffcheck == 0;
 
       for (int i = 0; i < nfix_diffusion; i++) {
           fix_diffusion[i]->compute_initial();
+          fix_diffusion[i]->check = check;
         }
 
+      if (!deep) {
+        timer->stamp();
+        comm_grid->forward_comm_begin();
+        timer->stamp(Timer::COMM);
+      }
+
       // call all fixes implementing chemistry_nufeb()
       if (modify->n_chemistry_nufeb) {
           timer->stamp();
+          grid->cache_saturation(1);
           modify->chemistry_nufeb();
+          grid->cache_saturation(0);
           timer->stamp(Timer::MODIFY);
         }
 
-      conv_flag = true;
+      if (deep) {
+        timer->stamp();
+        comm_grid->forward_comm();
+        timer->stamp(Timer::COMM);
+      } else {
+        for (int i = 0; i < nfix_diffusion; i++) {
+            if (!converge[i])
+              fix_diffusion[i]->compute_interior();
+          }
+        timer->stamp(Timer::MODIFY);
+        comm_grid->forward_comm_end();
+        timer->stamp(Timer::COMM);
+      }
+
       for (int i = 0; i < nfix_diffusion; i++) {
           if (converge[i]) continue;
-          fix_diffusion[i]->compute_final();
-          double res = fix_diffusion[i]->compute_scalar();
-          if (res < difftol) converge[i] = true;
-          if (!converge[i]) conv_flag = false;
+          if (deep) fix_diffusion[i]->compute_final();
+          else fix_diffusion[i]->compute_boundary();
+          result[i] = fix_diffusion[i]->residual;
         }
 
+      // residuals of all substrates are reduced at once
+
+      conv_flag = false;
+      if (check) {
+        timer->stamp(Timer::MODIFY);
+        MPI_Allreduce(MPI_IN_PLACE, result, nfix_diffusion, MPI_DOUBLE, MPI_MAX, world);
+        timer->stamp(Timer::COMM);
+
+        // with acceleration all substrates are iterated until all converge
+        conv_flag = true;
+        for (int i = 0; i < nfix_diffusion; i++) {
+            if (result[i] < difftol && !anderson) converge[i] = true;
+            if (!converge[i] && result[i] >= difftol) conv_flag = false;
+          }
+      }
+
       timer->stamp(Timer::MODIFY);
       ++niter;
 
       if (diffmax > 0 && niter >= diffmax)
         conv_flag = true;
 
+      if (anderson && !conv_flag) {
+        anderson->mix();
+        timer->stamp(Timer::MODIFY);
+      }
+
     } while (!conv_flag);
 
+  grid->warm_store(biotime);
+
   for (int i = 0; i < nfix_diffusion; i++) {
       fix_diffusion[i]->closed_system_scaleup(biodt);
     }
@@ -770,6 +1659,29 @@ int NufebRun::module_chemistry()
   return niter;
 }
 
+/* ----------------------------------------------------------------------
+   largest stable diffusion timestep of the explicit solver, scaled by
+   diffsafety, from the current diffusion coefficients of all substrates
+   using it. the previous value is kept if no substrate uses it
+------------------------------------------------------------------------- */
+
+double NufebRun::stable_diffdt()
+{
+  double dmax = 0.0;
+  for (int i = 0; i < nfix_diffusion; i++) {
+    if (fix_diffusion[i]->solver != FixDiffusionReaction::EXPLICIT) continue;
+    double *d = grid->diff_coeff[fix_diffusion[i]->isub];
+    for (int j = 0; j < grid->ncells; j++)
+      if (grid->mask[j] & GRID_MASK) dmax = MAX(dmax, d[j]);
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &dmax, 1, MPI_DOUBLE, MPI_MAX, world);
+  if (dmax <= 0.0) return diffdt;
+
+  // forward Euler with the 7-point stencil is stable for dt <= h^2/(6D)
+  double h = grid->cell_size;
+  return diffsafety * h * h / (6.0 * dmax);
+}
+
 /* ---------------------------------------------------------------------- */
 
 void NufebRun::module_reactor()
@@ -21,6 +21,7 @@ IntegrateStyle(nufeb,NufebRun)
 #define LMP_NUFEB_RUN_H
 
 #include "integrate.h"
+#include <vector>
 
 namespace LAMMPS_NS {
 
@@ -47,15 +48,52 @@ class NufebRun : public Integrate {
 
   double biodt;
   double diffdt;
+  int diffdt_auto;                  // 1 to set diffdt from the stability limit
+  double diffsafety;                // fraction of the stability limit used
   double difftol;
   int diffmax;
+  int diffcheck;                    // check convergence every this many iterations
   double pairdt;
   double pairtol;
   int pairmax;
+  int paircheck;                    // # of relaxation steps between convergence checks
+  enum{PRESSURE,FORCE};
+  int pairconv;                     // convergence measure of the relaxation
+  int vflag_step;                   // vflag set by ev_set() for the biological step
   int nfix_diffusion;
+  int anderson_depth;               // # of iterates mixed by Anderson acceleration
+  int warm_order;                   // order of the warm-start extrapolation, 0 = off
+  int biodt_flag;                   // 1 to adapt biodt to the growth integration error
+  double biotol;                    // max relative biomass error per step
+  double biodt_min, biodt_max;
+  double *growth_prev;              // growth rates of the previous step
+  int nprev;
+  int prev_flag;                    // 1 if growth_prev is valid
+  int relax_flag;                   // 0 = damped DEM steps, 1 = FIRE minimizer
+  double fire_dmax;                 // largest displacement per FIRE iteration
+  double fire_dt;                   // current FIRE step
+  double fire_dt0;                  // first FIRE step of the relaxation
+  double fire_alpha;                // current FIRE mixing coefficient
+  int fire_npos;                    // # of consecutive steps with F.v > 0
+  int relax_groupbit;               // atoms moved by the relaxation
+  double **fire_v;                  // FIRE velocities while forces are computed
+  int fire_nmax;
+  int active_flag;                  // 1 if frozen atoms are skipped
+  double active_ftol;               // force below which an atom can freeze
+  double active_dtol;               // displacement below which an atom can freeze
+  int active_dirty;                 // 1 if atoms froze, 2 if atoms woke up
+  int active_nmax;
+  int *frozen;                      // state of each atom
+  double **xprev;                   // positions at the previous step
+  double **foff, **toff;            // constant forces of the dropped atoms
+  double voff[6];                   // constant virial of the dropped atoms
+  int *ilist_kept, *ilist_dropped;  // split of the pair list
+  int inum_kept, inum_dropped;
+  std::vector<tagint> frozen_tags;  // frozen atoms while atoms are exchanged
 
   class FixDensity *fix_density;
   class FixDiffusionReaction **fix_diffusion;
+  class DiffusionAnderson *anderson;
   class ComputePressure *comp_pressure;
   class ComputeKE *comp_ke;
   class ComputeVolume *comp_volume;
@@ -64,7 +102,23 @@ class NufebRun : public Integrate {
   
   virtual void module_biology();
   virtual int module_chemistry();
+  double stable_diffdt();
+  void adapt_biodt();
   virtual double module_physics();
+  double pair_residual(double);
+  void fire_start();
+  void fire_move();
+  void fire_hide();
+  void fire_update();
+  void active_grow();
+  void active_start();
+  void active_reset();
+  void active_save();
+  void active_restore();
+  void active_split();
+  void active_pair();
+  bigint active_update();
+  void active_wake(int);
   virtual void module_post_physics();
   virtual void module_reactor();
   double get_time();
@@ -82,6 +136,33 @@ W: No fixes defined, atoms won't move
 If you are not using a fix like nve, nvt, npt then atom velocities and
 coordinates will not be updated during timestepping.
 
+E: Illegal run_style nufeb command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.
+
+E: Run_style nufeb diffaccel is incompatible with fix nufeb/diffusion_reaction freeze
+
+Frozen blocks cannot be combined with the accelerated iterates.
+
+E: Run_style nufeb biodt adaptive requires 0 < dtmin <= dtmax
+
+Self-explanatory.
+
+E: Run_style nufeb relax fire requires a time integration fix
+
+The FIRE minimizer moves the atoms of the groups of the time
+integration fixes (e.g. fix nve/limit), at least one must be defined.
+
+E: Run_style nufeb relax fire does not support rotational degrees of freedom (e.g. atom_style bacillus)
+
+The FIRE minimizer only relaxes the positions of the atoms. Atom
+styles with angular momentum, such as bacillus, must use relax dem.
+
+E: Run_style nufeb pairactive requires a pair style
+
+Self-explanatory.
+
 E: KOKKOS package requires run_style verlet/kk
 
 The KOKKOS package requires the Kokkos version of run_style verlet; the
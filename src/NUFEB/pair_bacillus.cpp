@@ -59,6 +59,8 @@ PairBacillus::PairBacillus(LAMMPS *lmp) : Pair(lmp)
 
 PairBacillus::~PairBacillus()
 {
+  if (copymode) return;
+
   if (allocated) {
     memory->destroy(setflag);
     memory->destroy(cutsq);
@@ -148,18 +150,25 @@ void PairBacillus::compute(int eflag, int vflag)
 
       if (ishape == SPHERE && jshape == SPHERE) {
         sphere_against_sphere(i, j, itype, jtype, delx, dely, delz,
-                              rsq, v, f, radi, radj, evflag);
+                              rsq, v, f, radi, radj, evdwl, facc);
+        if (evflag) ev_tally_xyz(i,j,nlocal,newton_pair,evdwl,0.0,
+                                 facc[0],facc[1],facc[2],delx,dely,delz);
         continue;
       }
 
       // one of the two bacillus is a sphere
+      double del[3];
       if (jshape == SPHERE) {
-        sphere_against_rod(i, j, itype, jtype, x, v, f, torque,
-                            angmom, ibonus, evflag);
+        if (sphere_against_rod(i, j, itype, jtype, x, v, f, torque,
+                               angmom, ibonus, evdwl, facc, del) && evflag)
+          ev_tally_xyz(i,j,nlocal,newton_pair,evdwl,0.0,
+                       facc[0],facc[1],facc[2],del[0],del[1],del[2]);
         continue;
       } else if (ishape == SPHERE) {
-        sphere_against_rod(j, i, jtype, itype, x, v, f, torque,
-                            angmom, jbonus, evflag);
+        if (sphere_against_rod(j, i, jtype, itype, x, v, f, torque,
+                               angmom, jbonus, evdwl, facc, del) && evflag)
+          ev_tally_xyz(j,i,nlocal,newton_pair,evdwl,0.0,
+                       facc[0],facc[1],facc[2],del[0],del[1],del[2]);
         continue;
       }
 
@@ -349,15 +358,18 @@ double PairBacillus::init_one(int i, int j)
 /* ----------------------------------------------------------------------
    Interaction between two spheres with different radii
    according to the 2D model from Fraige et al.
+   the energy and the force on i are returned in energy and facc
+   for tallying by the caller
 ---------------------------------------------------------------------- */
 
 void PairBacillus::sphere_against_sphere(int i, int j,
   int itype, int jtype, double delx, double dely, double delz, double rsq,
-  double** v, double** f, double rradi, double rradj, int evflag)
+  double** v, double** f, double rradi, double rradj, double &energy,
+  double* facc)
 {
   double contact_dist;
   double vr1,vr2,vr3,vnnr,vn1,vn2,vn3,vt1,vt2,vt3;
-  double rij,rsqinv,R,fx,fy,fz,fn[3],ft[3],fpair, energy;
+  double rij,rsqinv,R,fx,fy,fz,fn[3],ft[3],fpair;
   int nlocal = atom->nlocal;
   int newton_pair = force->newton_pair;
 
@@ -422,21 +434,24 @@ void PairBacillus::sphere_against_sphere(int i, int j,
     f[j][2] -= fz;
   }
 
-  if (evflag) ev_tally_xyz(i,j,nlocal,newton_pair,
-                           energy,0.0,fx,fy,fz,delx,dely,delz);
+  facc[0] = fx; facc[1] = fy; facc[2] = fz;
 }
 
 /* ----------------------------------------------------------------------
    Interaction bt a rod (irod) and a sphere (jsphere)
+   the energy, the force on i and the separation vector are returned
+   in energy, facc and del for tallying by the caller
+   return 0 if the bodies do not interact
 ---------------------------------------------------------------------- */
 
-void PairBacillus::sphere_against_rod(int i, int j,
+int PairBacillus::sphere_against_rod(int i, int j,
   int itype, int jtype, double** x, double** v, double** f, double** torque,
-  double** angmom, AtomVecBacillus::Bonus *&ibonus, int evflag)
+  double** angmom, AtomVecBacillus::Bonus *&ibonus, double &energy,
+  double* facc, double* del)
 {
   int ni,nei,ifirst,iefirst,npi1,npi2;
   double xi1[3],xi2[3],vti[3],h[3],fn[3],ft[3],d,t;
-  double delx,dely,delz,rsq,rij,rsqinv,R,fx,fy,fz,fpair,energy;
+  double delx,dely,delz,rsq,rij,rsqinv,R,fx,fy,fz,fpair;
   double radi,radj,leni,contact_dist;
   double vr1,vr2,vr3,vnnr,vn1,vn2,vn3,vt1,vt2,vt3;
   double *quat, *inertia;
@@ -454,8 +469,8 @@ void PairBacillus::sphere_against_rod(int i, int j,
   // find shortest distance between i and j
   distance_bt_pt_rod(x[j], xi1, xi2, h, d, t);
 
-  if (d > contact_dist + cutoff) return;
-  if (t < 0 || t > 1) return;
+  if (d > contact_dist + cutoff) return 0;
+  if (t < 0 || t > 1) return 0;
 
   delx = h[0] - x[j][0];
   dely = h[1] - x[j][1];
@@ -528,8 +543,9 @@ void PairBacillus::sphere_against_rod(int i, int j,
     f[j][2] -= fz;
   }
 
-  if (evflag) ev_tally_xyz(i,j,nlocal,newton_pair,
-                         energy,0.0,fx,fy,fz,delx,dely,delz);
+  facc[0] = fx; facc[1] = fy; facc[2] = fz;
+  del[0] = delx; del[1] = dely; del[2] = delz;
+  return 1;
 }
 
 /* ----------------------------------------------------------------------
@@ -555,7 +571,7 @@ void PairBacillus::rod_against_rod(int i, int j, int itype, int jtype,
 {
   double xi1[3],xi2[3],xpj1[3],xpj2[3];
   double r,t1,t2,h1[3],h2[3];
-  double contact_dist, energy;
+  double contact_dist, energy = 0.0;
 
   avec->get_pole_coords(i, xi1, xi2);
   avec->get_pole_coords(j, xpj1, xpj2);
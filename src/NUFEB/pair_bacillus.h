@@ -66,12 +66,12 @@ class PairBacillus : public Pair {
   void sphere_against_sphere(int ibody, int jbody, int itype, int jtype,
                              double delx, double dely, double delz, double rsq,
                              double** v, double** f, double radi,
-			     double radj, int evflag);
+			     double radj, double &energy, double* facc);
   // sphere-rod interaction
-  void sphere_against_rod(int ibody, int jbody, int itype, int jtype,
+  int sphere_against_rod(int ibody, int jbody, int itype, int jtype,
                            double** x, double** v, double** f, double** torque,
                            double** angmom, AtomVecBacillus::Bonus *&ibonus,
-			   int evflag);
+			   double &energy, double* facc, double* del);
 
   // rod-rod interactions
   void rod_against_rod(int ibody, int jbody, int itype, int jtype,
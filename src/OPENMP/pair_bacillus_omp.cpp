@@ -0,0 +1,184 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   http://lammps.sandia.gov, Sandia National Laboratories
+   Steve Plimpton, sjplimp@sandia.gov
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "omp_compat.h"
+#include <cmath>
+#include "pair_bacillus_omp.h"
+#include "atom.h"
+#include "comm.h"
+#include "force.h"
+#include "neigh_list.h"
+
+#include "suffix.h"
+using namespace LAMMPS_NS;
+
+enum {SPHERE,ROD};
+
+/* ---------------------------------------------------------------------- */
+
+PairBacillusOMP::PairBacillusOMP(LAMMPS *lmp) :
+  PairBacillus(lmp), ThrOMP(lmp, THR_PAIR)
+{
+  suffix_flag |= Suffix::OMP;
+  respa_enable = 0;
+}
+
+/* ----------------------------------------------------------------------
+   the atoms of the list are split among the threads, the forces and
+   torques of each thread are accumulated in its own arrays and summed
+   by reduce_thr(). the contact kernels of PairBacillus only read the
+   shared atom and bonus data
+------------------------------------------------------------------------- */
+
+void PairBacillusOMP::compute(int eflag, int vflag)
+{
+  ev_init(eflag,vflag);
+
+  const int nall = atom->nlocal + atom->nghost;
+  const int nthreads = comm->nthreads;
+  const int inum = list->inum;
+
+#if defined(_OPENMP)
+#pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(eflag,vflag)
+#endif
+  {
+    int ifrom, ito, tid;
+
+    loop_setup_thr(ifrom, ito, tid, inum, nthreads);
+    ThrData *thr = fix->get_thr(tid);
+    thr->timer(Timer::START);
+    ev_setup_thr(eflag, vflag, nall, eatom, vatom, nullptr, thr);
+
+    if (evflag) eval<1>(ifrom, ito, thr);
+    else eval<0>(ifrom, ito, thr);
+
+    thr->timer(Timer::PAIR);
+    reduce_thr(this, eflag, vflag, thr);
+  } // end of omp parallel region
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <int EVFLAG>
+void PairBacillusOMP::eval(int iifrom, int iito, ThrData * const thr)
+{
+  int i,j,ii,jj,jnum,itype,jtype;
+  double rsq, leni, lenj, radi, radj;
+  int ishape, jshape;
+  double xtmp,ytmp,ztmp,delx,dely,delz,evdwl,facc[3],del[3];
+  int *ilist,*jlist,*numneigh,**firstneigh;
+
+  double **x = atom->x;
+  double **v = atom->v;
+  double **f = thr->get_f();
+  double **torque = thr->get_torque();
+  double **angmom = atom->angmom;
+  int *bacillus = atom->bacillus;
+  int *type = atom->type;
+  const int nlocal = atom->nlocal;
+
+  AtomVecBacillus::Bonus *ibonus = nullptr;
+  AtomVecBacillus::Bonus *jbonus;
+
+  ilist = list->ilist;
+  numneigh = list->numneigh;
+  firstneigh = list->firstneigh;
+
+  // loop over neighbors of my atoms, newton pair is always on
+
+  for (ii = iifrom; ii < iito; ii++) {
+    i = ilist[ii];
+    if (bacillus[i] < 0) continue;
+
+    xtmp = x[i][0];
+    ytmp = x[i][1];
+    ztmp = x[i][2];
+    itype = type[i];
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+
+    ibonus = &avec->bonus[bacillus[i]];
+    leni = ibonus->length/2;
+    radi = ibonus->diameter/2;
+    ishape = leni == 0 ? SPHERE : ROD;
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      j &= NEIGHMASK;
+      if (bacillus[j] < 0) continue;
+
+      delx = xtmp - x[j][0];
+      dely = ytmp - x[j][1];
+      delz = ztmp - x[j][2];
+      rsq = delx*delx + dely*dely + delz*delz;
+      jtype = type[j];
+
+      evdwl = 0.0;
+      facc[0] = facc[1] = facc[2] = 0;
+
+      jbonus = &avec->bonus[bacillus[j]];
+      lenj = jbonus->length/2;
+      radj = jbonus->diameter/2;
+      jshape = lenj == 0 ? SPHERE : ROD;
+
+      // no interaction
+      double r = sqrt(rsq);
+      if (r > radi+radj+leni+lenj+cutoff) continue;
+
+      if (ishape == SPHERE && jshape == SPHERE) {
+        sphere_against_sphere(i, j, itype, jtype, delx, dely, delz,
+                              rsq, v, f, radi, radj, evdwl, facc);
+        if (EVFLAG) ev_tally_xyz_thr(this,i,j,nlocal,1,evdwl,0.0,
+                                     facc[0],facc[1],facc[2],delx,dely,delz,thr);
+        continue;
+      }
+
+      if (jshape == SPHERE) {
+        if (sphere_against_rod(i, j, itype, jtype, x, v, f, torque,
+                               angmom, ibonus, evdwl, facc, del) && EVFLAG)
+          ev_tally_xyz_thr(this,i,j,nlocal,1,evdwl,0.0,
+                           facc[0],facc[1],facc[2],del[0],del[1],del[2],thr);
+        continue;
+      } else if (ishape == SPHERE) {
+        if (sphere_against_rod(j, i, jtype, itype, x, v, f, torque,
+                               angmom, jbonus, evdwl, facc, del) && EVFLAG)
+          ev_tally_xyz_thr(this,j,i,nlocal,1,evdwl,0.0,
+                           facc[0],facc[1],facc[2],del[0],del[1],del[2],thr);
+        continue;
+      }
+
+      int contact = 0;
+      Contact contact_list;
+
+      rod_against_rod(i, j, itype, jtype, x, v, f, torque, angmom, ibonus,
+                      jbonus, contact, contact_list, evdwl, facc);
+
+      if (contact > 0)
+        rescale_cohesive_forces(x, f, torque, contact_list, contact,
+                                itype, jtype, facc);
+
+      if (EVFLAG) ev_tally_xyz_thr(this,i,j,nlocal,1,evdwl,0.0,
+                                   facc[0],facc[1],facc[2],delx,dely,delz,thr);
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+double PairBacillusOMP::memory_usage()
+{
+  double bytes = memory_usage_thr();
+  bytes += PairBacillus::memory_usage();
+
+  return bytes;
+}
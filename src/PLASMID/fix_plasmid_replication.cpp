@@ -52,6 +52,7 @@ FixPlasmidReplication::FixPlasmidReplication(LAMMPS *lmp, int narg, char **arg)
   seed = utils::inumeric(FLERR,arg[3],true,lmp);
   // Random number generator, same for all procs
   random = new RanPark(lmp, seed);
+  grid->add_group(igroup);
 
   auto fixlist = modify->get_fix_by_style("^nufeb/property/plasmid");
   if (fixlist.size() != 1)
@@ -142,8 +143,8 @@ void FixPlasmidReplication::replication(int i)
   double current_t = update->ntimestep * update->dt;
   double next_t = (update->ntimestep + 1) * update->dt;
 
-  const int cell = grid->cell(atom->x[i]);
-  double growth = grid->growth[igroup][cell][0];
+  const int cell = grid->atom_cells()[i];
+  double growth = grid->growth[igroup][cell];
 
   double *plm_x = fix_plm->plm_x[i];
   double *vprop = fix_plm->vprop;
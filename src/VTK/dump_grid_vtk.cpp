@@ -52,6 +52,8 @@ void DumpGridVTK::init_style() {
     } else if (*it == "rea") {
       packs.push_back(std::bind(&DumpGridVTK::pack_reaction, this, _1));
     } else if (*it == "den") {
+      for (int igroup = 0; igroup < group->ngroup; igroup++)
+        grid->add_group(igroup);
       packs.push_back(std::bind(&DumpGridVTK::pack_density, this, _1));
     } else if (*it == "gro") {
       packs.push_back(std::bind(&DumpGridVTK::pack_growth, this, _1));
@@ -61,11 +63,12 @@ void DumpGridVTK::init_style() {
 
 void DumpGridVTK::write() {
   vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
-  image->SetDimensions(grid->subbox[0] - 1, grid->subbox[1] - 1, grid->subbox[2] - 1);
+  int n = 2 * grid->nghost - 1;
+  image->SetDimensions(grid->subbox[0] - n, grid->subbox[1] - n, grid->subbox[2] - n);
   image->SetSpacing(grid->cell_size, grid->cell_size, grid->cell_size);
   double origin[3];
   for (int i = 0; i < 3; i++)
-    origin[i] = grid->cell_size * (grid->sublo[i] + 1) - domain->boxlo[i];
+    origin[i] = grid->cell_size * (grid->sublo[i] + grid->nghost) - domain->boxlo[i];
   image->SetOrigin(origin[0], origin[1], origin[2]);
 
   for (auto it = packs.begin(); it != packs.end(); ++it) {
@@ -122,7 +125,8 @@ void DumpGridVTK::pack_density(vtkSmartPointer<vtkImageData> image) {
 }
 
 void DumpGridVTK::pack_growth(vtkSmartPointer<vtkImageData> image) {
-  pack_tuple<2>(image, "growth", grid->growth, group->names, group->ngroup);
+  double **fields[2] = {grid->growth, grid->eps_rate};
+  pack_tuple<2>(image, "growth", fields, group->names, group->ngroup);
 }
 
 void DumpGridVTK::pack_tuple1(vtkSmartPointer<vtkImageData> image, const char *name, double *data) {
@@ -163,7 +167,7 @@ void DumpGridVTK::pack_tuple(vtkSmartPointer<vtkImageData> image, const char *na
       if (!(grid->mask[i] & GHOST_MASK)) {
         double tuple[N];
         for (int j = 0; j < N; j++)
-          tuple[j] = data[n][i][j];
+          tuple[j] = data[j][n][i];
         array->InsertNextTuple(tuple);
       }
     }
@@ -271,6 +271,7 @@ Atom::Atom(LAMMPS *lmp) : Pointers(lmp)
 
   atom_style = nullptr;
   avec = nullptr;
+  avec_host = nullptr;
 
   avec_map = new AtomVecCreatorMap();
 
@@ -653,6 +654,7 @@ void Atom::create_avec(const std::string &style, int narg, char **arg, int trysu
   if (avec) delete avec;
   atom_style = nullptr;
   avec = nullptr;
+  avec_host = nullptr;
 
   // unset atom style and array existence flags
   // may have been set by old avec
@@ -781,12 +783,15 @@ std::string Atom::get_style()
 
 /* ----------------------------------------------------------------------
    return ptr to AtomVec class if matches style or to matching hybrid sub-class
+   for an accelerated style (e.g. bacillus/kk) return its host AtomVec
    return nullptr if no match
 ------------------------------------------------------------------------- */
 
 AtomVec *Atom::style_match(const char *style)
 {
   if (strcmp(atom_style,style) == 0) return avec;
+  else if (avec_host && utils::strmatch(atom_style,fmt::format("^{}/",style)))
+    return avec_host;
   else if (strcmp(atom_style,"hybrid") == 0) {
     auto avec_hybrid = dynamic_cast<AtomVecHybrid *>(avec);
     for (int i = 0; i < avec_hybrid->nstyles; i++)
@@ -29,6 +29,7 @@ class Atom : protected Pointers {
  public:
   char *atom_style;
   AtomVec *avec;
+  AtomVec *avec_host;    // host AtomVec of an accelerated style, if any
   enum { DOUBLE, INT, BIGINT };
   enum { GROW = 0, RESTART = 1, BORDER = 2 };
   enum { ATOMIC = 0, MOLECULAR = 1, TEMPLATE = 2 };
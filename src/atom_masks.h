@@ -109,5 +109,6 @@
 #define OUTER_MASS_MASK   0x02000000
 #define OUTER_RADIUS_MASK 0x04000000
 #define BIOMASS_MASK      0x08000000
+#define BACILLUS_MASK     0x10000000
 
 #endif
@@ -53,6 +53,9 @@ CommGrid::CommGrid(LAMMPS *lmp) : Pointers(lmp)
   buf_self = nullptr;
   
   requests = nullptr;
+
+  npersist = -1;
+  persist = nullptr;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -74,6 +77,7 @@ CommGrid::~CommGrid()
   memory->destroy(buf_self);
 
   delete [] requests;
+  free_persist();
 }
 
 /* ---------------------------------------------------------------------- */
@@ -116,237 +120,64 @@ void CommGrid::setup()
   IntersectList recvlist(lmp, comm->nprocs);
   IntersectList sendlist(lmp, comm->nprocs);
 
+  // receive the ghost cells owned by other procs (and their periodic
+  // images), send the owned cells in the ghost region of other procs.
+  // the order of periodic images must be the same on both sides,
+  // an image shifted by s on the receiving side is shifted by -s on
+  // the sending side
+
+  int nghost = grid->nghost;
   int lo[3];
   int hi[3];
+  int pbc[3];
+  for (int d = 0; d < 3; d++)
+    pbc[d] = grid->periodic[d] ? 1 : 0;
+
   for (int p = 0; p < comm->nprocs; p++) {
-    if (comm->me != p) {
-      int n = intersect(grid->sublo, grid->subhi, &boxlo[3*p], &boxhi[3*p],
-			0, -1, 0, 0, 0, lo, hi, false);
-      if (n > 0) {
-        recvproc[nrecvproc] = p;
-        recv_begin[nrecvproc] = nrecv;
-        nrecv += n;
-        recv_end[nrecvproc++] = nrecv;
-        recvlist.add(p, lo, hi, n);
-      }
-      n = intersect(grid->sublo, grid->subhi, &boxlo[3*p], &boxhi[3*p],
-		    -1, 0, 0, 0, 0, lo, hi, false);
-      if (n > 0) {
-        sendproc[nsendproc] = p;
-        send_begin[nsendproc] = nsend;
-        nsend += n;
-        send_end[nsendproc++] = nsend;
-        sendlist.add(p, lo, hi, n);
-      }
-    }
-    if (grid->periodic[0]) {
-      int n = intersect(grid->sublo, grid->subhi, &boxlo[3*p], &boxhi[3*p],
-			0, -1, -grid->box[0], 0, 0, lo, hi, false);
-      if (n > 0) {
-        if (comm->me != p) {
-          if (nrecvproc > 0 && recvproc[nrecvproc-1] == p) {
-            recv_end[nrecvproc-1] += n;
-          } else {
-            recvproc[nrecvproc] = p;
-            recv_begin[nrecvproc] = nrecv;
-            recv_end[nrecvproc++] = nrecv + n;
-          }
-          nrecv += n;
-        } else {
-          nrecv_self += n;
-        }
-        recvlist.add(p, lo, hi, n);
-      }
-      n = intersect(grid->sublo, grid->subhi, &boxlo[3*p], &boxhi[3*p],
-		    -1, 0, grid->box[0], 0, 0, lo, hi, false);
-      if (n > 0) {
-        if (comm->me != p) {
-          if (nsendproc > 0 && sendproc[nsendproc-1] == p) {
-            send_end[nsendproc-1] += n;
-          } else {
-            sendproc[nsendproc] = p;
-            send_begin[nsendproc] = nsend;
-            send_end[nsendproc++] = nsend + n;
-          }
-          nsend += n;
-        } else {
-          nsend_self += n;
-        }
-        sendlist.add(p, lo, hi, n);
-      }
-      n = intersect(grid->sublo, grid->subhi, &boxlo[3*p], &boxhi[3*p],
-		    0, -1, grid->box[0], 0, 0, lo, hi, false);
-      if (n > 0) {
-        if (comm->me != p) {
-          if (nrecvproc > 0 && recvproc[nrecvproc-1] == p) {
-            recv_end[nrecvproc-1] += n;
-          } else {
-            recvproc[nrecvproc] = p;
-            recv_begin[nrecvproc] = nrecv;
-            recv_end[nrecvproc++] = nrecv + n;
-          }
-          nrecv += n;
-        } else {
-          nrecv_self += n;
-        }
-        recvlist.add(p, lo, hi, n);
-      }
-      n = intersect(grid->sublo, grid->subhi, &boxlo[3*p], &boxhi[3*p],
-		    -1, 0, -grid->box[0], 0, 0, lo, hi, false);
-      if (n > 0) {
-        if (comm->me != p) {
-          if (nsendproc > 0 && sendproc[nsendproc-1] == p) {
-            send_end[nsendproc-1] += n;
-          } else {
-            sendproc[nsendproc] = p;
-            send_begin[nsendproc] = nsend;
-            send_end[nsendproc++] = nsend + n;
-          }
-          nsend += n;
-        } else {
-          nsend_self += n;
-        }
-        sendlist.add(p, lo, hi, n);
-      }
-    }
-    if (grid->periodic[1]) {
-      int n = intersect(grid->sublo, grid->subhi, &boxlo[3*p], &boxhi[3*p],
-			0, -1, 0, -grid->box[1], 0, lo, hi, false);
-      if (n > 0) {
-        if (comm->me != p) {
-          if (nrecvproc > 0 && recvproc[nrecvproc-1] == p) {
-            recv_end[nrecvproc-1] += n;
-          } else {
-            recvproc[nrecvproc] = p;
-            recv_begin[nrecvproc] = nrecv;
-            recv_end[nrecvproc++] = nrecv + n;
-          }
-          nrecv += n;
-        } else {
-          nrecv_self += n;
-        }
-        recvlist.add(p, lo, hi, n);
-      }
-      n = intersect(grid->sublo, grid->subhi, &boxlo[3*p], &boxhi[3*p],
-		    -1, 0, 0, grid->box[1], 0, lo, hi, false);
-      if (n > 0) {
-        if (comm->me != p) {
-          if (nsendproc > 0 && sendproc[nsendproc-1] == p) {
-            send_end[nsendproc-1] += n;
-          } else {
-            sendproc[nsendproc] = p;
-            send_begin[nsendproc] = nsend;
-            send_end[nsendproc++] = nsend + n;
-          }
-          nsend += n;
-        } else {
-          nsend_self += n;
-        }
-        sendlist.add(p, lo, hi, n);
-      }
-      n = intersect(grid->sublo, grid->subhi, &boxlo[3*p], &boxhi[3*p],
-		    0, -1, 0, grid->box[1], 0, lo, hi, false);
-      if (n > 0) {
-        if (comm->me != p) {
-          if (nrecvproc > 0 && recvproc[nrecvproc-1] == p) {
-            recv_end[nrecvproc-1] += n;
-          } else {
-            recvproc[nrecvproc] = p;
-            recv_begin[nrecvproc] = nrecv;
-            recv_end[nrecvproc++] = nrecv + n;
-          }
-          nrecv += n;
-        } else {
-          nrecv_self += n;
-        }
-        recvlist.add(p, lo, hi, n);
-      }
-      n = intersect(grid->sublo, grid->subhi, &boxlo[3*p], &boxhi[3*p],
-		    -1, 0, 0, -grid->box[1], 0, lo, hi, false);
-      if (n > 0) {
-        if (comm->me != p) {
-          if (nsendproc > 0 && sendproc[nsendproc-1] == p) {
-            send_end[nsendproc-1] += n;
-          } else {
-            sendproc[nsendproc] = p;
-            send_begin[nsendproc] = nsend;
-            send_end[nsendproc++] = nsend + n;
-          }
-          nsend += n;
-        } else {
-          nsend_self += n;
-        }
-        sendlist.add(p, lo, hi, n);
-      }
-    }
-    if (grid->periodic[2]) {
-      int n = intersect(grid->sublo, grid->subhi, &boxlo[3*p], &boxhi[3*p],
-			0, -1, 0, 0, -grid->box[2], lo, hi, false);
-      if (n > 0) {
-        if (comm->me != p) {
-          if (nrecvproc > 0 && recvproc[nrecvproc-1] == p) {
-            recv_end[nrecvproc-1] += n;
-          } else {
-            recvproc[nrecvproc] = p;
-            recv_begin[nrecvproc] = nrecv;
-            recv_end[nrecvproc++] = nrecv + n;
-          }
-          nrecv += n;
-        } else {
-          nrecv_self += n;
-        }
-        recvlist.add(p, lo, hi, n);
-      }
-      n = intersect(grid->sublo, grid->subhi, &boxlo[3*p], &boxhi[3*p],
-		    -1, 0, 0, 0, grid->box[2], lo, hi, false);
-      if (n > 0) {
-        if (comm->me != p) {
-          if (nsendproc > 0 && sendproc[nsendproc-1] == p) {
-            send_end[nsendproc-1] += n;
-          } else {
-            sendproc[nsendproc] = p;
-            send_begin[nsendproc] = nsend;
-            send_end[nsendproc++] = nsend + n;
+    for (int iz = -pbc[2]; iz <= pbc[2]; iz++) {
+      for (int iy = -pbc[1]; iy <= pbc[1]; iy++) {
+        for (int ix = -pbc[0]; ix <= pbc[0]; ix++) {
+          if (ix == 0 && iy == 0 && iz == 0 && comm->me == p) continue;
+          int xshift = ix * grid->box[0];
+          int yshift = iy * grid->box[1];
+          int zshift = iz * grid->box[2];
+
+          int n = intersect(grid->sublo, grid->subhi, &boxlo[3*p], &boxhi[3*p],
+                            0, -nghost, xshift, yshift, zshift, lo, hi, false);
+          if (n > 0) {
+            if (comm->me != p) {
+              if (nrecvproc > 0 && recvproc[nrecvproc-1] == p) {
+                recv_end[nrecvproc-1] += n;
+              } else {
+                recvproc[nrecvproc] = p;
+                recv_begin[nrecvproc] = nrecv;
+                recv_end[nrecvproc++] = nrecv + n;
+              }
+              nrecv += n;
+            } else {
+              nrecv_self += n;
+            }
+            recvlist.add(p, lo, hi, n);
           }
-          nsend += n;
-        } else {
-          nsend_self += n;
-        }
-        sendlist.add(p, lo, hi, n);
-      }
-      n = intersect(grid->sublo, grid->subhi, &boxlo[3*p], &boxhi[3*p],
-		    0, -1, 0, 0, grid->box[2], lo, hi, false);
-      if (n > 0) {
-        if (comm->me != p) {
-          if (nrecvproc > 0 && recvproc[nrecvproc-1] == p) {
-            recv_end[nrecvproc-1] += n;
-          } else {
-            recvproc[nrecvproc] = p;
-            recv_begin[nrecvproc] = nrecv;
-            recv_end[nrecvproc++] = nrecv + n;
-          }
-          nrecv += n;
-        } else {
-          nrecv_self += n;
-        }
-        recvlist.add(p, lo, hi, n);
-      }
-      n = intersect(grid->sublo, grid->subhi, &boxlo[3*p], &boxhi[3*p],
-		    -1, 0, 0, 0, -grid->box[2], lo, hi, false);
-      if (n > 0) {
-        if (comm->me != p) {
-          if (nsendproc > 0 && sendproc[nsendproc-1] == p) {
-            send_end[nsendproc-1] += n;
-          } else {
-            sendproc[nsendproc] = p;
-            send_begin[nsendproc] = nsend;
-            send_end[nsendproc++] = nsend + n;
+
+          n = intersect(grid->sublo, grid->subhi, &boxlo[3*p], &boxhi[3*p],
+                        -nghost, 0, -xshift, -yshift, -zshift, lo, hi, false);
+          if (n > 0) {
+            if (comm->me != p) {
+              if (nsendproc > 0 && sendproc[nsendproc-1] == p) {
+                send_end[nsendproc-1] += n;
+              } else {
+                sendproc[nsendproc] = p;
+                send_begin[nsendproc] = nsend;
+                send_end[nsendproc++] = nsend + n;
+              }
+              nsend += n;
+            } else {
+              nsend_self += n;
+            }
+            sendlist.add(p, lo, hi, n);
           }
-          nsend += n;
-        } else {
-          nsend_self += n;
         }
-        sendlist.add(p, lo, hi, n);
       }
     }
   }
@@ -400,32 +231,86 @@ void CommGrid::setup()
   
   if (requests) delete [] requests;
   requests = new MPI_Request[nrecvproc];
+
+  // buffers may have moved, persistent requests are rebuilt on next use
+  free_persist();
 }
 
 /* ---------------------------------------------------------------------- */
 
 void CommGrid::forward_comm()
 {
-  for (int p = 0; p < nrecvproc; p++) {
-    MPI_Irecv(&buf_recv[recv_begin[p] * size_forward],
-	      (recv_end[p] - recv_begin[p]) * size_forward,
-	      MPI_DOUBLE, recvproc[p], 0, world, &requests[p]);
-  }
+  forward_comm_begin();
+  forward_comm_end();
+}
+
+/* ----------------------------------------------------------------------
+   post receives and sends of the forward comm and update the ghost
+   cells that are periodic images of owned cells. ghost cells owned by
+   other procs are only valid after forward_comm_end()
+------------------------------------------------------------------------- */
+
+void CommGrid::forward_comm_begin()
+{
+  if (npersist < 0) setup_persist();
+
+  if (nrecvproc) MPI_Startall(nrecvproc, persist);
   for (int p = 0; p < nsendproc; p++) {
-    int n = grid->gvec->pack_comm(send_end[p] - send_begin[p],
-				  &send_cells[send_begin[p]],
-				  buf_send);
-    MPI_Send(buf_send, n, MPI_DOUBLE, sendproc[p], 0, world);
+    grid->gvec->pack_comm(send_end[p] - send_begin[p],
+			  &send_cells[send_begin[p]],
+			  &buf_send[send_begin[p] * size_forward]);
   }
-  MPI_Waitall(nrecvproc, requests, MPI_STATUS_IGNORE);
+  if (nsendproc) MPI_Startall(nsendproc, &persist[nrecvproc]);
+
+  grid->gvec->pack_comm(nsend_self, send_cells_self, buf_self);
+  grid->gvec->unpack_comm(nrecv_self, recv_cells_self, buf_self);
+}
+
+/* ----------------------------------------------------------------------
+   wait for the forward comm started by forward_comm_begin() and unpack
+------------------------------------------------------------------------- */
+
+void CommGrid::forward_comm_end()
+{
+  MPI_Waitall(npersist, persist, MPI_STATUSES_IGNORE);
   for (int p = 0; p < nrecvproc; p++) {
     grid->gvec->unpack_comm(recv_end[p] - recv_begin[p],
 			    &recv_cells[recv_begin[p]],
 			    &buf_recv[recv_begin[p] * size_forward]);
   }
+}
 
-  grid->gvec->pack_comm(nsend_self, send_cells_self, buf_self);
-  grid->gvec->unpack_comm(nrecv_self, recv_cells_self, buf_self);
+/* ----------------------------------------------------------------------
+   create persistent requests of the forward comm, each proc has its own
+   section of the send and recv buffers
+------------------------------------------------------------------------- */
+
+void CommGrid::setup_persist()
+{
+  npersist = nrecvproc + nsendproc;
+  persist = new MPI_Request[npersist];
+
+  for (int p = 0; p < nrecvproc; p++) {
+    MPI_Recv_init(&buf_recv[recv_begin[p] * size_forward],
+		  (recv_end[p] - recv_begin[p]) * size_forward,
+		  MPI_DOUBLE, recvproc[p], 0, world, &persist[p]);
+  }
+  for (int p = 0; p < nsendproc; p++) {
+    MPI_Send_init(&buf_send[send_begin[p] * size_forward],
+		  (send_end[p] - send_begin[p]) * size_forward,
+		  MPI_DOUBLE, sendproc[p], 0, world, &persist[nrecvproc+p]);
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void CommGrid::free_persist()
+{
+  for (int i = 0; i < npersist; i++)
+    MPI_Request_free(&persist[i]);
+  delete [] persist;
+  persist = nullptr;
+  npersist = -1;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -444,9 +329,9 @@ void CommGrid::migrate()
   const double small = 1e-12;
   for (int i = 0; i < 3; i++) {
     newsublo[i] = static_cast<int>((domain->sublo[i] - domain->boxlo[i]) /
-				   grid->cell_size + small) - 1;
+				   grid->cell_size + small) - grid->nghost;
     newsubhi[i] = static_cast<int>((domain->subhi[i] - domain->boxlo[i]) /
-				   grid->cell_size + small) + 1;
+				   grid->cell_size + small) + grid->nghost;
     newsubbox[i] = newsubhi[i] - newsublo[i];
   }
 
@@ -475,7 +360,7 @@ void CommGrid::migrate()
   for (int p = 0; p < comm->nprocs; p++) {
     // receiving from other procs and self
     int n = intersect(newsublo, newsubhi, &boxlo[3*p], &boxhi[3*p],
-		      -1, -1, 0, 0, 0, lo, hi, true);
+		      -grid->nghost, -grid->nghost, 0, 0, 0, lo, hi, true);
     if (n > 0) {
       recvlist.add(p, lo, hi, n);
       recv_begin_[nrecvproc_] = nrecv_;
@@ -485,7 +370,7 @@ void CommGrid::migrate()
     }
     // sending to other procs and self
     n = intersect(grid->sublo, grid->subhi, &newboxlo[3*p], &newboxhi[3*p],
-		  -1, -1, 0, 0, 0, lo, hi, true);
+		  -grid->nghost, -grid->nghost, 0, 0, 0, lo, hi, true);
     if (n > 0) {
       sendlist.add(p, lo, hi, n);
       send_begin_[nsendproc_] = nsend_;
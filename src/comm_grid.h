@@ -26,6 +26,8 @@ class CommGrid : protected Pointers {
   virtual void init();
   virtual void setup();                 // setup 3d comm pattern
   virtual void forward_comm();          // forward comm of grid data
+  virtual void forward_comm_begin();    // start forward comm
+  virtual void forward_comm_end();      // complete forward comm
   virtual void migrate();               // move cells to new procs
   
  protected:
@@ -54,10 +56,16 @@ class CommGrid : protected Pointers {
   double *buf_self;
   
   MPI_Request *requests;
+
+  int npersist;                         // # of persistent requests, first
+  MPI_Request *persist;                 // nrecvproc are receives, -1 if
+                                        // they need to be rebuilt
   
   virtual void grow_recv(int);
   virtual void grow_send(int);
   virtual void grow_self(int);
+  void setup_persist();
+  void free_persist();
   int intersect(int *, int *, int *, int *, int, int, int, int, int,
 		int *, int *, bool);
 };
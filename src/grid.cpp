@@ -15,16 +15,22 @@
 #include "grid.h"
 #include "style_grid.h"
 #include "grid_vec.h"
+#include "grid_masks.h"
+#include "atom.h"
 #include "comm.h"
 #include "comm_grid.h"
 #include "domain.h"
 #include "math_const.h"
 #include "memory.h"
 #include "error.h"
+#include "group.h"
+#include "update.h"
 
 using namespace LAMMPS_NS;
 using namespace MathConst;
 
+#define THRESHOLD_CONC 1E-20
+
 /* ---------------------------------------------------------------------- */
 
 Grid::Grid(LAMMPS *lmp) : Pointers(lmp)
@@ -46,18 +52,56 @@ Grid::Grid(LAMMPS *lmp) : Pointers(lmp)
   grid_exist = false;
 
   nmax = 0;
+  pitch = 0;
+  // group all always has per-group fields in the first row
+  for (int i = 0; i < MAXGROUP; i++) group_field[i] = -1;
+  group_field[0] = 0;
+  ngroup_field = 1;
   nsubs = 0;
   sub_names = NULL;
   cell_size = 1.0;
   box[0] = box[1] = box[2] = 0;
   ncells = 0;
   periodic[0] = periodic[1] = periodic[2] = 0;
+  nghost = 1;
+  mask_version = 0;
+  nruns = maxruns = 0;
+  runs_version = -1;
+  run_begin = run_end = nullptr;
+  run_level = nullptr;
+  ninner = 0;
+  nframe = maxframe = 0;
+  frame = nullptr;
+  set_flag = 0;
+  nwarm = maxwarm = 0;
+  warm_count = warm_head = 0;
+  warm_ncells = 0;
+  warm_lo[0] = warm_lo[1] = warm_lo[2] = 0;
+  warm_conc = nullptr;
+  warm_time = nullptr;
+  atom_cell = nullptr;
+  atom_cell_valid = 0;
+  natom_cell = maxatom_cell = 0;
+  atom_cell_step = -1;
+  occ_flag = 0;
+  occ_version = -1;
+  occ_ncells = maxocc = maxocc_group = 0;
+  nocc = nullptr;
+  occ = nullptr;
+  sat_flag = 0;
+  nsat = maxsat = sat_ncells = 0;
+  sat_sub = nullptr;
+  sat_affinity = nullptr;
+  sat_kind = nullptr;
+  sat_valid = nullptr;
+  sat_value = nullptr;
 
   mask = nullptr;
   conc = nullptr;
   reac = nullptr;
   dens = nullptr;
   growth = nullptr;
+  eps_rate = nullptr;
   boundary = nullptr;
   diff_coeff = nullptr;
   bulk = nullptr;
@@ -83,11 +127,27 @@ Grid::~Grid()
   memory->destroy(reac);
   memory->destroy(diff_coeff);
   memory->destroy(growth);
+  memory->destroy(eps_rate);
   memory->destroy(boundary);
   memory->destroy(bulk);
   memory->destroy(mw);
   if (ph != nullptr) memory->destroy(ph);
   if (act != nullptr) memory->destroy(act);
+  memory->destroy(run_begin);
+  memory->destroy(run_end);
+  memory->destroy(run_level);
+  memory->destroy(frame);
+  memory->destroy(warm_conc);
+  memory->destroy(warm_time);
+  memory->destroy(atom_cell);
+  memory->destroy(nocc);
+  memory->destroy(occ);
+  for (int m = 0; m < nsat; m++) memory->destroy(sat_value[m]);
+  memory->sfree(sat_value);
+  memory->destroy(sat_sub);
+  memory->destroy(sat_affinity);
+  memory->destroy(sat_kind);
+  memory->destroy(sat_valid);
 }
 
 /* ---------------------------------------------------------------------- */
@@ -98,7 +158,14 @@ void Grid::modify_params(int narg, char **arg)
     lmp->init();
     grid->setup();
     gvec->set(narg, arg);
-  }
+    set_flag = 1;
+  } else if (strcmp(arg[0], "ghost") == 0) {
+    if (narg != 2) error->all(FLERR, "Illegal grid_modify command");
+    if (set_flag)
+      error->all(FLERR, "Grid_modify ghost must be used before grid_modify set");
+    nghost = utils::inumeric(FLERR,arg[1],false,lmp);
+    if (nghost < 1) error->all(FLERR, "Illegal grid_modify command");
+  } else error->all(FLERR, "Illegal grid_modify command");
 }
 
 /* ----------------------------------------------------------------------
@@ -198,6 +265,23 @@ void Grid::init()
 void Grid::setup()
 {
   if (gvec) gvec->setup();
+  reset_atom_cells();
+  set_occupied(0);
+}
+
+/* ----------------------------------------------------------------------
+   request the per-group fields (dens, growth, eps_rate) of a group
+   rows of groups that were never requested alias a shared zero row
+------------------------------------------------------------------------- */
+
+void Grid::add_group(int igroup)
+{
+  if (igroup < 0 || igroup >= MAXGROUP)
+    error->all(FLERR, "Invalid group index for grid fields");
+  if (group_field[igroup] >= 0) return;
+
+  group_field[igroup] = ngroup_field++;
+  if (gvec) gvec->grow_groups();
 }
 
 /* ---------------------------------------------------------------------- */
@@ -224,3 +308,325 @@ int Grid::cell(double *x)
   return c[0] + c[1] * grid->subbox[0] +
          c[2] * grid->subbox[0] * grid->subbox[1];
 }
+
+/* ----------------------------------------------------------------------
+   return the cell of each owned and ghost atom
+   the array is only recomputed if atoms may have moved: on a new
+   timestep, if the # of atoms has changed or after reset_atom_cells()
+   which must be called by code that moves, creates or reorders atoms
+   within a timestep
+------------------------------------------------------------------------- */
+
+int *Grid::atom_cells()
+{
+  int nall = atom->nlocal + atom->nghost;
+  if (atom_cell_valid && nall == natom_cell &&
+      update->ntimestep == atom_cell_step) return atom_cell;
+
+  if (nall > maxatom_cell) {
+    maxatom_cell = atom->nmax;
+    memory->destroy(atom_cell);
+    memory->create(atom_cell, maxatom_cell, "grid:atom_cell");
+  }
+
+  double **x = atom->x;
+  for (int i = 0; i < nall; i++)
+    atom_cell[i] = cell(x[i]);
+
+  natom_cell = nall;
+  atom_cell_step = update->ntimestep;
+  atom_cell_valid = 1;
+  return atom_cell;
+}
+
+/* ----------------------------------------------------------------------
+   return the list of GRID_MASK cells where group igroup has a non-zero
+   density, n is set to the length of the list. the lists are rebuilt
+   lazily after set_occupied() or if the mask has changed. if the
+   density is not known to be up to date (set_occupied(0)) all GRID_MASK
+   cells are returned
+------------------------------------------------------------------------- */
+
+const int *Grid::occupied(int igroup, int &n)
+{
+  if (occ_version != mask_version || occ_ncells != ncells ||
+      group->ngroup > maxocc_group) build_occupied();
+  n = nocc[igroup];
+  return occ[igroup];
+}
+
+/* ---------------------------------------------------------------------- */
+
+void Grid::build_occupied()
+{
+  int ngroup = group->ngroup;
+  if (ncells > maxocc || ngroup > maxocc_group) {
+    maxocc = MAX(maxocc, ncells);
+    maxocc_group = MAX(maxocc_group, ngroup);
+    memory->destroy(nocc);
+    memory->destroy(occ);
+    memory->create(nocc, maxocc_group, "grid:nocc");
+    memory->create(occ, maxocc_group, maxocc, "grid:occ");
+  }
+
+  for (int igroup = 0; igroup < ngroup; igroup++) {
+    int n = 0;
+    int *list = occ[igroup];
+    double *d = (occ_flag && dens) ? dens[igroup] : nullptr;
+    for (int i = 0; i < ncells; i++) {
+      if (!(mask[i] & GRID_MASK)) continue;
+      if (d && d[i] == 0.0) continue;
+      list[n++] = i;
+    }
+    nocc[igroup] = n;
+  }
+
+  occ_version = mask_version;
+  occ_ncells = ncells;
+}
+
+/* ----------------------------------------------------------------------
+   enable (flag = 1) or disable (flag = 0) the caching of saturation terms
+   cached terms are discarded in both cases, the caller enabling the
+   cache must call this again as soon as concentrations change
+------------------------------------------------------------------------- */
+
+void Grid::cache_saturation(int flag)
+{
+  sat_flag = flag;
+  for (int m = 0; m < nsat; m++) sat_valid[m] = 0;
+}
+
+/* ----------------------------------------------------------------------
+   return the Monod term c/(k+c) (kind 0) or the inhibition term k/(k+c)
+   (kind 1) of substrate isub. the term is evaluated in all cells, or
+   only in the cells occupied by any group if occupied is set. while
+   caching is enabled each term is evaluated once and shared by all
+   growth fixes. returned arrays stay valid until the grid is resized
+------------------------------------------------------------------------- */
+
+const double *Grid::saturation(int isub, double k, int kind, int occupied)
+{
+  int m;
+  for (m = 0; m < nsat; m++)
+    if (sat_sub[m] == isub && sat_affinity[m] == k && sat_kind[m] == kind) break;
+
+  if (sat_ncells < ncells) {
+    for (int j = 0; j < nsat; j++) {
+      memory->destroy(sat_value[j]);
+      memory->create(sat_value[j], ncells, "grid:sat_value");
+      sat_valid[j] = 0;
+    }
+    sat_ncells = ncells;
+  }
+
+  if (m == nsat) {
+    if (nsat == maxsat) {
+      maxsat += 8;
+      memory->grow(sat_sub, maxsat, "grid:sat_sub");
+      memory->grow(sat_affinity, maxsat, "grid:sat_affinity");
+      memory->grow(sat_kind, maxsat, "grid:sat_kind");
+      memory->grow(sat_valid, maxsat, "grid:sat_valid");
+      sat_value = (double **)
+        memory->srealloc(sat_value, maxsat*sizeof(double *), "grid:sat_value");
+    }
+    sat_sub[m] = isub;
+    sat_affinity[m] = k;
+    sat_kind[m] = kind;
+    sat_valid[m] = 0;
+    memory->create(sat_value[m], sat_ncells, "grid:sat_value");
+    nsat++;
+  }
+
+  int need = occupied ? 1 : 2;
+  double * _noalias const v = sat_value[m];
+  if (sat_flag && sat_valid[m] >= need) return v;
+
+  const double * _noalias const c = conc[isub];
+  if (occupied) {
+    // group 0 (all) occupies the cells of every group
+    int n;
+    const int *list = this->occupied(0, n);
+    if (kind == 0) {
+      for (int j = 0; j < n; j++) v[list[j]] = c[list[j]] / (k + c[list[j]]);
+    } else {
+      for (int j = 0; j < n; j++) v[list[j]] = k / (k + c[list[j]]);
+    }
+  } else if (kind == 0) {
+    for (int i = 0; i < ncells; i++) v[i] = c[i] / (k + c[i]);
+  } else {
+    for (int i = 0; i < ncells; i++) v[i] = k / (k + c[i]);
+  }
+  sat_valid[m] = sat_flag ? need : 0;
+  return v;
+}
+
+/* ----------------------------------------------------------------------
+   build lists of contiguous x-runs of cells updated by the stencil
+   level 0 are the GRID_MASK cells, level n are the cells up to n layers
+   into the ghost region that are neither bulk cells nor outside a
+   non-periodic boundary. level 0 runs whose stencil does not reach the
+   ghost region come first. also build the list of ghost cells
+   only rebuilt when the mask has changed
+------------------------------------------------------------------------- */
+
+void Grid::update_runs()
+{
+  if (runs_version == mask_version) return;
+  runs_version = mask_version;
+
+  memory->destroy(run_level);
+  memory->create(run_level, nghost+1, "grid:run_level");
+
+  int n = 0;
+  for (int level = 0; level < nghost; level++) {
+    run_level[level] = n;
+    // level 0 is built in two passes, inner cells (2) then the others (1)
+    for (int pass = (level ? 1 : 2); pass > 0; pass--) {
+      for (int z = 0; z < subbox[2]; z++) {
+        for (int y = 0; y < subbox[1]; y++) {
+          int x = 0;
+          while (x < subbox[0]) {
+            int c[3] = {x, y, z};
+            if (stencil_cell(c, level) != pass) {
+              x++;
+              continue;
+            }
+            if (n == maxruns) {
+              maxruns += subbox[1] * subbox[2];
+              memory->grow(run_begin, maxruns, "grid:run_begin");
+              memory->grow(run_end, maxruns, "grid:run_end");
+            }
+            int offset = (y + z * subbox[1]) * subbox[0];
+            run_begin[n] = x + offset;
+            while (c[0] < subbox[0] && stencil_cell(c, level) == pass) c[0]++;
+            x = c[0];
+            run_end[n++] = x + offset;
+          }
+        }
+      }
+      if (pass == 2) ninner = n;
+    }
+  }
+  run_level[nghost] = n;
+  nruns = run_level[1];
+
+  nframe = 0;
+  for (int i = 0; i < ncells; i++) {
+    if (!(mask[i] & GHOST_MASK)) continue;
+    if (nframe == maxframe) {
+      maxframe += subbox[0] * subbox[1];
+      memory->grow(frame, maxframe, "grid:frame");
+    }
+    frame[nframe++] = i;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   store the converged concentrations at biological time t in the ring
+   buffer of nwarm fields. a field at the same time as the most recent
+   one replaces it. the buffer is emptied if the sub-box has changed
+------------------------------------------------------------------------- */
+
+void Grid::warm_store(double t)
+{
+  if (nwarm == 0) return;
+
+  if (nwarm != maxwarm || ncells != warm_ncells || sublo[0] != warm_lo[0] ||
+      sublo[1] != warm_lo[1] || sublo[2] != warm_lo[2]) {
+    maxwarm = nwarm;
+    memory->destroy(warm_conc);
+    memory->destroy(warm_time);
+    memory->create(warm_conc, nwarm, nsubs, ncells, "grid:warm_conc");
+    memory->create(warm_time, nwarm, "grid:warm_time");
+    warm_ncells = ncells;
+    for (int i = 0; i < 3; i++) warm_lo[i] = sublo[i];
+    warm_count = warm_head = 0;
+  }
+
+  if (warm_count == 0 || t > warm_time[warm_head]) {
+    if (warm_count) warm_head = (warm_head + 1) % nwarm;
+    warm_count = MIN(warm_count + 1, nwarm);
+  }
+
+  warm_time[warm_head] = t;
+  for (int s = 0; s < nsubs; s++)
+    memcpy(warm_conc[warm_head][s], conc[s], ncells * sizeof(double));
+}
+
+/* ----------------------------------------------------------------------
+   replace the concentrations of GRID_MASK cells by the polynomial
+   extrapolation to biological time t of the stored fields, for the
+   substrates s with flag[s] set. the result is clamped to THRESHOLD_CONC
+   and is not allowed to cross the Dirichlet value of the substrate
+------------------------------------------------------------------------- */
+
+void Grid::warm_start(double t, const int *flag)
+{
+  if (nwarm == 0 || warm_count < 2) return;
+  if (ncells != warm_ncells || sublo[0] != warm_lo[0] ||
+      sublo[1] != warm_lo[1] || sublo[2] != warm_lo[2]) return;
+  if (t <= warm_time[warm_head]) return;
+
+  // Lagrange weights of the stored fields, most recent first
+
+  int n = warm_count;
+  int slot[3];
+  double w[3];
+  for (int j = 0; j < n; j++)
+    slot[j] = (warm_head - j + nwarm) % nwarm;
+  for (int j = 0; j < n; j++) {
+    w[j] = 1.0;
+    for (int k = 0; k < n; k++) {
+      if (k == j) continue;
+      w[j] *= (t - warm_time[slot[k]]) / (warm_time[slot[j]] - warm_time[slot[k]]);
+    }
+  }
+
+  update_runs();
+  for (int s = 0; s < nsubs; s++) {
+    if (!flag[s]) continue;
+    int dirichlet = 0;
+    if (boundary && bulk) {
+      for (int f = 0; f < 6; f++)
+        if (boundary[s][f] == DIRICHLET) dirichlet = 1;
+    }
+    double *c = conc[s];
+    for (int r = 0; r < nruns; r++) {
+      for (int i = run_begin[r]; i < run_end[r]; i++) {
+        double last = warm_conc[slot[0]][s][i];
+        double x = 0.0;
+        for (int j = 0; j < n; j++) x += w[j] * warm_conc[slot[j]][s][i];
+        if (dirichlet) {
+          if (last <= bulk[s]) x = MIN(x, bulk[s]);
+          else x = MAX(x, bulk[s]);
+        }
+        c[i] = x > THRESHOLD_CONC ? x : THRESHOLD_CONC;
+      }
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   return 1 if cell with local coords c is updated by the stencil sweep
+   of the given ghost level, 2 if it is a level 0 cell whose neighbors
+   are all owned cells, 0 otherwise
+------------------------------------------------------------------------- */
+
+int Grid::stencil_cell(int *c, int level)
+{
+  int i = c[0] + (c[1] + c[2] * subbox[1]) * subbox[0];
+  if (level == 0) {
+    if (!(mask[i] & GRID_MASK)) return 0;
+    for (int d = 0; d < 3; d++)
+      if (c[d] <= nghost || c[d] >= subbox[d] - nghost - 1) return 1;
+    return 2;
+  }
+  if (mask[i] & BLAYER_MASK) return 0;
+  for (int d = 0; d < 3; d++) {
+    int g = c[d] + sublo[d];
+    if (!periodic[d] && (g < 0 || g >= box[d])) return 0;
+    if (c[d] < nghost - level || c[d] >= subbox[d] - nghost + level) return 0;
+  }
+  return 1;
+}
@@ -23,6 +23,10 @@ namespace LAMMPS_NS {
 
   class Grid : protected Pointers {
   public:
+    static const int MAXGROUP = 32;  // same as the limit of Group
+    static const int GRID_PAD = 8;   // per-cell fields are padded to a
+                                     // multiple of GRID_PAD doubles
+
     char *grid_style;
     class GridVec *gvec;
 
@@ -32,6 +36,11 @@ namespace LAMMPS_NS {
 
     bool grid_exist;
     int nmax;
+    int pitch;                  // stride between the rows of per-cell fields,
+                                // nmax padded to a multiple of GRID_PAD
+    int ngroup_field;           // # of groups with per-group fields
+    int group_field[MAXGROUP];  // row of each group in per-group fields,
+                                // -1 if the group has no fields
     int nsubs;                  // # of substrates
     char **sub_names;           // substrate names
     double cell_size;
@@ -41,6 +50,27 @@ namespace LAMMPS_NS {
     int subbox[3];              // # of cells on this proc in each dimension
     int ncells;                 // total # of cells
     int periodic[3];            // flag if x, y and z boundaries are periodic
+    int nghost;                 // # of ghost cell layers around the sub-box
+    int mask_version;           // incremented every time the mask changes
+
+    int nruns;                  // # of contiguous x-runs of GRID_MASK cells
+    int *run_begin, *run_end;   // first and last+1 cell of each run
+    int *run_level;             // first run of each ghost level, level 0 are
+                                // GRID_MASK cells, level n adds the cells of
+                                // the n-th ghost layer updated by the stencil
+    int ninner;                 // level 0 runs [0,ninner) do not read ghost cells
+    int nframe;                 // # of ghost cells
+    int *frame;                 // local index of each ghost cell
+
+    int nwarm;                  // # of converged fields used by warm starts
+                                // 0 = off, 2 = linear, 3 = quadratic
+    int warm_count;             // # of fields stored in the ring buffer
+    int warm_head;              // slot of the most recent field
+    double ***warm_conc;        // ring buffer of converged concentrations
+    double *warm_time;          // biological time of each stored field
+
+    int *atom_cell;             // cell of each owned and ghost atom, use
+                                // atom_cells() to get an up-to-date array
 
     Grid(class LAMMPS *);
     virtual ~Grid();
@@ -51,6 +81,19 @@ namespace LAMMPS_NS {
     void setup();
     int find(const char *);
     int cell(double *);
+    void update_runs();
+    void warm_store(double);
+    void warm_start(double, const int *);
+    int *atom_cells();
+    void reset_atom_cells() { atom_cell_valid = 0; }
+    const int *occupied(int, int &);
+    void set_occupied(int flag) { occ_flag = flag; occ_version = -1; }
+    const double *monod(int isub, double k, int occupied = 0)
+      { return saturation(isub, k, 0, occupied); }
+    const double *inhibition(int isub, double k, int occupied = 0)
+      { return saturation(isub, k, 1, occupied); }
+    void cache_saturation(int);
+    void add_group(int);
 
     int *mask;
 
@@ -63,7 +106,8 @@ namespace LAMMPS_NS {
     double **reac;    // reaction rate
     double **dens;    // density
     double **diff_coeff; //diffusion Coefficient
-    double ***growth; // growth rate
+    double **growth;  // specific growth rate
+    double **eps_rate; // specific EPS production rate
     double *bulk;     // bulk concentration
     double *mw;       // molecular weight g/mol
     double *ph;       // ph
@@ -71,6 +115,39 @@ namespace LAMMPS_NS {
     int **boundary;   // boundary conditions (-x, +x, -y, +y, -z, +z)
 
   private:
+    int runs_version;           // mask version the runs were built for
+    int maxruns;
+    int maxframe;
+    int set_flag;               // 1 if grid_modify set has been used
+    int maxwarm;                // # of allocated ring buffer slots
+    int warm_ncells;            // ncells when the fields were stored
+    int warm_lo[3];             // sublo when the fields were stored
+    int atom_cell_valid;        // 0 if atoms may have moved since last update
+    int natom_cell;             // # of atoms in atom_cell
+    int maxatom_cell;
+    bigint atom_cell_step;      // timestep of the last update
+    int occ_flag;               // 1 if dens is up to date for occupied()
+    int occ_version;            // mask version the occupied lists were built for
+    int occ_ncells;             // ncells when the occupied lists were built
+    int maxocc, maxocc_group;
+    int *nocc;                  // # of occupied cells of each group
+    int **occ;                  // occupied GRID_MASK cells of each group
+
+    int sat_flag;               // 1 if saturation terms are cached
+    int nsat, maxsat;           // # of cached saturation terms
+    int sat_ncells;             // length of each cached term
+    int *sat_sub;               // substrate of each term
+    double *sat_affinity;       // affinity of each term
+    int *sat_kind;              // 0 = Monod, 1 = inhibition
+    int *sat_valid;             // 2 if up to date in all cells, 1 in the
+                                // occupied cells only, 0 otherwise
+    double **sat_value;         // value of each term in all cells
+
+    void build_occupied();
+    const double *saturation(int, double, int, int);
+
+    int stencil_cell(int *, int);
+
     template<typename T>
     static GridVec *gvec_creator(LAMMPS *);
   };
@@ -81,4 +158,18 @@ namespace LAMMPS_NS {
 
 /* ERROR/WARNING messages:
 
+E: Illegal grid_modify command
+
+Self-explanatory.  Check the input script syntax and compare to the
+documentation for the command.
+
+E: Invalid group index for grid fields
+
+Per-group grid fields can only be requested for existing groups.
+
+E: Grid_modify ghost must be used before grid_modify set
+
+Changing the ghost depth changes the layout of the grid data,
+therefore it must be set before initial concentrations are assigned.
+
 */
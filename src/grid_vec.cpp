@@ -105,12 +105,15 @@ void GridVec::init()
 void GridVec::setup()
 {
   const double small = 1e-12;
+  int nghost = grid->nghost;
   for (int i = 0; i < 3; i++) {
     grid->sublo[i] = static_cast<int>((domain->sublo[i] - domain->boxlo[i]) /
-				      grid->cell_size + small) - 1;
+				      grid->cell_size + small) - nghost;
     grid->subhi[i] = static_cast<int>((domain->subhi[i] - domain->boxlo[i]) /
-				      grid->cell_size + small) + 1;
+				      grid->cell_size + small) + nghost;
     grid->subbox[i] = grid->subhi[i] - grid->sublo[i];
+    if (grid->periodic[i] && nghost > grid->box[i])
+      error->all(FLERR, "Grid ghost depth is larger than a periodic dimension");
   }
   grid->ncells = grid->subbox[0] * grid->subbox[1] * grid->subbox[2];
 
@@ -119,62 +122,39 @@ void GridVec::setup()
   }
 
   // setup mask
+  // boundary masks are set on the layer of cells just outside the box,
+  // cells outside two or more non-periodic boundaries are corners
   int *mask = grid->mask;
+  int nbmask[3] = {X_NB_MASK, Y_NB_MASK, Z_NB_MASK};
+  int pbmask[3] = {X_PB_MASK, Y_PB_MASK, Z_PB_MASK};
   for (int z = 0; z < grid->subbox[2]; z++) {
     for (int y = 0; y < grid->subbox[1]; y++) {
       for (int x = 0; x < grid->subbox[0]; x++) {
+        int c[3] = {x, y, z};
         int m = 0;
-        if (x == 0 || y == 0 || z == 0 ||
-            x == grid->subbox[0] - 1 ||
-            y == grid->subbox[1] - 1 ||
-            z == grid->subbox[2] - 1) {
-          m |= GHOST_MASK;
-        } else {
-          m |= GRID_MASK;
+        int ghost = 0;
+        int nout = 0;
+        for (int d = 0; d < 3; d++) {
+          int g = c[d] + grid->sublo[d];
+          if (c[d] < nghost || c[d] >= grid->subbox[d] - nghost) ghost = 1;
+          if (!grid->periodic[d] && (g < 0 || g >= grid->box[d])) nout++;
         }
+        if (ghost) m |= GHOST_MASK;
+        else m |= GRID_MASK;
 
-        if ((x == 0 && y == 0 &&
-             grid->sublo[0] < 0 && grid->sublo[1] < 0) ||
-            (x == 0 && z == 0 &&
-             grid->sublo[0] < 0 && grid->sublo[2] < 0) ||
-            (x == 0 && y == grid->subbox[1] - 1 &&
-             grid->sublo[0] < 0 && grid->subhi[1] > grid->box[1]) ||
-            (x == 0 && z == grid->subbox[2] - 1 &&
-             grid->sublo[0] < 0 && grid->subhi[2] > grid->box[2]) ||
-            (x == grid->subbox[0] - 1 && y == 0 &&
-             grid->subhi[0] > grid->box[0] && grid->sublo[1] < 0) ||
-            (x == grid->subbox[0] - 1 && z == 0 &&
-             grid->subhi[0] > grid->box[0] && grid->sublo[2] < 0) ||
-            (x == grid->subbox[0] - 1 && y == grid->subbox[1] - 1 &&
-             grid->subhi[0] > grid->box[0] && grid->subhi[1] > grid->box[1]) ||
-            (x == grid->subbox[0] - 1 && z == grid->subbox[2] - 1 &&
-             grid->subhi[0] > grid->box[0] && grid->subhi[2] > grid->box[2]) ||
-            (y == 0 && z == 0 &&
-             grid->sublo[1] < 0 && grid->sublo[2] < 0) ||
-            (y == 0 && z == grid->subbox[2] - 1 &&
-             grid->sublo[1] < 0 && grid->subhi[2] > grid->box[2]) ||
-            (y == grid->subbox[1] - 1 && z == 0 &&
-             grid->subhi[1] > grid->box[1] && grid->sublo[2] < 0) ||
-            (y == grid->subbox[1] - 1 && z == grid->subbox[2] - 1 &&
-             grid->subhi[1] > grid->box[1] && grid->subhi[2] > grid->box[2]))
+        if (nout > 1) {
           m |= CORNER_MASK;
-        else {
-          if (grid->sublo[0] < 0 && x == 0)
-            m |= X_NB_MASK;
-          if (grid->subhi[0] > grid->box[0] && x == grid->subbox[0] - 1)
-            m |= X_PB_MASK;
-          if (grid->sublo[1] < 0 && y == 0)
-            m |= Y_NB_MASK;
-          if (grid->subhi[1] > grid->box[1] && y == grid->subbox[1] - 1)
-            m |= Y_PB_MASK;
-          if (grid->sublo[2] < 0 && z == 0)
-            m |= Z_NB_MASK;
-          if (grid->subhi[2] > grid->box[2] && z == grid->subbox[2] - 1)
-            m |= Z_PB_MASK;
+        } else {
+          for (int d = 0; d < 3; d++) {
+            int g = c[d] + grid->sublo[d];
+            if (g == -1) m |= nbmask[d];
+            if (g == grid->box[d]) m |= pbmask[d];
+          }
         }
 
         mask[x + y * grid->subbox[0] + z * grid->subbox[0] * grid->subbox[1]] = m;
       }
     }
   }
+  grid->mask_version++;
 }
@@ -35,6 +35,7 @@ class GridVec : protected Pointers {
   virtual void process_args(int, char **);
   virtual void init();
   virtual void grow(int) = 0;
+  virtual void grow_groups() {}
   virtual void setup();
 
   virtual int pack_comm(int, int *, double *) = 0;
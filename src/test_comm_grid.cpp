@@ -128,9 +128,10 @@ void TestCommGrid::run(int)
   for (int i = 0; i < grid->ncells; i++)
     conc[0][i] = 0;
 
-  for (int z = grid->sublo[2] + 1; z < grid->subhi[2] - 1; z++) {
-    for (int y = grid->sublo[1] + 1; y < grid->subhi[1] - 1; y++) {
-      for (int x = grid->sublo[0] + 1; x < grid->subhi[0] - 1; x++) {
+  int nghost = grid->nghost;
+  for (int z = grid->sublo[2] + nghost; z < grid->subhi[2] - nghost; z++) {
+    for (int y = grid->sublo[1] + nghost; y < grid->subhi[1] - nghost; y++) {
+      for (int x = grid->sublo[0] + nghost; x < grid->subhi[0] - nghost; x++) {
   	int i = (x - grid->sublo[0]) + (y - grid->sublo[1]) * grid->subbox[0] +
   	  (z - grid->sublo[2]) * grid->subbox[0] * grid->subbox[1];
   	conc[0][i] = (x + 1) + (y + 1) * grid->extbox[0] +
@@ -211,7 +212,6 @@ bool TestCommGrid::check()
 {
   bool result = false;
   const double small = 1e-12;
-  int *mask = grid->mask;
   double **conc = grid->conc;
   for (int z = grid->sublo[2]; z < grid->subhi[2]; z++) {
     for (int y = grid->sublo[1]; y < grid->subhi[1]; y++) {
@@ -219,52 +219,24 @@ bool TestCommGrid::check()
 	int i = (x - grid->sublo[0]) +
 	  (y - grid->sublo[1]) * grid->subbox[0] +
 	  (z - grid->sublo[2]) * grid->subbox[0] * grid->subbox[1];
-	int j = (x + 1) + (y + 1) * grid->extbox[0] +
-	  (z + 1) * grid->extbox[0] * grid->extbox[1];
-	if (mask[i] & CORNER_MASK) {
-	  continue;
-	} else if ((mask[i] & X_NB_MASK) && domain->xperiodic) {
-	  if (fabs(conc[0][i] - (j + grid->box[0])) > small) {
-	    result = true;
-	    fprintf(screen, "[%d] Wrong value at cell %d (-x periodic boundary): expected %d got %e\n",
-		    comm->me, i, j + grid->box[0], conc[0][i]);
-	  }
-	} else if ((mask[i] & X_PB_MASK) && domain->xperiodic) {
-	  if (fabs(conc[0][i] - (j - grid->box[0])) > small) {
-	    result = true;
-	    fprintf(screen, "[%d] Wrong value at cell %d (+x periodic boundary): expected %d got %e\n",
-		    comm->me, i, j - grid->box[0], conc[0][i]);
-	  }
-	} else if ((mask[i] & Y_NB_MASK) && domain->yperiodic) {
-	  if (fabs(conc[0][i] - (j + grid->extbox[0] * grid->box[1])) > small) {
-	    result = true;
-	    fprintf(screen, "[%d] Wrong value at cell %d (-y periodic boundary): expected %d got %e\n",
-		    comm->me, i, j + grid->extbox[0] * grid->box[1], conc[0][i]);
-	  }
-	} else if ((mask[i] & Y_PB_MASK) && domain->yperiodic) {
-	  if (fabs(conc[0][i] - (j - grid->extbox[0] * grid->box[1])) > small) {
-	    result = true;
-	    fprintf(screen, "[%d] Wrong value at cell %d (+y periodic boundary): expected %d got %e\n",
-		    comm->me, i, j - grid->extbox[0] * grid->box[1], conc[0][i]);
-	  }
-	} else if ((mask[i] & Z_NB_MASK) && domain->zperiodic) {
-	  if (fabs(conc[0][i] - (j + grid->extbox[0] * grid->extbox[1] * grid->box[2])) > small) {
-	    result = true;
-	    fprintf(screen, "[%d] Wrong value at cell %d (-z periodic boundary): expected %d got %e\n",
-		    comm->me, i, j + grid->extbox[0] * grid->extbox[1] * grid->box[2], conc[0][i]);
-	  }
-	} else if ((mask[i] & Z_PB_MASK) && domain->zperiodic) {
-	  if (fabs(conc[0][i] - (j - grid->extbox[0] * grid->extbox[1] * grid->box[2])) > small) {
-	    result = true;
-	    fprintf(screen, "[%d] Wrong value at cell %d (+z periodic boundary): expected %d got %e\n",
-		    comm->me, i, j - grid->extbox[0] * grid->extbox[1] * grid->box[2], conc[0][i]);
-	  }
-	} else if (!(mask[i] & GHOST_MASK)) {
-	  if (fabs(conc[0][i] - j) > small) {
-	    result = true;
-	    fprintf(screen, "[%d] Wrong value at cell %d (local domain): expected %d got %e\n",
-		    comm->me, i, j, conc[0][i]);
-	  }
+	// map ghost cells to their periodic image, skip cells outside
+	// non-periodic boundaries as they are not communicated
+	int g[3] = {x, y, z};
+	bool outside = false;
+	for (int d = 0; d < 3; d++) {
+	  if (g[d] >= 0 && g[d] < grid->box[d]) continue;
+	  if (!grid->periodic[d]) outside = true;
+	  else if (g[d] < 0) g[d] += grid->box[d];
+	  else g[d] -= grid->box[d];
+	}
+	if (outside) continue;
+	int j = (g[0] + 1) + (g[1] + 1) * grid->extbox[0] +
+	  (g[2] + 1) * grid->extbox[0] * grid->extbox[1];
+	if (fabs(conc[0][i] - j) > small) {
+	  result = true;
+	  fprintf(screen, "[%d] Wrong value at cell %d (%s): expected %d got %e\n",
+		  comm->me, i, (grid->mask[i] & GHOST_MASK) ? "ghost" : "local domain",
+		  j, conc[0][i]);
 	}
       }
     }